@@ -0,0 +1,203 @@
+/* Helpers shared by benchmarks */
+#ifndef BENCH_H
+#define BENCH_H
+
+#define _POSIX_C_SOURCE 200809L
+/* syscall() for perf_event_open() */
+#define _DEFAULT_SOURCE
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+/**
+ * Return monotonic time in seconds.
+ */
+static inline double bench_now(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+/**
+ * Prevent compiler from optimizing away computation of memory pointed to by
+ * `p`.
+ */
+static inline void bench_keep(const void *p)
+{
+	__asm__ volatile("" : : "r"(p) : "memory");
+}
+
+/* Times benchmarked code is run, fastest run is reported */
+#define BENCH_REPEATS 5
+
+/* State of BENCH_BEST() loop */
+struct bench_best {
+	double *best;
+	double start;
+	int run;
+};
+
+/**
+ * Record time of the run, which just ended, and start the next one. Return
+ * zero after BENCH_REPEATS runs.
+ */
+static inline int bench_best_next(struct bench_best *b)
+{
+	if (b->run > 0) {
+		double elapsed = bench_now() - b->start;
+		if (b->run == 1 || elapsed < *b->best)
+			*b->best = elapsed;
+	}
+	if (b->run++ == BENCH_REPEATS)
+		return 0;
+	b->start = bench_now();
+	return 1;
+}
+
+/**
+ * Run statement following the macro BENCH_REPEATS times and store time of the
+ * fastest run in seconds in `best`. The statement may leave the loop with
+ * return or exit() when a run fails.
+ */
+#define BENCH_BEST(best)                                                       \
+	for (struct bench_best bench_best_ = { &(best), 0.0, 0 };              \
+	     bench_best_next(&bench_best_);)
+
+/* Hardware counters read around benchmarked code */
+enum bench_counter {
+	BENCH_CYCLES,
+	BENCH_INSTRUCTIONS,
+	BENCH_BRANCH_MISSES,
+	BENCH_L1D_MISSES,
+	BENCH_COUNTERS
+};
+
+struct bench_counters {
+	int fd[BENCH_COUNTERS];
+	/* Counted events, or -1.0 if counter is not available */
+	double value[BENCH_COUNTERS];
+};
+
+/**
+ * Open hardware counters of the calling thread with perf_event_open().
+ * Counters, which can not be opened, because kernel, CPU or permissions do not
+ * allow it, are left closed and always read as not available.
+ */
+static inline void bench_counters_open(struct bench_counters *c)
+{
+	for (int i = 0; i < BENCH_COUNTERS; ++i) {
+		c->fd[i] = -1;
+		c->value[i] = -1.0;
+	}
+#ifdef __linux__
+	/* Reads from L1 data cache, which missed */
+	const uint64_t l1d_misses = PERF_COUNT_HW_CACHE_L1D |
+				    PERF_COUNT_HW_CACHE_OP_READ << 8 |
+				    PERF_COUNT_HW_CACHE_RESULT_MISS << 16;
+	const struct {
+		uint32_t type;
+		uint64_t config;
+	} events[BENCH_COUNTERS] = {
+		[BENCH_CYCLES] = { PERF_TYPE_HARDWARE,
+				   PERF_COUNT_HW_CPU_CYCLES },
+		[BENCH_INSTRUCTIONS] = { PERF_TYPE_HARDWARE,
+					 PERF_COUNT_HW_INSTRUCTIONS },
+		[BENCH_BRANCH_MISSES] = { PERF_TYPE_HARDWARE,
+					  PERF_COUNT_HW_BRANCH_MISSES },
+		[BENCH_L1D_MISSES] = { PERF_TYPE_HW_CACHE, l1d_misses },
+	};
+	for (int i = 0; i < BENCH_COUNTERS; ++i) {
+		struct perf_event_attr attr;
+		memset(&attr, 0, sizeof(attr));
+		attr.size = sizeof(attr);
+		attr.type = events[i].type;
+		attr.config = events[i].config;
+		attr.disabled = 1;
+		attr.exclude_kernel = 1;
+		attr.exclude_hv = 1;
+		attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED |
+				   PERF_FORMAT_TOTAL_TIME_RUNNING;
+		c->fd[i] = (int)syscall(SYS_perf_event_open, &attr, 0, -1, -1,
+					0UL);
+	}
+#endif
+}
+
+/**
+ * Return nonzero if at least one counter is open.
+ */
+static inline int bench_counters_available(const struct bench_counters *c)
+{
+	for (int i = 0; i < BENCH_COUNTERS; ++i)
+		if (c->fd[i] >= 0)
+			return 1;
+	return 0;
+}
+
+/**
+ * Reset and start open counters.
+ */
+static inline void bench_counters_start(struct bench_counters *c)
+{
+#ifdef __linux__
+	for (int i = 0; i < BENCH_COUNTERS; ++i) {
+		if (c->fd[i] < 0)
+			continue;
+		ioctl(c->fd[i], PERF_EVENT_IOC_RESET, 0);
+		ioctl(c->fd[i], PERF_EVENT_IOC_ENABLE, 0);
+	}
+#else
+	(void)c;
+#endif
+}
+
+/**
+ * Stop open counters and store events counted since bench_counters_start()
+ * in `c->value`. Counts are scaled up, if kernel multiplexed counters, and set
+ * to -1.0 if a counter did not run at all.
+ */
+static inline void bench_counters_stop(struct bench_counters *c)
+{
+#ifdef __linux__
+	for (int i = 0; i < BENCH_COUNTERS; ++i) {
+		c->value[i] = -1.0;
+		if (c->fd[i] < 0)
+			continue;
+		ioctl(c->fd[i], PERF_EVENT_IOC_DISABLE, 0);
+
+		/* Value, time enabled and time running */
+		uint64_t data[3];
+		if (read(c->fd[i], data, sizeof(data)) != sizeof(data) ||
+		    data[2] == 0U)
+			continue;
+		c->value[i] = (double)data[0] * (double)data[1] /
+			      (double)data[2];
+	}
+#else
+	(void)c;
+#endif
+}
+
+static inline void bench_counters_close(struct bench_counters *c)
+{
+#ifdef __linux__
+	for (int i = 0; i < BENCH_COUNTERS; ++i)
+		if (c->fd[i] >= 0)
+			close(c->fd[i]);
+#endif
+	for (int i = 0; i < BENCH_COUNTERS; ++i)
+		c->fd[i] = -1;
+}
+
+#endif
@@ -0,0 +1,548 @@
+/*
+ * Measure every try_{T}_from_{U}() and {T}_from_{U}() conversion between
+ * integer and floating point types, and every string parser, on values, which
+ * all fit destination type, which all do not fit it, and on mixes of both,
+ * where 1% and 50% of values do not fit. Conversions, which can not fail, are
+ * measured only on values, which fit. Panicking conversions run with a panic
+ * handler, which returns, so they return zero on failure.
+ *
+ * The benchmark pins itself to the CPU it started on, warms every kernel up
+ * and then times it over many samples, each converting the same small
+ * dataset, which stays in cache. Results, median and 99th percentile of time
+ * per value and throughput derived from median, are written to standard output
+ * as JSON, so runs can be compared with each other. Where Linux
+ * perf_event_open() allows it, results also show cycles, instructions per
+ * cycle, branch misses and L1 data cache misses per value, counted over all
+ * samples, otherwise these are null.
+ *
+ * Usage: bench_cast [substring of conversion name] [number of samples]
+ */
+#define _GNU_SOURCE
+#include "bench.h"
+
+#include <cast.h>
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef __linux__
+#include <sched.h>
+#endif
+
+#define VALUES 4096U
+#define WARMUP 16
+#define SAMPLES 101
+
+/*
+ * Source types of conversions, given as (type, name, kind of generator,
+ * whether floating point types can be converted from it)
+ */
+#define INTS_SRC(X, ...)                                                       \
+	X(uint8_t, u8, int, 1, __VA_ARGS__)                                    \
+	X(uint16_t, u16, int, 1, __VA_ARGS__)                                  \
+	X(uint32_t, u32, int, 1, __VA_ARGS__)                                  \
+	X(uint64_t, u64, int, 1, __VA_ARGS__)                                  \
+	X(unsigned char, uchar, int, 1, __VA_ARGS__)                           \
+	X(unsigned, uint, int, 1, __VA_ARGS__)                                 \
+	X(unsigned short, ushort, int, 1, __VA_ARGS__)                         \
+	X(unsigned long, ulong, int, 1, __VA_ARGS__)                           \
+	X(unsigned long long, ullong, int, 1, __VA_ARGS__)                     \
+	X(size_t, size, int, 1, __VA_ARGS__)                                   \
+	X(uintptr_t, uptr, int, 0, __VA_ARGS__)                                \
+	X(int8_t, i8, int, 1, __VA_ARGS__)                                     \
+	X(int16_t, i16, int, 1, __VA_ARGS__)                                   \
+	X(int32_t, i32, int, 1, __VA_ARGS__)                                   \
+	X(int64_t, i64, int, 1, __VA_ARGS__)                                   \
+	X(signed char, schar, int, 1, __VA_ARGS__)                             \
+	X(int, int, int, 1, __VA_ARGS__)                                       \
+	X(short, short, int, 1, __VA_ARGS__)                                   \
+	X(long, long, int, 1, __VA_ARGS__)                                     \
+	X(long long, llong, int, 1, __VA_ARGS__)                               \
+	X(ptrdiff_t, ptrdiff, int, 1, __VA_ARGS__)
+
+#define FLOATS_SRC(X, ...)                                                     \
+	X(float, float, float, 0, __VA_ARGS__)                                 \
+	X(double, double, float, 0, __VA_ARGS__)
+
+/* Destination types, a separate list, so it can be expanded around the above */
+#define INTS_DST(X)                                                            \
+	X(uint8_t, u8)                                                         \
+	X(uint16_t, u16)                                                       \
+	X(uint32_t, u32)                                                       \
+	X(uint64_t, u64)                                                       \
+	X(unsigned char, uchar)                                                \
+	X(unsigned, uint)                                                      \
+	X(unsigned short, ushort)                                              \
+	X(unsigned long, ulong)                                                \
+	X(unsigned long long, ullong)                                          \
+	X(size_t, size)                                                        \
+	X(uintptr_t, uptr)                                                     \
+	X(int8_t, i8)                                                          \
+	X(int16_t, i16)                                                        \
+	X(int32_t, i32)                                                        \
+	X(int64_t, i64)                                                        \
+	X(signed char, schar)                                                  \
+	X(int, int)                                                            \
+	X(short, short)                                                        \
+	X(long, long)                                                          \
+	X(long long, llong)                                                    \
+	X(ptrdiff_t, ptrdiff)
+
+#define FLOATS_DST(X)                                                          \
+	X(float, float)                                                        \
+	X(double, double)
+
+/* Destination types of string parsers */
+#define STR_DST(X)                                                             \
+	INTS_DST(X)                                                            \
+	FLOATS_DST(X)                                                          \
+	X(bool, bool)
+
+/* Converts source values from `src` and returns sum of results */
+typedef uint64_t (*kernel)(const void *src, size_t n);
+
+struct conversion {
+	const char *name;
+	size_t size;
+	int str;
+	void (*generate)(void *dst, uint64_t *state);
+	int (*check)(const void *src);
+	kernel try_kernel;
+	kernel panic_kernel;
+};
+
+/* Source value of string parsers */
+struct text {
+	char chars[32];
+	size_t len;
+};
+
+static uint64_t next_random(uint64_t *state)
+{
+	*state ^= *state >> 12;
+	*state ^= *state << 25;
+	*state ^= *state >> 27;
+	return *state * 2685821657736338717ULL;
+}
+
+/* Random bits of random magnitude and sign, so small values are common */
+static uint64_t random_bits(uint64_t *state)
+{
+	uint64_t r = next_random(state);
+	uint64_t bits = next_random(state) >> (r & 63U);
+	return r & 64U ? 0U - bits : bits;
+}
+
+static double random_double(uint64_t *state)
+{
+	uint64_t r = next_random(state);
+	double value = (double)(int64_t)random_bits(state);
+	if (r & 256U)
+		value /= 4.0;
+	if ((r & 0x3E00U) == 0U)
+		value *= 1e15;
+	if ((r & 0xFC000U) == 0U)
+		value = NAN;
+	return value;
+}
+
+/* Expand argument only if flag is 1 */
+#define IF_0(...)
+#define IF_1(...) __VA_ARGS__
+
+#define GENERATE_int(type, state) ((type)random_bits(state))
+#define GENERATE_float(type, state) ((type)random_double(state))
+
+#define DEFINE_GENERATE(src_type, src_name, src_kind, to_float, ...)          \
+	static void generate_##src_name(void *dst, uint64_t *state)            \
+	{                                                                      \
+		src_type value = GENERATE_##src_kind(src_type, state);         \
+		memcpy(dst, &value, sizeof(value));                            \
+	}
+INTS_SRC(DEFINE_GENERATE, )
+FLOATS_SRC(DEFINE_GENERATE, )
+#undef DEFINE_GENERATE
+
+static void generate_text(void *dst, uint64_t *state)
+{
+	struct text *text = dst;
+	uint64_t r = next_random(state);
+	uint64_t bits = random_bits(state);
+	int len;
+	switch (r & 3U) {
+	case 0:
+		len = snprintf(text->chars, sizeof(text->chars), "%llu",
+			       (unsigned long long)bits);
+		break;
+	case 1:
+		len = snprintf(text->chars, sizeof(text->chars), "%.17g",
+			       random_double(state));
+		break;
+	default:
+		len = snprintf(text->chars, sizeof(text->chars), "%lld",
+			       (long long)bits);
+		break;
+	}
+	text->len = (size_t)len;
+}
+
+#define DEFINE_PAIR(dst_type, dst_name, src_type, src_name)                    \
+	static int check_##dst_name##_from_##src_name(const void *src)         \
+	{                                                                      \
+		dst_type val;                                                  \
+		src_type value;                                                \
+		memcpy(&value, src, sizeof(value));                            \
+		return try_##dst_name##_from_##src_name(&val, value);          \
+	}                                                                      \
+	static uint64_t try_##dst_name##_from_##src_name##_kernel(             \
+		const void *src, size_t n)                                     \
+	{                                                                      \
+		const src_type *values = src;                                  \
+		uint64_t sum = 0U;                                             \
+		for (size_t i = 0U; i < n; ++i) {                              \
+			dst_type val = 0;                                      \
+			if (try_##dst_name##_from_##src_name(&val,             \
+							     values[i]) == 0)  \
+				sum += cast_value_bits(&val, sizeof(val));     \
+		}                                                              \
+		return sum;                                                    \
+	}                                                                      \
+	static uint64_t dst_name##_from_##src_name##_kernel(const void *src,   \
+							    size_t n)          \
+	{                                                                      \
+		const src_type *values = src;                                  \
+		uint64_t sum = 0U;                                             \
+		for (size_t i = 0U; i < n; ++i) {                              \
+			dst_type val =                                         \
+				dst_name##_from_##src_name(values[i]);         \
+			sum += cast_value_bits(&val, sizeof(val));             \
+		}                                                              \
+		return sum;                                                    \
+	}
+
+/* Swaps arguments, as source types are expanded inside destination types */
+#define DEFINE_PAIR_SRC(src_type, src_name, src_kind, to_float, dst_type,    \
+			dst_name)                                              \
+	DEFINE_PAIR(dst_type, dst_name, src_type, src_name)
+#define DEFINE_PAIR_TO_FLOAT(src_type, src_name, src_kind, to_float,           \
+			     dst_type, dst_name)                               \
+	IF_##to_float(DEFINE_PAIR(dst_type, dst_name, src_type, src_name))
+#define DEFINE_FROM_ALL(dst_type, dst_name)                                    \
+	INTS_SRC(DEFINE_PAIR_SRC, dst_type, dst_name)                          \
+	FLOATS_SRC(DEFINE_PAIR_SRC, dst_type, dst_name)
+#define DEFINE_FROM_INTS(dst_type, dst_name)                                   \
+	INTS_SRC(DEFINE_PAIR_TO_FLOAT, dst_type, dst_name)
+INTS_DST(DEFINE_FROM_ALL)
+FLOATS_DST(DEFINE_FROM_INTS)
+
+#define DEFINE_STR(dst_type, dst_name)                                         \
+	static int check_##dst_name##_from_str(const void *src)                \
+	{                                                                      \
+		dst_type val;                                                  \
+		return try_##dst_name##_from_str(                              \
+			&val, ((const struct text *)src)->chars);              \
+	}                                                                      \
+	static uint64_t try_##dst_name##_from_str_kernel(const void *src,      \
+							 size_t n)             \
+	{                                                                      \
+		const struct text *values = src;                               \
+		uint64_t sum = 0U;                                             \
+		for (size_t i = 0U; i < n; ++i) {                              \
+			dst_type val = 0;                                      \
+			if (try_##dst_name##_from_str(&val,                    \
+						      values[i].chars) == 0)   \
+				sum += cast_value_bits(&val, sizeof(val));     \
+		}                                                              \
+		return sum;                                                    \
+	}                                                                      \
+	static uint64_t dst_name##_from_str_kernel(const void *src, size_t n)  \
+	{                                                                      \
+		const struct text *values = src;                               \
+		uint64_t sum = 0U;                                             \
+		for (size_t i = 0U; i < n; ++i) {                              \
+			dst_type val = dst_name##_from_str(values[i].chars);   \
+			sum += cast_value_bits(&val, sizeof(val));             \
+		}                                                              \
+		return sum;                                                    \
+	}                                                                      \
+	static uint64_t try_##dst_name##_from_strn_kernel(const void *src,     \
+							  size_t n)            \
+	{                                                                      \
+		const struct text *values = src;                               \
+		uint64_t sum = 0U;                                             \
+		for (size_t i = 0U; i < n; ++i) {                              \
+			dst_type val = 0;                                      \
+			if (try_##dst_name##_from_strn(&val, values[i].chars,  \
+						       values[i].len) == 0)    \
+				sum += cast_value_bits(&val, sizeof(val));     \
+		}                                                              \
+		return sum;                                                    \
+	}                                                                      \
+	static uint64_t dst_name##_from_strn_kernel(const void *src, size_t n) \
+	{                                                                      \
+		const struct text *values = src;                               \
+		uint64_t sum = 0U;                                             \
+		for (size_t i = 0U; i < n; ++i) {                              \
+			dst_type val = dst_name##_from_strn(values[i].chars,   \
+							    values[i].len);    \
+			sum += cast_value_bits(&val, sizeof(val));             \
+		}                                                              \
+		return sum;                                                    \
+	}
+STR_DST(DEFINE_STR)
+
+#define PAIR_ENTRY(src_type, src_name, src_kind, to_float, dst_type, dst_name) \
+	{ #dst_name "_from_" #src_name,                                        \
+	  sizeof(src_type),                                                    \
+	  0,                                                                   \
+	  generate_##src_name,                                                 \
+	  check_##dst_name##_from_##src_name,                                  \
+	  try_##dst_name##_from_##src_name##_kernel,                           \
+	  dst_name##_from_##src_name##_kernel },
+#define ENTRIES_FROM_ALL(dst_type, dst_name)                                   \
+	INTS_SRC(PAIR_ENTRY, dst_type, dst_name)                               \
+	FLOATS_SRC(PAIR_ENTRY, dst_type, dst_name)
+#define PAIR_ENTRY_TO_FLOAT(src_type, src_name, src_kind, to_float, dst_type, \
+			    dst_name)                                          \
+	IF_##to_float(PAIR_ENTRY(src_type, src_name, src_kind, to_float,       \
+				 dst_type, dst_name))
+#define ENTRIES_FROM_INTS(dst_type, dst_name)                                  \
+	INTS_SRC(PAIR_ENTRY_TO_FLOAT, dst_type, dst_name)
+#define STR_ENTRIES(dst_type, dst_name)                                        \
+	{ #dst_name "_from_str",                                               \
+	  sizeof(struct text),                                                 \
+	  1,                                                                   \
+	  generate_text,                                                       \
+	  check_##dst_name##_from_str,                                         \
+	  try_##dst_name##_from_str_kernel,                                    \
+	  dst_name##_from_str_kernel },                                        \
+		{ #dst_name "_from_strn",                                      \
+		  sizeof(struct text),                                         \
+		  1,                                                           \
+		  generate_text,                                               \
+		  check_##dst_name##_from_str,                                 \
+		  try_##dst_name##_from_strn_kernel,                           \
+		  dst_name##_from_strn_kernel },
+
+static const struct conversion conversions[] = {
+	INTS_DST(ENTRIES_FROM_ALL) FLOATS_DST(ENTRIES_FROM_INTS)
+		STR_DST(STR_ENTRIES)
+};
+
+/* Inputs, by share of values, in percent, which do not fit destination */
+static const struct {
+	const char *name;
+	unsigned failing;
+} inputs[] = {
+	{ "in_range", 0U },
+	{ "mixed_1", 1U },
+	{ "mixed_50", 50U },
+	{ "out_of_range", 100U },
+};
+
+static void ignore_panic(enum cast_type src, enum cast_type dst)
+{
+	(void)src;
+	(void)dst;
+}
+
+static int compare_doubles(const void *a, const void *b)
+{
+	double x = *(const double *)a;
+	double y = *(const double *)b;
+	return (x > y) - (x < y);
+}
+
+/**
+ * Fill `valid` and `invalid` with `VALUES` values each, which do and do not
+ * convert successfully. If few values of either kind were generated, they are
+ * repeated.
+ *
+ * @return Number of distinct invalid values generated, zero if conversion can
+ *         not fail.
+ */
+static size_t generate_values(const struct conversion *conv, char *valid,
+			      char *invalid)
+{
+	uint64_t state = 0x9E3779B97F4A7C15ULL;
+	size_t size = conv->size;
+	size_t n_valid = 0U;
+	size_t n_invalid = 0U;
+	char value[sizeof(struct text)];
+
+	for (size_t i = 0U; i < 256U * VALUES; ++i) {
+		if (n_valid == VALUES && n_invalid == VALUES)
+			break;
+		conv->generate(value, &state);
+		if (conv->check(value) == 0) {
+			if (n_valid < VALUES)
+				memcpy(valid + n_valid++ * size, value, size);
+		} else if (n_invalid < VALUES) {
+			memcpy(invalid + n_invalid++ * size, value, size);
+		}
+	}
+	for (size_t i = n_valid; i < VALUES && n_valid; ++i)
+		memcpy(valid + i * size, valid + (i % n_valid) * size, size);
+	for (size_t i = n_invalid; i < VALUES && n_invalid; ++i)
+		memcpy(invalid + i * size, invalid + (i % n_invalid) * size,
+		       size);
+	return n_invalid;
+}
+
+/**
+ * Fill `dst` with values from `valid`, replacing given percent of them, at
+ * random positions, with values from `invalid`.
+ */
+static void mix_values(char *dst, const char *valid, const char *invalid,
+		       size_t size, unsigned failing)
+{
+	uint64_t state = 0xD1B54A32D192ED03ULL;
+	for (size_t i = 0U; i < VALUES; ++i) {
+		const char *src = next_random(&state) % 100U < failing ? invalid
+								      : valid;
+		memcpy(dst + i * size, src + i * size, size);
+	}
+}
+
+static double mean_length(const char *values)
+{
+	const struct text *texts = (const struct text *)(const void *)values;
+	size_t sum = 0U;
+	for (size_t i = 0U; i < VALUES; ++i)
+		sum += texts[i].len;
+	return (double)sum / VALUES;
+}
+
+static int first_result = 1;
+static struct bench_counters counters;
+
+/* Prints `name` and `value`, or null if value is negative, as JSON member */
+static void print_metric(const char *name, double value)
+{
+	if (value < 0.0)
+		printf(", \"%s\": null", name);
+	else
+		printf(", \"%s\": %.3f", name, value);
+}
+
+static void run(const char *function, const char *input, kernel kernel,
+		const char *values, double bytes, double *samples,
+		int n_samples)
+{
+	uint64_t sum = 0U;
+	for (int i = 0; i < WARMUP; ++i) {
+		sum += kernel(values, VALUES);
+		bench_keep(&sum);
+	}
+	bench_counters_start(&counters);
+	for (int i = 0; i < n_samples; ++i) {
+		double start = bench_now();
+		sum += kernel(values, VALUES);
+		bench_keep(&sum);
+		samples[i] = (bench_now() - start) * 1e9 / VALUES;
+	}
+	bench_counters_stop(&counters);
+	qsort(samples, (size_t)n_samples, sizeof(*samples), compare_doubles);
+
+	double median = samples[n_samples / 2];
+	double p99 = samples[(n_samples * 99 + 99) / 100 - 1];
+	printf("%s\n    {\"function\": \"%s\", \"input\": \"%s\", "
+	       "\"ns_median\": %.3f, \"ns_p99\": %.3f, "
+	       "\"values_per_s\": %.0f, \"mb_per_s\": %.1f",
+	       first_result ? "" : ",", function, input, median, p99,
+	       1e9 / median, bytes * 1e3 / median);
+
+	/* Counters cover all samples, including reading of the clock */
+	double n = (double)n_samples * VALUES;
+	double cycles = counters.value[BENCH_CYCLES];
+	double instructions = counters.value[BENCH_INSTRUCTIONS];
+	double branch_misses = counters.value[BENCH_BRANCH_MISSES];
+	double l1d_misses = counters.value[BENCH_L1D_MISSES];
+	print_metric("cycles_per_value", cycles < 0.0 ? -1.0 : cycles / n);
+	print_metric("ipc", cycles <= 0.0 || instructions < 0.0
+				    ? -1.0
+				    : instructions / cycles);
+	print_metric("branch_misses_per_value",
+		     branch_misses < 0.0 ? -1.0 : branch_misses / n);
+	print_metric("l1d_misses_per_value",
+		     l1d_misses < 0.0 ? -1.0 : l1d_misses / n);
+	printf(", \"sum\": %llu}", (unsigned long long)sum);
+	first_result = 0;
+}
+
+/* Pins calling thread to the CPU it runs on and returns it, or -1 */
+static int pin_thread(void)
+{
+#ifdef __linux__
+	int cpu = sched_getcpu();
+	cpu_set_t set;
+	CPU_ZERO(&set);
+	if (cpu >= 0) {
+		CPU_SET((size_t)cpu, &set);
+		if (sched_setaffinity(0, sizeof(set), &set) == 0)
+			return cpu;
+	}
+#endif
+	return -1;
+}
+
+int main(int argc, char **argv)
+{
+	const char *filter = argc > 1 ? argv[1] : "";
+	int n_samples = argc > 2 ? atoi(argv[2]) : SAMPLES;
+	if (n_samples < 1)
+		n_samples = 1;
+
+	char *valid = malloc(VALUES * sizeof(struct text));
+	char *invalid = malloc(VALUES * sizeof(struct text));
+	char *values = malloc(VALUES * sizeof(struct text));
+	double *samples = malloc((size_t)n_samples * sizeof(*samples));
+	if (!valid || !invalid || !values || !samples) {
+		fprintf(stderr, "cannot allocate %u values\n", VALUES);
+		return 1;
+	}
+	cast_set_panic_handler(ignore_panic);
+
+	int cpu = pin_thread();
+	bench_counters_open(&counters);
+	if (!bench_counters_available(&counters))
+		fprintf(stderr, "hardware counters are not available\n");
+	printf("{\n  \"cpu\": %d,\n  \"values\": %u,\n  \"warmup\": %d,\n"
+	       "  \"samples\": %d,\n  \"counters\": %s,\n  \"results\": [",
+	       cpu, VALUES, WARMUP, n_samples,
+	       bench_counters_available(&counters) ? "true" : "false");
+
+	size_t n = sizeof(conversions) / sizeof(conversions[0]);
+	for (size_t i = 0U; i < n; ++i) {
+		const struct conversion *conv = &conversions[i];
+		if (!strstr(conv->name, filter))
+			continue;
+
+		size_t n_invalid = generate_values(conv, valid, invalid);
+		char try_name[64];
+		snprintf(try_name, sizeof(try_name), "try_%s", conv->name);
+		for (size_t j = 0U; j < sizeof(inputs) / sizeof(inputs[0]);
+		     ++j) {
+			if (inputs[j].failing && !n_invalid)
+				break;
+			mix_values(values, valid, invalid, conv->size,
+				   inputs[j].failing);
+			double bytes = conv->str ? mean_length(values)
+						 : (double)conv->size;
+			run(try_name, inputs[j].name, conv->try_kernel, values,
+			    bytes, samples, n_samples);
+			run(conv->name, inputs[j].name, conv->panic_kernel,
+			    values, bytes, samples, n_samples);
+		}
+	}
+	printf("\n  ]\n}\n");
+	bench_counters_close(&counters);
+
+	free(valid);
+	free(invalid);
+	free(values);
+	free(samples);
+	return 0;
+}
@@ -0,0 +1,113 @@
+/*
+ * Compare decoding records with conversions, which are checked after every
+ * field, with conversions recording errors in a context checked once.
+ *
+ * Usage: bench_ctx [number of records]
+ */
+#include "bench.h"
+
+#include <cast.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+struct wire_record {
+	int64_t id;
+	double temperature;
+	int64_t level;
+	uint64_t port;
+};
+
+struct record {
+	int32_t id;
+	int16_t temperature;
+	uint8_t level;
+	uint16_t port;
+};
+
+static size_t decode_panic(struct record *dst, const struct wire_record *src,
+			   size_t n)
+{
+	for (size_t i = 0U; i < n; ++i) {
+		dst[i].id = i32_from_i64(src[i].id);
+		dst[i].temperature = i16_from_double(src[i].temperature);
+		dst[i].level = u8_from_i64(src[i].level);
+		dst[i].port = u16_from_u64(src[i].port);
+	}
+	return n;
+}
+
+static size_t decode_try(struct record *dst, const struct wire_record *src,
+			 size_t n)
+{
+	for (size_t i = 0U; i < n; ++i) {
+		if (try_i32_from_i64(&dst[i].id, src[i].id) ||
+		    try_i16_from_double(&dst[i].temperature,
+					src[i].temperature) ||
+		    try_u8_from_i64(&dst[i].level, src[i].level) ||
+		    try_u16_from_u64(&dst[i].port, src[i].port))
+			return i;
+	}
+	return n;
+}
+
+static size_t decode_ctx(struct record *dst, const struct wire_record *src,
+			 size_t n)
+{
+	struct cast_ctx ctx = CAST_CTX_INIT;
+	for (size_t i = 0U; i < n; ++i) {
+		dst[i].id = CAST_CTX(&ctx, i32_from_i64, src[i].id);
+		dst[i].temperature =
+		    CAST_CTX(&ctx, i16_from_double, src[i].temperature);
+		dst[i].level = CAST_CTX(&ctx, u8_from_i64, src[i].level);
+		dst[i].port = CAST_CTX(&ctx, u16_from_u64, src[i].port);
+	}
+	if (cast_ctx_check(&ctx))
+		return ctx.first_index / 4U;
+	return n;
+}
+
+#define BENCH(name, call)                                                      \
+	do {                                                                   \
+		double best = 0.0;                                             \
+		BENCH_BEST(best) {                                             \
+			size_t decoded = (call);                               \
+			bench_keep(dst);                                       \
+			if (decoded != n) {                                    \
+				fprintf(stderr, "%s failed at %zu\n", name,    \
+					decoded);                              \
+				return 1;                                      \
+			}                                                      \
+		}                                                              \
+		printf("%-28s %8.3f ns/record\n", name,                        \
+		       best * 1e9 / (double)n);                                \
+	} while (0)
+
+int main(int argc, char **argv)
+{
+	size_t n = argc > 1 ? strtoul(argv[1], NULL, 10) : 4000000U;
+	struct wire_record *src = malloc(n * sizeof(*src));
+	struct record *dst = malloc(n * sizeof(*dst));
+	if (!src || !dst) {
+		fprintf(stderr, "cannot allocate %zu records\n", n);
+		return 1;
+	}
+	uint64_t rng = 88172645463325252U;
+	for (size_t i = 0U; i < n; ++i) {
+		rng ^= rng << 13;
+		rng ^= rng >> 7;
+		rng ^= rng << 17;
+		src[i].id = (int64_t)(rng >> 33) - (INT64_C(1) << 30);
+		src[i].temperature = (double)(int)((rng >> 8) % 600U) - 300.0;
+		src[i].level = (int64_t)(rng % 256U);
+		src[i].port = (rng >> 16) % 65536U;
+	}
+
+	BENCH("panic after every field", decode_panic(dst, src, n));
+	BENCH("try_ after every field", decode_try(dst, src, n));
+	BENCH("context checked once", decode_ctx(dst, src, n));
+
+	free(src);
+	free(dst);
+	return 0;
+}
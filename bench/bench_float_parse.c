@@ -0,0 +1,143 @@
+/*
+ * Compare float parsing of cast with strtod()/strtof() based wrappers.
+ *
+ * Usage: bench_float_parse [number of values]
+ */
+#include "bench.h"
+
+#include <cast.h>
+#include <errno.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* Previous implementation of cast_try_double_from_str() */
+static int strtod_wrapper(double *dst, const char *str)
+{
+	errno = 0;
+	char *endptr = NULL;
+	double val = strtod(str, &endptr);
+	if (errno != 0 || *endptr != '\0' || endptr == str)
+		return -1;
+	*dst = val;
+	return 0;
+}
+
+/* Previous implementation of cast_try_float_from_str() */
+static int strtof_wrapper(float *dst, const char *str)
+{
+	errno = 0;
+	char *endptr = NULL;
+	float val = strtof(str, &endptr);
+	if (errno != 0 || *endptr != '\0' || endptr == str)
+		return -1;
+	*dst = val;
+	return 0;
+}
+
+static uint64_t rng = 88172645463325252U;
+
+static uint64_t next_random(void)
+{
+	rng ^= rng << 13;
+	rng ^= rng >> 7;
+	rng ^= rng << 17;
+	return rng;
+}
+
+struct dataset {
+	const char *name;
+	char **strings;
+	size_t *lengths;
+	size_t bytes;
+};
+
+static void fill(struct dataset *set, size_t n, int kind)
+{
+	char buf[64];
+
+	set->strings = malloc(n * sizeof(*set->strings));
+	set->lengths = malloc(n * sizeof(*set->lengths));
+	set->bytes = 0U;
+	for (size_t i = 0; i < n; ++i) {
+		double val = (double)(next_random() >> 11) * 0x1p-53;
+		if (kind == 0) {
+			/* Shortest round trip representation of random value */
+			val = val * 1e6 - 5e5;
+			snprintf(buf, sizeof(buf), "%.17g", val);
+		} else if (kind == 1) {
+			/* Prices and measurements */
+			snprintf(buf, sizeof(buf), "%.2f", val * 10000.0);
+		} else {
+			/* Scientific notation in wide range of exponents */
+			snprintf(buf, sizeof(buf), "%.9e",
+				 val * 1e30 / (double)(1U << (i % 31U)));
+		}
+		set->lengths[i] = strlen(buf);
+		set->strings[i] = malloc(set->lengths[i] + 1U);
+		memcpy(set->strings[i], buf, set->lengths[i] + 1U);
+		set->bytes += set->lengths[i];
+	}
+}
+
+static void report(const char *name, const struct dataset *set, size_t n,
+		   double elapsed)
+{
+	printf("%-12s %-28s %8.1f ns %8.1f MB/s\n", set->name, name,
+	       elapsed * 1e9 / (double)n, (double)set->bytes / elapsed / 1e6);
+}
+
+#define BENCH(name, type, call)                                                \
+	do {                                                                   \
+		double best = 0.0;                                             \
+		BENCH_BEST(best) {                                             \
+			type sum = 0;                                          \
+			for (size_t i = 0; i < n; ++i) {                       \
+				type val = 0;                                  \
+				const char *str = set->strings[i];             \
+				size_t len = set->lengths[i];                  \
+				(void)len;                                     \
+				if (call) {                                    \
+					fprintf(stderr, "cannot parse %s\n",   \
+						str);                          \
+					exit(1);                               \
+				}                                              \
+				sum += val;                                    \
+			}                                                      \
+			bench_keep(&sum);                                      \
+		}                                                              \
+		report(name, set, n, best);                                    \
+	} while (0)
+
+int main(int argc, char **argv)
+{
+	size_t n = argc > 1 ? strtoul(argv[1], NULL, 10) : 1000000U;
+	struct dataset sets[] = {
+		{.name = "random"},
+		{.name = "fixed"},
+		{.name = "scientific"},
+	};
+
+	for (size_t k = 0; k < sizeof(sets) / sizeof(sets[0]); ++k) {
+		struct dataset *set = &sets[k];
+		fill(set, n, (int)k);
+
+		BENCH("strtod wrapper", double, strtod_wrapper(&val, str));
+		BENCH("try_double_from_str", double,
+		      try_double_from_str(&val, str));
+		BENCH("try_double_from_strn", double,
+		      try_double_from_strn(&val, str, len));
+		BENCH("strtof wrapper", float, strtof_wrapper(&val, str));
+		BENCH("try_float_from_str", float,
+		      try_float_from_str(&val, str));
+		BENCH("try_float_from_strn", float,
+		      try_float_from_strn(&val, str, len));
+
+		for (size_t i = 0; i < n; ++i)
+			free(set->strings[i]);
+		free(set->strings);
+		free(set->lengths);
+	}
+	return 0;
+}
@@ -0,0 +1,150 @@
+/*
+ * Compare formatting of numbers with snprintf() and cast_fmt_{T}().
+ *
+ * Usage: bench_fmt [number of values]
+ */
+#include "bench.h"
+
+#include <cast.h>
+#include <inttypes.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+static uint64_t rng = 88172645463325252U;
+
+static uint64_t next_random(void)
+{
+	rng ^= rng << 13;
+	rng ^= rng >> 7;
+	rng ^= rng << 17;
+	return rng;
+}
+
+#define BENCH(name, call)                                                      \
+	do {                                                                   \
+		double best = 0.0;                                             \
+		size_t len = 0U;                                               \
+		BENCH_BEST(best) {                                             \
+			len = (call);                                          \
+			bench_keep(buf);                                       \
+		}                                                              \
+		printf("%-30s %8.2f ns/value %8.1f MB/s\n", name,              \
+		       best * 1e9 / (double)n, (double)len / best / 1e6);      \
+	} while (0)
+
+static size_t snprintf_u64(char *buf, size_t cap, const uint64_t *src,
+			   size_t n)
+{
+	size_t len = 0U;
+	for (size_t i = 0U; i < n; ++i)
+		len += (size_t)snprintf(buf + len, cap - len, "%" PRIu64 "\n",
+					src[i]);
+	return len;
+}
+
+static size_t fmt_u64(char *buf, size_t cap, const uint64_t *src, size_t n)
+{
+	size_t len = 0U;
+	for (size_t i = 0U; i < n; ++i) {
+		len += cast_fmt_u64(buf + len, cap - len, src[i]);
+		buf[len++] = '\n';
+	}
+	return len;
+}
+
+static size_t snprintf_i32(char *buf, size_t cap, const int32_t *src,
+			   size_t n)
+{
+	size_t len = 0U;
+	for (size_t i = 0U; i < n; ++i)
+		len += (size_t)snprintf(buf + len, cap - len, "%" PRId32 ",",
+					src[i]);
+	return len;
+}
+
+static size_t fmt_i32_array(char *buf, size_t cap, const int32_t *src,
+			    size_t n)
+{
+	return cast_fmt_i32_array(buf, cap, src, n, ',', NULL);
+}
+
+/* Shortest round trip output of snprintf() needs up to 17 digits */
+static size_t snprintf_double(char *buf, size_t cap, const double *src,
+			      size_t n)
+{
+	size_t len = 0U;
+	for (size_t i = 0U; i < n; ++i)
+		len += (size_t)snprintf(buf + len, cap - len, "%.17g\n",
+					src[i]);
+	return len;
+}
+
+static size_t fmt_double(char *buf, size_t cap, const double *src, size_t n)
+{
+	size_t len = 0U;
+	for (size_t i = 0U; i < n; ++i) {
+		len += cast_fmt_double(buf + len, cap - len, src[i]);
+		buf[len++] = '\n';
+	}
+	return len;
+}
+
+static size_t fmt_float(char *buf, size_t cap, const float *src, size_t n)
+{
+	size_t len = 0U;
+	for (size_t i = 0U; i < n; ++i) {
+		len += cast_fmt_float(buf + len, cap - len, src[i]);
+		buf[len++] = '\n';
+	}
+	return len;
+}
+
+int main(int argc, char **argv)
+{
+	size_t n = argc > 1 ? strtoul(argv[1], NULL, 10) : 4000000U;
+	size_t cap = n * 32U;
+	uint64_t *u64 = malloc(n * sizeof(*u64));
+	int32_t *i32 = malloc(n * sizeof(*i32));
+	double *f64 = malloc(n * sizeof(*f64));
+	double *metrics = malloc(n * sizeof(*metrics));
+	float *f32 = malloc(n * sizeof(*f32));
+	char *buf = malloc(cap);
+	if (!u64 || !i32 || !f64 || !metrics || !f32 || !buf) {
+		fprintf(stderr, "cannot allocate %zu values\n", n);
+		return 1;
+	}
+
+	/* Values of every length are equally likely */
+	for (size_t i = 0U; i < n; ++i) {
+		uint64_t r = next_random();
+		u64[i] = r >> (r & 63U);
+		i32[i] = (int32_t)(uint32_t)(r >> (32U + (r & 31U)));
+		if (r & 64U)
+			i32[i] = -i32[i];
+		/* Random bits and values like measured latencies */
+		uint64_t bits = next_random() & ~(UINT64_C(1) << 62);
+		memcpy(&f64[i], &bits, sizeof(f64[i]));
+		metrics[i] = (double)(r >> 44) / 1000.0;
+		f32[i] = (float)f64[i];
+	}
+
+	BENCH("u64 snprintf", snprintf_u64(buf, cap, u64, n));
+	BENCH("u64 cast_fmt_u64", fmt_u64(buf, cap, u64, n));
+	BENCH("i32 snprintf", snprintf_i32(buf, cap, i32, n));
+	BENCH("i32 cast_fmt_i32_array", fmt_i32_array(buf, cap, i32, n));
+	BENCH("double snprintf %.17g", snprintf_double(buf, cap, f64, n));
+	BENCH("double cast_fmt_double", fmt_double(buf, cap, f64, n));
+	BENCH("metric snprintf %.17g", snprintf_double(buf, cap, metrics, n));
+	BENCH("metric cast_fmt_double", fmt_double(buf, cap, metrics, n));
+	BENCH("float cast_fmt_float", fmt_float(buf, cap, f32, n));
+
+	free(u64);
+	free(i32);
+	free(f64);
+	free(metrics);
+	free(f32);
+	free(buf);
+	return 0;
+}
@@ -0,0 +1,45 @@
+// std::from_chars() wrappers for bench_parse_corpus, which is written in C
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <system_error>
+
+template <typename T> static int parse(T *dst, const char *ptr, size_t len)
+{
+	T val;
+	std::from_chars_result res = std::from_chars(ptr, ptr + len, val);
+	if (res.ec != std::errc() || res.ptr != ptr + len)
+		return -1;
+	*dst = val;
+	return 0;
+}
+
+extern "C" {
+
+int from_chars_u64(uint64_t *dst, const char *ptr, size_t len)
+{
+	return parse(dst, ptr, len);
+}
+
+int from_chars_i64(int64_t *dst, const char *ptr, size_t len)
+{
+	return parse(dst, ptr, len);
+}
+
+// Floating point std::from_chars() came later than integer one
+#if defined(__cpp_lib_to_chars) && __cpp_lib_to_chars >= 201611L
+extern const int from_chars_has_double = 1;
+
+int from_chars_double(double *dst, const char *ptr, size_t len)
+{
+	return parse(dst, ptr, len);
+}
+#else
+extern const int from_chars_has_double = 0;
+
+int from_chars_double(double *, const char *, size_t)
+{
+	return -1;
+}
+#endif
+}
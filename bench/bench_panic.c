@@ -0,0 +1,65 @@
+/*
+ * Compare panic policies selected by CAST_PANIC_POLICY: cost of the hot path
+ * of conversions, which never fail, and cost of conversions, where every 64th
+ * one fails, for policies, which return to the caller.
+ *
+ * Usage: bench_panic [number of values]
+ */
+#include "bench.h"
+
+#include <cast.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#define POLICIES(X)                                                            \
+	X(exit)                                                                \
+	X(trap)                                                                \
+	X(abort)                                                               \
+	X(log_continue)                                                        \
+	X(longjmp)
+
+#define X(policy)                                                              \
+	uint64_t sum_valid_##policy(const int64_t *src, size_t n);             \
+	uint64_t sum_failing_##policy(const int64_t *src, size_t n);
+POLICIES(X)
+#undef X
+
+#define BENCH(name, call)                                                      \
+	do {                                                                   \
+		double best = 0.0;                                             \
+		uint64_t sum = 0U;                                             \
+		BENCH_BEST(best) {                                             \
+			sum = (call);                                          \
+			bench_keep(&sum);                                      \
+		}                                                              \
+		printf("%-24s %8.3f ns/value (sum %llu)\n", name,              \
+		       best * 1e9 / (double)n, (unsigned long long)sum);       \
+	} while (0)
+
+int main(int argc, char **argv)
+{
+	size_t n = argc > 1 ? strtoul(argv[1], NULL, 10) : 16000000U;
+	int64_t *valid = malloc(n * sizeof(*valid));
+	int64_t *failing = malloc(n * sizeof(*failing));
+	if (!valid || !failing) {
+		fprintf(stderr, "cannot allocate %zu values\n", n);
+		return 1;
+	}
+	/* Every 64th value does not fit u8 */
+	for (size_t i = 0U; i < n; ++i) {
+		valid[i] = (int64_t)(i % 256U);
+		failing[i] = i % 64U == 63U ? 256 : valid[i];
+	}
+
+#define X(policy) BENCH(#policy ", valid", sum_valid_##policy(valid, n));
+	POLICIES(X)
+#undef X
+	BENCH("log_continue, 1/64 fail", sum_failing_log_continue(failing, n));
+	BENCH("longjmp, 1/64 fail", sum_failing_longjmp(failing, n));
+	printf("logged %zu failures\n", cast_panic_log_count());
+
+	free(valid);
+	free(failing);
+	return 0;
+}
@@ -0,0 +1,56 @@
+/*
+ * Kernels of bench_panic, this file is compiled once for each panic policy,
+ * with CAST_PANIC_POLICY and BENCH_POLICY set to its name.
+ */
+#include "bench.h"
+
+#include <cast.h>
+#include <stdint.h>
+
+#define BENCH_NAME2(prefix, policy) prefix##policy
+#define BENCH_NAME(prefix, policy) BENCH_NAME2(prefix, policy)
+
+uint64_t BENCH_NAME(sum_valid_, BENCH_POLICY)(const int64_t *src, size_t n);
+uint64_t BENCH_NAME(sum_failing_, BENCH_POLICY)(const int64_t *src, size_t n);
+
+/* Conversions, which never fail, so only cost of the hot path is measured */
+uint64_t BENCH_NAME(sum_valid_, BENCH_POLICY)(const int64_t *src, size_t n)
+{
+	uint64_t sum = 0U;
+	for (size_t i = 0U; i < n; ++i)
+		sum += u8_from_i32(i32_from_i64(src[i]));
+	return sum;
+}
+
+/* Conversions, which may fail, only policies which return are measured */
+uint64_t BENCH_NAME(sum_failing_, BENCH_POLICY)(const int64_t *src, size_t n)
+{
+#if CAST_PANIC_POLICY == CAST_PANIC_LOG_CONTINUE
+	uint64_t sum = 0U;
+	for (size_t i = 0U; i < n; ++i)
+		sum += u8_from_i32(i32_from_i64(src[i]));
+	return sum;
+#elif CAST_PANIC_POLICY == CAST_PANIC_LONGJMP
+	/* Values, which live across setjmp() */
+	volatile uint64_t sum = 0U;
+	volatile size_t i = 0U;
+	struct cast_recovery scope;
+
+	while (i < n) {
+		cast_recovery_push(&scope);
+		if (setjmp(scope.env) == 0) {
+			for (; i < n; ++i)
+				sum += u8_from_i32(i32_from_i64(src[i]));
+		} else {
+			/* Skip value, which failed */
+			++i;
+		}
+		cast_recovery_pop(&scope);
+	}
+	return sum;
+#else
+	(void)src;
+	(void)n;
+	return 0U;
+#endif
+}
@@ -0,0 +1,58 @@
+/*
+ * Measure throughput of parallel array conversion as threads are added.
+ *
+ * Usage: bench_parallel [MiB of source] [max threads]
+ */
+#include "bench.h"
+
+#include <cast.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+int main(int argc, char **argv)
+{
+	size_t mib = argc > 1 ? strtoul(argv[1], NULL, 10) : 512U;
+	unsigned max_threads = argc > 2 ? (unsigned)strtoul(argv[2], NULL, 10)
+					: cast_set_threads(0U);
+	size_t n = mib * ((size_t)1 << 20) / sizeof(int32_t);
+
+	int32_t *src = malloc(n * sizeof(*src));
+	uint8_t *dst = malloc(n * sizeof(*dst));
+	if (!src || !dst) {
+		fprintf(stderr, "cannot allocate %zu MiB\n", mib);
+		return 1;
+	}
+	for (size_t i = 0; i < n; ++i)
+		src[i] = (int32_t)(i % 256U);
+
+	printf("u8 from i32, %zu MiB of source, GB/s counts bytes read and "
+	       "written\n",
+	       mib);
+	printf("%8s %10s %8s\n", "threads", "GB/s", "speedup");
+
+	double base = 0.0;
+	for (unsigned threads = 1U; threads <= max_threads; ++threads) {
+		cast_set_threads(threads);
+
+		size_t first_bad = 0U;
+		double best = 0.0;
+		BENCH_BEST(best) {
+			if (try_u8_from_i32_array_mt(dst, src, n, &first_bad)) {
+				fprintf(stderr, "conversion failed at %zu\n",
+					first_bad);
+				return 1;
+			}
+			bench_keep(dst);
+		}
+
+		double gbps = (double)(n * (sizeof(*src) + sizeof(*dst))) /
+			      best / 1e9;
+		if (threads == 1U)
+			base = gbps;
+		printf("%8u %10.2f %8.2f\n", threads, gbps, gbps / base);
+	}
+
+	free(src);
+	free(dst);
+	return 0;
+}
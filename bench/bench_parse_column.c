@@ -0,0 +1,172 @@
+/*
+ * Compare parsing of newline separated numbers line by line with
+ * cast_parse_column_{T}().
+ *
+ * Usage: bench_parse_column [MiB of text]
+ */
+#include "bench.h"
+
+#include <cast.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+static uint64_t rng = 88172645463325252U;
+
+static uint64_t next_random(void)
+{
+	rng ^= rng << 13;
+	rng ^= rng >> 7;
+	rng ^= rng << 17;
+	return rng;
+}
+
+/* Fill buffer with lines and return number of bytes used */
+static size_t fill(char *buf, size_t cap, int kind, size_t *lines)
+{
+	size_t len = 0U;
+	*lines = 0U;
+	while (cap - len > 64U) {
+		uint64_t r = next_random();
+		if (kind == 0)
+			len += (size_t)sprintf(buf + len, "%u\n",
+					       (unsigned)(r >> (32U + r % 32U)));
+		else if (kind == 1)
+			len += (size_t)sprintf(buf + len, "%lld\n",
+					       (long long)r >> (r % 64U));
+		else
+			len += (size_t)sprintf(buf + len, "%.6f\n",
+					       (double)(r >> 40) / 1000.0);
+		++*lines;
+	}
+	return len;
+}
+
+/* Split lines, copy them to terminate with NULL and parse them */
+static size_t parse_lines_u32(const char *buf, size_t len, uint32_t *out)
+{
+	char token[64];
+	size_t n = 0U;
+	for (size_t start = 0U; start < len;) {
+		const char *end = memchr(buf + start, '\n', len - start);
+		size_t token_len = (size_t)(end - (buf + start));
+		memcpy(token, buf + start, token_len);
+		token[token_len] = '\0';
+		int64_t val = 0;
+		if (try_i64_from_str(&val, token) ||
+		    try_u32_from_i64(&out[n], val))
+			return n;
+		++n;
+		start += token_len + 1U;
+	}
+	return n;
+}
+
+static size_t parse_lines_i64(const char *buf, size_t len, int64_t *out)
+{
+	char token[64];
+	size_t n = 0U;
+	for (size_t start = 0U; start < len;) {
+		const char *end = memchr(buf + start, '\n', len - start);
+		size_t token_len = (size_t)(end - (buf + start));
+		memcpy(token, buf + start, token_len);
+		token[token_len] = '\0';
+		if (try_i64_from_str(&out[n], token))
+			return n;
+		++n;
+		start += token_len + 1U;
+	}
+	return n;
+}
+
+static size_t parse_lines_double(const char *buf, size_t len, double *out)
+{
+	char token[64];
+	size_t n = 0U;
+	for (size_t start = 0U; start < len;) {
+		const char *end = memchr(buf + start, '\n', len - start);
+		size_t token_len = (size_t)(end - (buf + start));
+		memcpy(token, buf + start, token_len);
+		token[token_len] = '\0';
+		if (try_double_from_str(&out[n], token))
+			return n;
+		++n;
+		start += token_len + 1U;
+	}
+	return n;
+}
+
+#define BENCH(name, call)                                                      \
+	do {                                                                   \
+		double best = 0.0;                                             \
+		BENCH_BEST(best) {                                             \
+			size_t parsed = (call);                                \
+			bench_keep(out);                                       \
+			if (parsed != lines) {                                 \
+				fprintf(stderr, "%s failed at line %zu\n",     \
+					name, parsed);                         \
+				return 1;                                      \
+			}                                                      \
+		}                                                              \
+		printf("%-34s %10.1f MB/s\n", name,                            \
+		       (double)len / best / 1e6);                              \
+	} while (0)
+
+static size_t column_u32(const char *buf, size_t len, uint32_t *out,
+			 size_t cap)
+{
+	size_t count = 0U;
+	cast_parse_column_u32(buf, len, '\n', out, cap, &count, NULL);
+	return count;
+}
+
+static size_t column_i64(const char *buf, size_t len, int64_t *out,
+			 size_t cap)
+{
+	size_t count = 0U;
+	cast_parse_column_i64(buf, len, '\n', out, cap, &count, NULL);
+	return count;
+}
+
+static size_t column_double(const char *buf, size_t len, double *out,
+			    size_t cap)
+{
+	size_t count = 0U;
+	cast_parse_column_double(buf, len, '\n', out, cap, &count, NULL);
+	return count;
+}
+
+int main(int argc, char **argv)
+{
+	size_t mib = argc > 1 ? strtoul(argv[1], NULL, 10) : 64U;
+	size_t cap = mib << 20;
+	char *buf = malloc(cap);
+	void *out = malloc(cap * sizeof(uint64_t) / 2U);
+	if (!buf || !out) {
+		fprintf(stderr, "cannot allocate %zu MiB\n", mib);
+		return 1;
+	}
+	size_t lines = 0U;
+	size_t len = 0U;
+
+	printf("instruction set: %s\n", cast_isa_name(cast_isa()));
+
+	len = fill(buf, cap, 0, &lines);
+	BENCH("u32 lines, try_i64_from_str", parse_lines_u32(buf, len, out));
+	BENCH("u32 cast_parse_column_u32", column_u32(buf, len, out, lines));
+
+	len = fill(buf, cap, 1, &lines);
+	BENCH("i64 lines, try_i64_from_str", parse_lines_i64(buf, len, out));
+	BENCH("i64 cast_parse_column_i64", column_i64(buf, len, out, lines));
+
+	len = fill(buf, cap, 2, &lines);
+	BENCH("double lines, try_double_from_str",
+	      parse_lines_double(buf, len, out));
+	BENCH("double cast_parse_column_double",
+	      column_double(buf, len, out, lines));
+
+	free(buf);
+	free(out);
+	return 0;
+}
@@ -0,0 +1,342 @@
+/*
+ * Compare string parsers of cast with strtoull()/strtoll()/strtod(), sscanf()
+ * and, when built with a C++17 compiler, std::from_chars(), on generated
+ * corpora of numbers. Each input class draws numbers with its own
+ * distribution of digit counts, signs, leading zeros, exponents and share of
+ * invalid strings, and results are reported per class, together with share of
+ * strings each parser accepted, as parsers do not agree on what is valid.
+ *
+ * Usage: bench_parse_corpus [number of values]
+ *        bench_parse_corpus <number of values> <uint|int|float> <min digits>
+ *                           <max digits> <max fraction digits> <% negative>
+ *                           <% leading zeros> <% exponent> <% invalid>
+ *
+ * The second form measures one input class described by arguments.
+ */
+#include "bench.h"
+
+#include <cast.h>
+#include <errno.h>
+#include <inttypes.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef BENCH_FROM_CHARS
+/* std::from_chars() wrappers from bench_from_chars.cpp */
+int from_chars_u64(uint64_t *dst, const char *ptr, size_t len);
+int from_chars_i64(int64_t *dst, const char *ptr, size_t len);
+int from_chars_double(double *dst, const char *ptr, size_t len);
+extern const int from_chars_has_double;
+#endif
+
+enum kind { KIND_UINT, KIND_INT, KIND_FLOAT, KIND_COUNT };
+
+struct input_class {
+	const char *name;
+	enum kind kind;
+	/* Range of number of digits before decimal point */
+	unsigned min_digits;
+	unsigned max_digits;
+	/* Maximum number of digits after decimal point, if any */
+	unsigned fraction_digits;
+	/* Percent of numbers with minus sign, leading zeros and exponent */
+	unsigned negative;
+	unsigned leading_zeros;
+	unsigned exponent;
+	/* Percent of numbers with one character replaced by a letter */
+	unsigned invalid;
+};
+
+static const struct input_class classes[] = {
+	{ "uint 1-4 digits", KIND_UINT, 1U, 4U, 0U, 0U, 0U, 0U, 0U },
+	{ "uint 5-9 digits", KIND_UINT, 5U, 9U, 0U, 0U, 0U, 0U, 0U },
+	{ "uint 10-19 digits", KIND_UINT, 10U, 19U, 0U, 0U, 0U, 0U, 0U },
+	{ "uint leading zeros", KIND_UINT, 1U, 9U, 0U, 0U, 50U, 0U, 0U },
+	{ "uint 10% invalid", KIND_UINT, 1U, 9U, 0U, 0U, 0U, 0U, 10U },
+	{ "int 1-9 signed", KIND_INT, 1U, 9U, 0U, 50U, 0U, 0U, 0U },
+	{ "int 10-18 signed", KIND_INT, 10U, 18U, 0U, 50U, 0U, 0U, 0U },
+	{ "float fixed", KIND_FLOAT, 1U, 6U, 2U, 50U, 0U, 0U, 0U },
+	{ "float 17 digits", KIND_FLOAT, 1U, 3U, 17U, 50U, 0U, 0U, 0U },
+	{ "float exponent", KIND_FLOAT, 1U, 1U, 9U, 50U, 0U, 100U, 0U },
+	{ "float 10% invalid", KIND_FLOAT, 1U, 6U, 6U, 50U, 0U, 0U, 10U },
+};
+
+static uint64_t rng = 88172645463325252U;
+
+static uint64_t next_random(void)
+{
+	rng ^= rng << 13;
+	rng ^= rng >> 7;
+	rng ^= rng << 17;
+	return rng;
+}
+
+/* Random number from range [min, max] */
+static unsigned uniform(unsigned min, unsigned max)
+{
+	return min + (unsigned)(next_random() % (max - min + 1U));
+}
+
+static int percent(unsigned p)
+{
+	return next_random() % 100U < p;
+}
+
+static size_t put_digits(char *buf, unsigned n, int nonzero_first)
+{
+	for (unsigned i = 0U; i < n; ++i) {
+		unsigned digit = nonzero_first && i == 0U && n > 1U
+					 ? uniform(1U, 9U)
+					 : uniform(0U, 9U);
+		buf[i] = (char)('0' + digit);
+	}
+	return n;
+}
+
+/* Write one number of given class, terminated with '\0', and return length */
+static size_t generate(char *buf, const struct input_class *c)
+{
+	size_t len = 0U;
+	if (c->kind != KIND_UINT && percent(c->negative))
+		buf[len++] = '-';
+	if (percent(c->leading_zeros)) {
+		unsigned zeros = uniform(1U, 3U);
+		memset(buf + len, '0', zeros);
+		len += zeros;
+	}
+	len += put_digits(buf + len, uniform(c->min_digits, c->max_digits), 1);
+	if (c->kind == KIND_FLOAT && c->fraction_digits > 0U) {
+		buf[len++] = '.';
+		len += put_digits(buf + len, uniform(1U, c->fraction_digits),
+				  0);
+	}
+	if (c->kind == KIND_FLOAT && percent(c->exponent))
+		len += (size_t)sprintf(buf + len, "e%s%u",
+				       percent(50U) ? "-" : "",
+				       uniform(0U, 30U));
+	if (percent(c->invalid))
+		buf[uniform(0U, (unsigned)len - 1U)] = 'x';
+	buf[len] = '\0';
+	return len;
+}
+
+struct corpus {
+	char *text;
+	size_t *offsets;
+	size_t *lengths;
+	size_t bytes;
+};
+
+static int fill(struct corpus *corpus, const struct input_class *c, size_t n)
+{
+	/*
+	 * Longest number with terminating NUL: sign 1, zeros 3, digits, point 1,
+	 * fraction, exponent "e-30" 4 and NUL 1
+	 */
+	size_t max_len = 10U + c->max_digits + c->fraction_digits;
+	corpus->text = malloc(n * max_len);
+	corpus->offsets = malloc(n * sizeof(*corpus->offsets));
+	corpus->lengths = malloc(n * sizeof(*corpus->lengths));
+	if (!corpus->text || !corpus->offsets || !corpus->lengths)
+		return -1;
+
+	/* Strings are packed one after another, as in a parsed file */
+	size_t offset = 0U;
+	corpus->bytes = 0U;
+	for (size_t i = 0U; i < n; ++i) {
+		char *buf = corpus->text + offset;
+		memset(buf, 0, max_len);
+		corpus->offsets[i] = offset;
+		corpus->lengths[i] = generate(buf, c);
+		corpus->bytes += corpus->lengths[i];
+		offset += corpus->lengths[i] + 1U;
+	}
+	return 0;
+}
+
+static void release(struct corpus *corpus)
+{
+	free(corpus->text);
+	free(corpus->offsets);
+	free(corpus->lengths);
+}
+
+static int strtoull_wrapper(uint64_t *dst, const char *str)
+{
+	errno = 0;
+	char *endptr = NULL;
+	unsigned long long val = strtoull(str, &endptr, 10);
+	if (errno != 0 || *endptr != '\0' || endptr == str)
+		return -1;
+	*dst = val;
+	return 0;
+}
+
+static int strtoll_wrapper(int64_t *dst, const char *str)
+{
+	errno = 0;
+	char *endptr = NULL;
+	long long val = strtoll(str, &endptr, 10);
+	if (errno != 0 || *endptr != '\0' || endptr == str)
+		return -1;
+	*dst = val;
+	return 0;
+}
+
+static int strtod_wrapper(double *dst, const char *str)
+{
+	errno = 0;
+	char *endptr = NULL;
+	double val = strtod(str, &endptr);
+	if (errno != 0 || *endptr != '\0' || endptr == str)
+		return -1;
+	*dst = val;
+	return 0;
+}
+
+/* sscanf() wrappers require whole string to be consumed */
+static int sscanf_u64(uint64_t *dst, const char *str)
+{
+	int end = 0;
+	return sscanf(str, "%" SCNu64 "%n", dst, &end) == 1 && !str[end] ? 0
+									  : -1;
+}
+
+static int sscanf_i64(int64_t *dst, const char *str)
+{
+	int end = 0;
+	return sscanf(str, "%" SCNd64 "%n", dst, &end) == 1 && !str[end] ? 0
+									  : -1;
+}
+
+static int sscanf_double(double *dst, const char *str)
+{
+	int end = 0;
+	return sscanf(str, "%lf%n", dst, &end) == 1 && !str[end] ? 0 : -1;
+}
+
+#define BENCH(label, type, call)                                               \
+	do {                                                                   \
+		double best = 0.0;                                             \
+		size_t accepted = 0U;                                          \
+		BENCH_BEST(best) {                                             \
+			type sum = 0;                                          \
+			accepted = 0U;                                         \
+			for (size_t i = 0; i < n; ++i) {                       \
+				type val = 0;                                  \
+				const char *str =                              \
+					corpus.text + corpus.offsets[i];       \
+				size_t len = corpus.lengths[i];                \
+				(void)len;                                     \
+				if ((call) == 0) {                             \
+					sum += val;                            \
+					++accepted;                            \
+				}                                              \
+			}                                                      \
+			bench_keep(&sum);                                      \
+		}                                                              \
+		printf("%-20s %-22s %8.1f ns %8.1f MB/s %6.1f%% accepted\n",   \
+		       c->name, label, best * 1e9 / (double)n,                 \
+		       (double)corpus.bytes / best / 1e6,                      \
+		       100.0 * (double)accepted / (double)n);                  \
+	} while (0)
+
+static void run(const struct input_class *c, size_t n)
+{
+	struct corpus corpus;
+	if (fill(&corpus, c, n)) {
+		fprintf(stderr, "cannot allocate %zu values\n", n);
+		exit(1);
+	}
+
+	switch (c->kind) {
+	case KIND_UINT:
+		BENCH("try_u64_from_str", uint64_t,
+		      try_u64_from_str(&val, str));
+		BENCH("try_u64_from_strn", uint64_t,
+		      try_u64_from_strn(&val, str, len));
+		BENCH("strtoull wrapper", uint64_t,
+		      strtoull_wrapper(&val, str));
+		BENCH("sscanf", uint64_t, sscanf_u64(&val, str));
+#ifdef BENCH_FROM_CHARS
+		BENCH("std::from_chars", uint64_t,
+		      from_chars_u64(&val, str, len));
+#endif
+		break;
+	case KIND_INT:
+		BENCH("try_i64_from_str", int64_t, try_i64_from_str(&val, str));
+		BENCH("try_i64_from_strn", int64_t,
+		      try_i64_from_strn(&val, str, len));
+		BENCH("strtoll wrapper", int64_t, strtoll_wrapper(&val, str));
+		BENCH("sscanf", int64_t, sscanf_i64(&val, str));
+#ifdef BENCH_FROM_CHARS
+		BENCH("std::from_chars", int64_t,
+		      from_chars_i64(&val, str, len));
+#endif
+		break;
+	case KIND_FLOAT:
+		BENCH("try_double_from_str", double,
+		      try_double_from_str(&val, str));
+		BENCH("try_double_from_strn", double,
+		      try_double_from_strn(&val, str, len));
+		BENCH("strtod wrapper", double, strtod_wrapper(&val, str));
+		BENCH("sscanf", double, sscanf_double(&val, str));
+#ifdef BENCH_FROM_CHARS
+		if (from_chars_has_double)
+			BENCH("std::from_chars", double,
+			      from_chars_double(&val, str, len));
+#endif
+		break;
+	case KIND_COUNT:
+		break;
+	}
+	release(&corpus);
+}
+
+int main(int argc, char **argv)
+{
+	size_t n = argc > 1 ? strtoul(argv[1], NULL, 10) : 1000000U;
+	if (argc == 2 || argc == 1) {
+		for (size_t i = 0U; i < sizeof(classes) / sizeof(classes[0]);
+		     ++i)
+			run(&classes[i], n);
+		return 0;
+	}
+	if (argc != 10) {
+		fprintf(stderr, "wrong number of arguments\n");
+		return 1;
+	}
+
+	static const char *const kinds[] = { "uint", "int", "float" };
+	struct input_class c = { .name = "custom", .kind = KIND_COUNT };
+	unsigned args[7];
+	for (int i = 0; i < 7; ++i) {
+		if (try_uint_from_str(&args[i], argv[i + 3])) {
+			fprintf(stderr, "invalid number %s\n", argv[i + 3]);
+			return 1;
+		}
+	}
+	for (int i = 0; i < KIND_COUNT; ++i)
+		if (!strcmp(argv[2], kinds[i]))
+			c.kind = (enum kind)i;
+	if (c.kind == KIND_COUNT) {
+		fprintf(stderr, "invalid kind %s\n", argv[2]);
+		return 1;
+	}
+	c.min_digits = args[0];
+	c.max_digits = args[1];
+	c.fraction_digits = args[2];
+	c.negative = args[3];
+	c.leading_zeros = args[4];
+	c.exponent = args[5];
+	c.invalid = args[6];
+	if (c.min_digits < 1U || c.max_digits < c.min_digits ||
+	    c.max_digits > 64U || c.fraction_digits > 64U) {
+		fprintf(stderr, "digits must be in range from 1 to 64\n");
+		return 1;
+	}
+	run(&c, n);
+	return 0;
+}
@@ -0,0 +1,121 @@
+/*
+ * Compare conversions, which store results through a pointer, with ones
+ * returning results in structures, when they are called across a function
+ * boundary, as they are from other translation units.
+ *
+ * Usage: bench_result [number of values]
+ */
+#include "bench.h"
+
+#include <cast.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+/* Not static, so the compiler has to keep calling convention */
+__attribute__((noinline)) int convert_u8_ptr(uint8_t *dst, int32_t src);
+__attribute__((noinline)) struct cast_u8_result convert_u8_result(int32_t src);
+__attribute__((noinline)) int convert_i64_ptr(int64_t *dst, double src);
+__attribute__((noinline)) struct cast_i64_result
+convert_i64_result(double src);
+
+int convert_u8_ptr(uint8_t *dst, int32_t src)
+{
+	return try_u8_from_i32(dst, src);
+}
+
+struct cast_u8_result convert_u8_result(int32_t src)
+{
+	return try_u8_from_i32_result(src);
+}
+
+int convert_i64_ptr(int64_t *dst, double src)
+{
+	return try_i64_from_double(dst, src);
+}
+
+struct cast_i64_result convert_i64_result(double src)
+{
+	return try_i64_from_double_result(src);
+}
+
+static uint64_t sum_u8_ptr(const int32_t *src, size_t n)
+{
+	uint64_t sum = 0U;
+	for (size_t i = 0U; i < n; ++i) {
+		uint8_t val = 0U;
+		if (convert_u8_ptr(&val, src[i]) == 0)
+			sum += val;
+	}
+	return sum;
+}
+
+static uint64_t sum_u8_result(const int32_t *src, size_t n)
+{
+	uint64_t sum = 0U;
+	for (size_t i = 0U; i < n; ++i) {
+		struct cast_u8_result res = convert_u8_result(src[i]);
+		if (res.ok)
+			sum += res.value;
+	}
+	return sum;
+}
+
+static uint64_t sum_i64_ptr(const double *src, size_t n)
+{
+	uint64_t sum = 0U;
+	for (size_t i = 0U; i < n; ++i) {
+		int64_t val = 0;
+		if (convert_i64_ptr(&val, src[i]) == 0)
+			sum += (uint64_t)val;
+	}
+	return sum;
+}
+
+static uint64_t sum_i64_result(const double *src, size_t n)
+{
+	uint64_t sum = 0U;
+	for (size_t i = 0U; i < n; ++i) {
+		struct cast_i64_result res = convert_i64_result(src[i]);
+		if (res.ok)
+			sum += (uint64_t)res.value;
+	}
+	return sum;
+}
+
+#define BENCH(name, call)                                                      \
+	do {                                                                   \
+		double best = 0.0;                                             \
+		uint64_t sum = 0U;                                             \
+		BENCH_BEST(best) {                                             \
+			sum = (call);                                          \
+			bench_keep(&sum);                                      \
+		}                                                              \
+		printf("%-24s %8.3f ns/value (sum %llu)\n", name,              \
+		       best * 1e9 / (double)n, (unsigned long long)sum);       \
+	} while (0)
+
+int main(int argc, char **argv)
+{
+	size_t n = argc > 1 ? strtoul(argv[1], NULL, 10) : 16000000U;
+	int32_t *i32 = malloc(n * sizeof(*i32));
+	double *f64 = malloc(n * sizeof(*f64));
+	if (!i32 || !f64) {
+		fprintf(stderr, "cannot allocate %zu values\n", n);
+		return 1;
+	}
+	/* Mostly valid values, as in real code */
+	for (size_t i = 0U; i < n; ++i) {
+		i32[i] = (int32_t)(i % 300U);
+		f64[i] = (double)(i % 1000U) * (i % 7U ? 1.0 : 0.5);
+	}
+
+	BENCH("u8 from i32, pointer", sum_u8_ptr(i32, n));
+	BENCH("u8 from i32, result", sum_u8_result(i32, n));
+	BENCH("i64 from double, pointer", sum_i64_ptr(f64, n));
+	BENCH("i64 from double, result", sum_i64_result(f64, n));
+
+	free(i32);
+	free(f64);
+	return 0;
+}
@@ -0,0 +1,59 @@
+/*
+ * Measure overhead of counting conversions with CAST_STATS, by running the
+ * same kernels compiled without instrumentation, with CAST_STATS and with
+ * CAST_STATS_TOGGLE, while its hook is disabled and enabled.
+ *
+ * Usage: bench_stats [number of values]
+ */
+#include "bench.h"
+
+#include <cast.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+uint64_t sum_panic_off(const int64_t *src, size_t n);
+uint64_t sum_panic_on(const int64_t *src, size_t n);
+uint64_t sum_ctx_off(const int64_t *src, size_t n);
+uint64_t sum_ctx_on(const int64_t *src, size_t n);
+uint64_t sum_panic_toggle(const int64_t *src, size_t n);
+uint64_t sum_ctx_toggle(const int64_t *src, size_t n);
+
+#define BENCH(name, call)                                                      \
+	do {                                                                   \
+		double best = 0.0;                                             \
+		uint64_t sum = 0U;                                             \
+		BENCH_BEST(best) {                                             \
+			sum = (call);                                          \
+			bench_keep(&sum);                                      \
+		}                                                              \
+		printf("%-24s %8.3f ns/value (sum %llu)\n", name,              \
+		       best * 1e9 / (double)n, (unsigned long long)sum);       \
+	} while (0)
+
+int main(int argc, char **argv)
+{
+	size_t n = argc > 1 ? strtoul(argv[1], NULL, 10) : 16000000U;
+	int64_t *src = malloc(n * sizeof(*src));
+	if (!src) {
+		fprintf(stderr, "cannot allocate %zu values\n", n);
+		return 1;
+	}
+	for (size_t i = 0U; i < n; ++i)
+		src[i] = (int64_t)(i % 256U);
+
+	BENCH("panic, stats off", sum_panic_off(src, n));
+	BENCH("panic, toggle disabled", sum_panic_toggle(src, n));
+	BENCH("panic, stats on", sum_panic_on(src, n));
+	BENCH("ctx, stats off", sum_ctx_off(src, n));
+	BENCH("ctx, toggle disabled", sum_ctx_toggle(src, n));
+	BENCH("ctx, stats on", sum_ctx_on(src, n));
+	if (cast_hook_enable(CAST_HOOK_STATS, true) == 0) {
+		BENCH("panic, toggle enabled", sum_panic_toggle(src, n));
+		BENCH("ctx, toggle enabled", sum_ctx_toggle(src, n));
+	}
+	cast_stats_dump(stdout);
+
+	free(src);
+	return 0;
+}
@@ -0,0 +1,32 @@
+/*
+ * Kernels of bench_stats, this file is compiled without instrumentation, with
+ * CAST_STATS and with CAST_STATS_TOGGLE, with BENCH_STATS set to off, on or
+ * toggle.
+ */
+#include "bench.h"
+
+#include <cast.h>
+#include <stdint.h>
+
+#define BENCH_NAME2(prefix, stats) prefix##stats
+#define BENCH_NAME(prefix, stats) BENCH_NAME2(prefix, stats)
+
+uint64_t BENCH_NAME(sum_panic_, BENCH_STATS)(const int64_t *src, size_t n);
+uint64_t BENCH_NAME(sum_ctx_, BENCH_STATS)(const int64_t *src, size_t n);
+
+uint64_t BENCH_NAME(sum_panic_, BENCH_STATS)(const int64_t *src, size_t n)
+{
+	uint64_t sum = 0U;
+	for (size_t i = 0U; i < n; ++i)
+		sum += u8_from_i32(i32_from_i64(src[i]));
+	return sum;
+}
+
+uint64_t BENCH_NAME(sum_ctx_, BENCH_STATS)(const int64_t *src, size_t n)
+{
+	struct cast_ctx ctx = CAST_CTX_INIT;
+	uint64_t sum = 0U;
+	for (size_t i = 0U; i < n; ++i)
+		sum += CAST_CTX(&ctx, u8_from_i64, src[i]);
+	return cast_ctx_check(&ctx) ? 0U : sum;
+}
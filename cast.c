@@ -0,0 +1,3 @@
+// A translation unit which implements the cast library, built as libcast
+#define CAST_IMPLEMENTATION
+#include "cast.h"
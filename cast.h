@@ -81,6 +81,9 @@
  *
  * For a more in depth explanation refer to <https://github.com/nothings/stb/blob/master/docs/stb_howto.txt>
  *
+ * If you use CMake, you can also link with the `cast` library target, which
+ * is such a translation unit (`cast.c`).
+ *
  * Usage
  * -----
  *
@@ -158,6 +161,72 @@
  * }
  * ```
  *
+ * The same conversions, including parsing of strings, are available as
+ * functions returning the converted value together with the status:
+ *
+ * ```c
+ * struct cast_{T'}_result {
+ * 	T value;
+ * 	bool ok;
+ * };
+ * // Try to convert `src` of type U to type T and return it with `ok` set to
+ * // true on success, or return 0 with `ok` set to false on failure.
+ * struct cast_{T'}_result try_{T'}_from_{U'}_result(U src);
+ * ```
+ *
+ * These structures are small enough to be returned in registers, so when
+ * the conversion is not inlined, the value doesn't have to be stored to
+ * memory and loaded back by the caller, as it does with `dst` pointer.
+ *
+ * ```c
+ * struct cast_u16_result port = try_u16_from_strn_result(ptr, len);
+ * if (!port.ok) {
+ * 	// Handle error
+ * }
+ * ```
+ *
+ * ### Deferred error checking
+ *
+ * To convert many values and check for errors once at the end, for example
+ * when decoding records, use:
+ *
+ * ```c
+ * struct cast_ctx {
+ * 	size_t count;           // Number of conversions done
+ * 	size_t first_index;     // Index of the first failed conversion
+ * 	const char *first_name; // Its name, such as "i64 to i32"
+ * 	const char *first_file; // Its source file, or NULL
+ * 	int first_line;         // Its source line, or 0
+ * 	bool failed;            // Whether any conversion failed
+ * };
+ * // Convert `src` of type U to type T and return converted value, or 0 if it
+ * // can't be converted, in which case the failure is recorded in `ctx`
+ * // together with `file` and `line` of the call, which may be NULL and 0.
+ * T {T'}_from_{U'}_ctx(struct cast_ctx *ctx, const char *file, int line,
+ *                      U src);
+ * // Call {T'}_from_{U'}_ctx() with __FILE__ and __LINE__ of the call.
+ * T CAST_CTX(struct cast_ctx *ctx, {T'}_from_{U'}, U src);
+ * // Return 0 if all conversions done with `ctx` succeeded, -1 otherwise.
+ * int cast_ctx_check(const struct cast_ctx *ctx);
+ * ```
+ *
+ * Conversions between integer types check the range with bitwise operations
+ * instead of branches and the loop doesn't need a test after each
+ * conversion, because the batch doesn't stop at the first failure.
+ *
+ * ```c
+ * struct cast_ctx ctx = CAST_CTX_INIT;
+ * for (size_t i = 0; i < n; ++i) {
+ * 	out[i].id = CAST_CTX(&ctx, i32_from_i64, in[i].id);
+ * 	out[i].port = CAST_CTX(&ctx, u16_from_u64, in[i].port);
+ * }
+ * if (cast_ctx_check(&ctx)) {
+ * 	fprintf(stderr, "record %zu: %s failed at %s:%d\n",
+ * 		ctx.first_index / 2U, ctx.first_name, ctx.first_file,
+ * 		ctx.first_line);
+ * }
+ * ```
+ *
  * ### Panic handler invoking functions
  *
  * To convert from `U` type to `T`, without error handling:
@@ -203,6 +272,176 @@
  * then `{T'}_from_{U'}()` when error occurrs those functions will return zero
  * initialized values instead of crashing application.
  *
+ * Panic handler can be also replaced at runtime, globally with
+ * `cast_set_panic_handler()`, or only for the calling thread with
+ * `cast_push_panic_handler()` and `cast_pop_panic_handler()`. Thread handler
+ * takes precedence over global one and both take precedence over
+ * `cast_panic_impl()`. They are looked up only after conversion failed.
+ *
+ * ```c
+ * static void record(enum cast_type src, enum cast_type dst)
+ * {
+ * 	log_warning("%s to %s failed", cast_type_name(src), cast_type_name(dst));
+ * }
+ *
+ * void *request_thread(void *arg)
+ * {
+ * 	cast_push_panic_handler(record);
+ * 	handle_requests(arg); // failed conversions are logged and return 0
+ * 	cast_pop_panic_handler();
+ * 	return NULL;
+ * }
+ * ```
+ *
+ * All `{T'}_from_{U'}()` functions call the panic handler through one shared,
+ * out of line `cast_panic_conversion()` function, which is marked as cold.
+ * Call sites only keep a predicted not taken branch and pass the source value
+ * and one constant identifying the conversion, so failure handling does not
+ * bloat hot code.
+ * Panic message names the failed conversion, for example
+ * `cast: panic in u8_from_i32(): failed to convert i32 to u8`.
+ * Use `scripts/code-size-report.sh` to compare code size of call sites.
+ *
+ * ### Panic policies
+ *
+ * What `{T'}_from_{U'}()` functions do on failure can be selected by defining
+ * `CAST_PANIC_POLICY` before including `cast.h`. It may differ between
+ * translation units, because the implementation provides all of them.
+ *
+ * - `CAST_PANIC_EXIT` - default, invoke the panic handler.
+ * - `CAST_PANIC_TRAP` - execute a trap instruction in place, there is no call
+ *   and no message, so it generates the smallest code.
+ * - `CAST_PANIC_ABORT` - print failed conversion and call `abort()`, which
+ *   dumps core.
+ * - `CAST_PANIC_LOG_CONTINUE` - record failed conversion in a lock-free ring
+ *   buffer of `CAST_PANIC_LOG_SIZE` entries and return zero.
+ * - `CAST_PANIC_LONGJMP` - jump to the innermost recovery scope of the thread.
+ *
+ * ```c
+ * #define CAST_PANIC_POLICY CAST_PANIC_LOG_CONTINUE
+ * #include "cast.h"
+ *
+ * uint8_t x = u8_from_i32(300); // x is 0, failure is logged
+ * enum cast_type src, dst;
+ * for (size_t i = 0; i < cast_panic_log_count(); ++i) {
+ * 	if (cast_panic_log_get(i, &src, &dst) == 0)
+ * 		printf("%s to %s failed\n", cast_type_name(src),
+ * 		       cast_type_name(dst));
+ * }
+ * ```
+ *
+ * Recovery scopes let batch jobs abandon work on the first failure. Local
+ * variables modified after `setjmp()` have to be `volatile`.
+ *
+ * ```c
+ * #define CAST_PANIC_POLICY CAST_PANIC_LONGJMP
+ * #include "cast.h"
+ *
+ * struct cast_recovery scope;
+ * cast_recovery_push(&scope);
+ * if (setjmp(scope.env) == 0) {
+ * 	for (size_t i = 0; i < n; ++i)
+ * 		out[i] = u8_from_i32(in[i]);
+ * } else {
+ * 	fprintf(stderr, "%s to %s failed\n", cast_type_name(scope.src),
+ * 		cast_type_name(scope.dst));
+ * }
+ * cast_recovery_pop(&scope);
+ * ```
+ *
+ * ### Conversion statistics
+ *
+ * Defining `CAST_STATS` before including `cast.h` makes conversion functions
+ * count calls and failures of each pair of types. Counting is done once in
+ * `try_{T'}_from_{U'}()`, which `{T'}_from_{U'}()`,
+ * `try_{T'}_from_{U'}_result()` and `{T'}_from_{U'}_ctx()` call, so each
+ * conversion is counted once whichever variant is used. Without `CAST_STATS`
+ * counting is compiled out.
+ *
+ * Each thread increments its own cache line aligned counters, which are
+ * summed when they are read. Counts of exited threads are kept.
+ *
+ * ```c
+ * #define CAST_STATS
+ * #include "cast.h"
+ *
+ * uint64_t failures;
+ * uint64_t calls = cast_stats_get(CAST_TYPE_i64, CAST_TYPE_u8, &failures);
+ *
+ * // Write all counters in OpenMetrics text format, for example:
+ * // cast_conversions_total{src="i64",dst="u8"} 1000
+ * // cast_conversion_failures_total{src="i64",dst="u8"} 3
+ * cast_stats_dump(file);
+ * ```
+ *
+ * Defining `CAST_STATS_TOGGLE` instead compiles counting in, but disabled
+ * until `cast_hook_enable(CAST_HOOK_STATS, true)` is called, or until the
+ * signal passed to `cast_hook_toggle_on_signal()` is received. On x86-64
+ * Linux a disabled hook is a NOP in front of the uninstrumented conversion,
+ * which enabling patches into a jump to an instrumented copy of it, so it
+ * costs no load and no branch. Elsewhere, or with `CAST_NO_JUMP_LABELS`, it
+ * is a check of a global flag, which the signal handler toggles directly.
+ *
+ * ```c
+ * #define CAST_STATS_TOGGLE
+ * #include "cast.h"
+ *
+ * // Start counting on SIGUSR1 and stop on the next one
+ * cast_hook_toggle_on_signal(CAST_HOOK_STATS, SIGUSR1);
+ * ```
+ *
+ * ### Tracing failures
+ *
+ * On x86-64 Linux failed conversions fire USDT probes, which are NOPs until
+ * a tracer attaches to them. Their arguments are source type, destination
+ * type (values of `enum cast_type`), bits of source value and address of
+ * code, which called the conversion.
+ *
+ * - `cast:panic` - fired before panic policy is applied.
+ * - `cast:failure` - fired by every conversion function compiled with
+ *   `CAST_TRACE`, while `CAST_HOOK_TRACE` is enabled. It is fired once in
+ *   `try_{T'}_from_{U'}()`, which the other variants call, so failures of
+ *   panicking conversions fire it before `cast:panic`.
+ *
+ * ```sh
+ * bpftrace -e 'usdt:./app:cast:panic { printf("%d to %d at %p\n", arg0, arg1, arg3); }'
+ * ```
+ *
+ * Failures traced by `CAST_TRACE` are also kept in a flight recorder of each
+ * thread, which remembers last `CAST_TRACE_SIZE` of them and can be written
+ * with `cast_trace_dump()`. Addresses can be resolved with `addr2line`.
+ *
+ * ```c
+ * #define CAST_TRACE
+ * #include "cast.h"
+ *
+ * cast_hook_enable(CAST_HOOK_TRACE, true);
+ * uint8_t res;
+ * try_u8_from_i64(&res, 300);
+ * // thread 0 failure 0: i64 to u8, value 0x12c, at 0x55d0c3a1b2f0
+ * cast_trace_dump(stderr);
+ * ```
+ *
+ * ### Profiling value ranges
+ *
+ * Defining `CAST_PROFILE` makes every call site of a conversion function
+ * with integer destination type, `try_{T'}_from_{U'}()` included, keep
+ * number, minimum and maximum of its results.
+ * Sites are registered at compile time in `cast_profile_sites` section. At
+ * exit sites, whose results would fit a narrower type, are written as JSON to
+ * file named by `CAST_PROFILE_OUTPUT` environment variable, or to
+ * `cast-profile.json`. It is supported on x86-64 Linux.
+ *
+ * ```json
+ * {
+ *   "sites": [
+ *     {"address": "0x5596ee766562", "offset": "0x2562", "src": "i64", "dst": "i32", "count": 1001, "min": 0, "max": 299, "narrow": "i16"}
+ *   ]
+ * }
+ * ```
+ *
+ * Source line of a site is printed by `addr2line -i -e program offset`.
+ *
  * ### Casting integer types
  *
  * Casting integer types will check if destination type
@@ -295,13 +534,190 @@
  * ```
  *
  * Analoguous functions exists for `double` and they allow more integers due
- * to the fact that `double` has 54 bits of mantissa (with implicit bit).
+ * to the fact that `double` has 53 bits of mantissa (with implicit bit).
  *
  * ```c
  * double ok = double_from_u32(0xFFFFFFFFUL);
  * double also_ok = double_from_u64(0xFFFFFFFFFFFF0000ULL);
  * double not_ok = double_from_u64(0xFFFFFFFFFFFFFFFFULL); // error
  * ```
+ *
+ * ### Parsing strings
+ *
+ * Integers can be parsed from a slice of a larger buffer, which doesn't have
+ * to be NULL-terminated, with:
+ *
+ * ```c
+ * // Try to parse exactly `len` characters at `ptr` as a decimal integer of
+ * // type T stored in `dst` and return 0 on success and non-zero value on
+ * // failure. In the case of error `dst` is left unmodified.
+ * int try_{T'}_from_strn(T *dst, const char *ptr, size_t len);
+ * // Same as above, but invoke the panic handler on failure.
+ * T {T'}_from_strn(const char *ptr, size_t len);
+ * ```
+ *
+ * Unlike `try_{T'}_from_str()`, which is based on `strtoull()` and
+ * `strtoll()`, these functions accept only an optional sign followed by
+ * decimal digits, so `"010"` is 10, and `" 1"`, `"0x10"` and `""` are errors.
+ * A minus sign is accepted only for signed types. They don't depend on locale
+ * and don't modify `errno`. Overflow is detected while digits are accumulated
+ * and digits are converted eight at a time on little endian targets.
+ *
+ * ```c
+ * const char *line = "GET 404 1532";
+ * int status = 0;
+ * if (try_int_from_strn(&status, line + 4, 3)) {
+ * 	fprintf(stderr, "bad status\n");
+ * }
+ * ```
+ *
+ * `try_float_from_strn()` and `try_double_from_strn()` parse an optional sign,
+ * digits with an optional decimal point and an optional exponent, such as
+ * `"-1.5e-3"`. They are correctly rounded and give the same results as
+ * `strtof()` and `strtod()` in the "C" locale, including errors for values
+ * which overflow or underflow. Values with up to 19 significant digits are
+ * converted with the Eisel-Lemire algorithm, longer ones fall back to exact
+ * decimal arithmetic only when the dropped digits affect rounding.
+ * `try_float_from_str()` and `try_double_from_str()` use the same parser and
+ * call `strtof()` or `strtod()` only for other inputs, such as hexadecimal
+ * numbers, infinity or leading whitespace.
+ *
+ * Whole columns of delimited text, such as a field of a CSV file or a file
+ * with one number per line, can be parsed into arrays with:
+ *
+ * ```c
+ * // Parse values separated by `delim` or newlines in `len` characters at
+ * // `buf` into `out`, which has room for `cap` values, and return 0 on success
+ * // and -1 on failure. The number of parsed values is stored in `count`. In
+ * // the case of error, the offset of the first token which is not valid, or
+ * // doesn't fit `out`, is stored in `err_offset`. Pointers may be NULL.
+ * int cast_parse_column_{T'}(const char *buf, size_t len, char delim, T *out,
+ *                            size_t cap, size_t *count, size_t *err_offset);
+ * ```
+ *
+ * Tokens have the same syntax as for `try_{T'}_from_strn()`. A carriage return
+ * before a newline is ignored and a separator at the end of text doesn't start
+ * another value, so files with CRLF line endings or a trailing newline can be
+ * passed as is, but empty tokens elsewhere are errors. Separators are found 64
+ * bytes at a time with SSE2 or AVX2 comparisons and, when AVX2 is available,
+ * integers of up to 16 digits are converted with a few vector instructions.
+ *
+ * ```c
+ * size_t count = 0U;
+ * size_t bad = 0U;
+ * if (cast_parse_column_u32(text, text_len, '\n', ids, max_ids, &count, &bad)) {
+ * 	fprintf(stderr, "bad id at offset %zu\n", bad);
+ * }
+ * ```
+ *
+ * Integers are formatted in decimal with:
+ *
+ * ```c
+ * // Write `value` to `buf`, which has room for `cap` characters, and return
+ * // the number of characters written or 0 if they don't fit, in which case
+ * // nothing is written. No NULL character is written.
+ * size_t cast_fmt_{T'}(char *buf, size_t cap, T value);
+ * // Same as above, but also write NULL character, which is not counted in the
+ * // returned length.
+ * size_t cast_fmt_{T'}_str(char *buf, size_t cap, T value);
+ * // Write elements of `src` separated by `sep` and return the number of
+ * // characters written. Stops before the first element which doesn't fit and
+ * // stores the number of written elements in `count` (if it is not NULL).
+ * size_t cast_fmt_{T'}_array(char *buf, size_t cap, const T *src, size_t n,
+ *                            char sep, size_t *count);
+ * ```
+ *
+ * The length is computed upfront from the number of significant bits and
+ * digits are written two at a time from a table, so these functions are much
+ * faster than `snprintf()`. A buffer of `CAST_FMT_INT_SIZE` characters fits
+ * any integer and `CAST_FMT_INT_SIZE + 1` fits it with NULL character.
+ *
+ * `cast_fmt_float()` and `cast_fmt_double()`, with the same `_str` and
+ * `_array` variants, write the shortest decimal number which is parsed back to
+ * the same value, found with the Ryu algorithm. They don't depend on locale
+ * and don't allocate memory. Numbers with decimal exponent from -4 to 15 are
+ * written in fixed notation, such as `"0.001"` or `"12.5"`, and other numbers
+ * in scientific notation, such as `"1e-5"` or `"1.5e300"`. Any value fits
+ * `CAST_FMT_FLOAT_SIZE` characters. Output of finite values is accepted by
+ * `try_{T'}_from_strn()`, except subnormal numbers, which the parsers reject
+ * as underflow.
+ *
+ * ```c
+ * char line[64];
+ * size_t len = cast_fmt_u64(line, sizeof(line), id);
+ * line[len++] = '\n';
+ * fwrite(line, 1, len, stdout);
+ * ```
+ *
+ * ### Converting arrays
+ *
+ * Arrays of integers can be converted at once with:
+ *
+ * ```c
+ * // Try to convert `n` elements of `src` to type T stored in `dst` and return
+ * // 0 on success and non-zero value on failure. In the case of error the index
+ * // of the first element which does not fit is stored in `first_bad`
+ * // (if it is not NULL), elements before it are converted and the remaining
+ * // elements of `dst` are left unmodified.
+ * int try_{T'}_from_{U'}_array(T *dst, const U *src, size_t n, size_t *first_bad);
+ * ```
+ *
+ * These functions are available for every pair of integer types and for
+ * conversions between integer arrays and `float` or `double` arrays. The range
+ * checks and narrowing are done with SSE2 or AVX2 instructions, when the
+ * translation unit is compiled with support for them. Floating point values
+ * are converted only if they are integral and in range, which is checked by
+ * truncating each value and converting it back (AVX-512DQ is used for 64-bit
+ * destinations). Integers are converted only if they are represented exactly,
+ * which is also checked by converting each value back.
+ *
+ * ```c
+ * size_t bad = 0U;
+ * if (try_u8_from_i32_array(pixels, samples, count, &bad)) {
+ * 	fprintf(stderr, "sample %zu is out of range\n", bad);
+ * }
+ * ```
+ *
+ * On x86 with GCC or Clang, SSE2, AVX2 and AVX-512 versions of array kernels
+ * are compiled into the translation unit which defines `CAST_IMPLEMENTATION`
+ * and the best one supported by the CPU is selected on first use, so a single
+ * binary can run on different machines. Set `CAST_FORCE_ISA` environment
+ * variable to `scalar`, `sse2`, `avx2` or `avx512` to use a lower level, for
+ * example to benchmark them on one machine. Define `CAST_NO_DISPATCH` to
+ * select kernels at compile time from flags of each translation unit instead.
+ *
+ * To only check if an integer array can be converted, without writing it
+ * anywhere, or to find the range of its values use:
+ *
+ * ```c
+ * // Return true if every element of `src` fits type T. Returns as soon as a
+ * // block with an element which does not fit is found.
+ * bool cast_all_fit_{T'}_from_{U'}(const U *src, size_t n);
+ * // Same as above, but always scans whole array without branching on
+ * // intermediate results, which is faster when most arrays are valid.
+ * bool cast_all_fit_{T'}_from_{U'}_full(const U *src, size_t n);
+ * // Store the smallest and the largest element of `src` in `min` and `max`
+ * // (if they are not NULL) and return 0, or return -1 if `n` is 0.
+ * int cast_minmax_{T'}(const T *src, size_t n, T *min, T *max);
+ * ```
+ *
+ * Arrays of many megabytes can be converted by a pool of threads with:
+ *
+ * ```c
+ * // Same as try_{T'}_from_{U'}_array(), but the array is split into cache
+ * // aligned chunks converted in parallel. The index of the first element
+ * // which does not fit is reported as with the single threaded version, but
+ * // elements after it may be converted as well.
+ * int try_{T'}_from_{U'}_array_mt(T *dst, const U *src, size_t n, size_t *first_bad);
+ * // Set the number of threads, 0 selects the value of `CAST_THREADS`
+ * // environment variable or the number of online CPUs.
+ * unsigned cast_set_threads(unsigned threads);
+ * ```
+ *
+ * Threads are started on first use and reused by later conversions. Arrays
+ * smaller than `CAST_PARALLEL_MIN_BYTES` and arrays passed while the pool is
+ * busy are converted by the calling thread. Define `CAST_NO_THREADS` to build
+ * without pthreads, in which case the `_mt` functions are single threaded.
  */
 
 #include <assert.h>
@@ -310,6 +726,10 @@
 #include <stddef.h>
 #include <limits.h>
 #include <math.h>
+#include <setjmp.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <string.h>
 
 typedef uintmax_t cast_largest_utype;
 
@@ -352,471 +772,1788 @@ void cast_panic_impl(const char *format, ...)
 	cast_panic_impl("cast: panic in %s():%d: " msg "\n", __func__,         \
 			__LINE__, __VA_ARGS__)
 
+#if defined(__GNUC__) || defined(__clang__)
+#define CAST_LIKELY(x) __builtin_expect(!!(x), 1)
+#define CAST_UNLIKELY(x) __builtin_expect(!!(x), 0)
+/* Keep function out of line and out of hot code */
+#define CAST_COLD __attribute__((cold, noinline))
+#else
+#define CAST_LIKELY(x) (x)
+#define CAST_UNLIKELY(x) (x)
+#define CAST_COLD
+#endif
+
+/* List of types, which are sources or destinations of conversions */
+#define CAST_TYPE_IDS(X)                                                       \
+	X(u8)                                                                  \
+	X(u16)                                                                 \
+	X(u32)                                                                 \
+	X(u64)                                                                 \
+	X(uchar)                                                               \
+	X(uint)                                                                \
+	X(ushort)                                                              \
+	X(ulong)                                                               \
+	X(ullong)                                                              \
+	X(size)                                                                \
+	X(uptr)                                                                \
+	X(i8)                                                                  \
+	X(i16)                                                                 \
+	X(i32)                                                                 \
+	X(i64)                                                                 \
+	X(schar)                                                               \
+	X(int)                                                                 \
+	X(short)                                                               \
+	X(long)                                                                \
+	X(llong)                                                               \
+	X(ptrdiff)                                                             \
+	X(float)                                                               \
+	X(double)                                                              \
+	X(bool)                                                                \
+	X(str)                                                                 \
+	X(strn)                                                                \
+	/* END */
+
+#define CAST_TYPE_ID_ENUM(type_name) CAST_TYPE_##type_name,
+/* Identifiers of types, such as CAST_TYPE_u8 */
+enum cast_type { CAST_TYPE_IDS(CAST_TYPE_ID_ENUM) CAST_TYPE_COUNT };
+#undef CAST_TYPE_ID_ENUM
+
+/* Pack identifiers of source and destination types into one integer */
+#define CAST_TYPE_PAIR(src, dst) ((unsigned)(src) << 8 | (unsigned)(dst))
+
 /**
- * Shift all least significant zeros right.
+ * Return bits of value of any type, so it can be passed out of line.
  *
- * @param value    Value for which zeros are to be removed.
+ * Bits are zero extended, on little endian targets value can be decoded by
+ * its type, strings are passed as pointers.
  *
- * @return value with all least significant zeros shifted away.
+ * @param src    Pointer to value.
+ * @param size   Size of value.
+ *
+ * @return Bits of value.
  */
-static inline cast_largest_utype
-cast_shift_zeros_right(cast_largest_utype value)
+static inline uint64_t cast_value_bits(const void *src, size_t size)
 {
-#if defined(__GNU_C__) || defined(__clang__)
-	return value > 0U ? value >> (size_t)__builtin_ctzll(value) : 0U;
-#else
-	if ((value & 0xFFFFFFFFU) == 0U)
-		value >>= 32U;
-	if ((value & 0xFFFFU) == 0U)
-		value >>= 16U;
-	if ((value & 0xFFU) == 0U)
-		value >>= 8U;
-	if ((value & 0xFU) == 0U)
-		value >>= 4U;
-	if ((value & 0x3U) == 0U)
-		value >>= 2U;
-	if ((value & 0x1U) == 0U)
-		value >>= 1U;
-
-	return value;
-#endif
+	uint64_t bits = 0U;
+	memcpy(&bits, src, size < sizeof(bits) ? size : sizeof(bits));
+	return bits;
 }
 
 /**
- * This is wrapper for strtoull(), but with easier error handling.
- * 
- * @param dst   Pointer to variable, where conversion result will be stored.
- * @param str   NULL-terminated string to convert to unsigned long long.
+ * Invoke panic handler, because conversion failed.
  *
- * @return 0 on success, non-zero on failure.
+ * It is shared by all conversions, so only passing two arguments is inlined
+ * in their callers.
+ *
+ * @param pair    Source and destination types packed by CAST_TYPE_PAIR().
+ * @param value   Bits of source value returned by cast_value_bits().
  */
-int cast_try_ullong_from_str(unsigned long long *dst, const char *str);
+CAST_COLD void cast_panic_conversion(unsigned pair, uint64_t value);
 
 /**
- * This is wrapper for strtoll(), but with easier error handling.
+ * Runtime panic handler, which is invoked when conversion fails.
  *
- * @param dst   Pointer to variable, where conversion result will be stored.
- * @param str   NULL-terminated string to convert to long long.
+ * If it returns, then failed conversion returns zero.
  *
- * @return 0 on success, non-zero on failure.
+ * @param src   Source type of failed conversion.
+ * @param dst   Destination type of failed conversion.
  */
-int cast_try_llong_from_str(long long *dst, const char *str);
+typedef void (*cast_panic_handler)(enum cast_type src, enum cast_type dst);
+
+/* Largest number of handlers pushed by a thread */
+#ifndef CAST_PANIC_HANDLER_DEPTH
+#define CAST_PANIC_HANDLER_DEPTH 8U
+#endif
 
 /**
- * This is wrapper for strtof(), but with easier error handling.
+ * Set panic handler of threads, which did not push their own.
  *
- * @param dst   Pointer to variable, where conversion result will be stored.
- * @param str   NULL-terminated string to convert to long long.
+ * It is swapped atomically, so it can be changed while other threads convert.
  *
- * @return 0 on success, non-zero on failure.
+ * @param handler   New handler, NULL restores cast_panic_impl().
+ *
+ * @return Previous handler, NULL if it was cast_panic_impl().
  */
-int cast_try_float_from_str(float *dst, const char *str);
+cast_panic_handler cast_set_panic_handler(cast_panic_handler handler);
 
 /**
- * This is wrapper for strtod(), but with easier error handling.
+ * Override panic handler of the calling thread, until it is popped.
  *
- * @param dst   Pointer to variable, where conversion result will be stored.
- * @param str   NULL-terminated string to convert to long long.
+ * @param handler   Handler, NULL makes the thread use the global handler.
  *
- * @return 0 on success, non-zero on failure.
+ * @return 0 on success, -1 if CAST_PANIC_HANDLER_DEPTH handlers are pushed.
  */
-int cast_try_double_from_str(double *dst, const char *str);
+int cast_push_panic_handler(cast_panic_handler handler);
 
 /**
- * Define a wrapper conversion function, which will trigger panic handler
- * if conversion can't be performed.
+ * Restore panic handler of the calling thread, which was active before the
+ * last cast_push_panic_handler().
  *
- * @param dst_type         Destination type.
- * @param dst_type_name    Destination type name.
- * @param src_type         Source type.
- * @param dst_type_name    Source type name.
+ * @return 0 on success, -1 if there was no pushed handler.
  */
-#define CAST_DEFINE_FROM(dst_type, dst_type_name, src_type, src_type_name)     \
-	static inline dst_type dst_type_name##_from_##src_type_name(           \
-	    src_type src)                                                      \
-	{                                                                      \
-		dst_type tmp = 0;                                              \
-		if (try_##dst_type_name##_from_##src_type_name(&tmp, src)) {   \
-			cast_panic("failed to convert %s to %s",               \
-				   #src_type_name, #dst_type_name);            \
-			return tmp;                                            \
-		}                                                              \
-		return tmp;                                                    \
-	}
+int cast_pop_panic_handler(void);
+
+/* Values of CAST_PANIC_POLICY */
+/* Invoke panic handler, which exits by default */
+#define CAST_PANIC_EXIT 0
+/* Execute trap instruction in place of failed conversion */
+#define CAST_PANIC_TRAP 1
+/* Print failed conversion and abort, which dumps core */
+#define CAST_PANIC_ABORT 2
+/* Log failed conversion in a ring buffer and return zero */
+#define CAST_PANIC_LOG_CONTINUE 3
+/* Jump to the innermost struct cast_recovery of the thread */
+#define CAST_PANIC_LONGJMP 4
+
+/* Action of {T}_from_{U}() on failure, may differ between translation units */
+#ifndef CAST_PANIC_POLICY
+#define CAST_PANIC_POLICY CAST_PANIC_EXIT
+#endif
+
+/* Number of entries in ring buffer of log_continue policy, power of two */
+#ifndef CAST_PANIC_LOG_SIZE
+#define CAST_PANIC_LOG_SIZE 256U
+#endif
 
 /**
- * Define a conversion function for signed to unsigned conversions.
+ * Print failed conversion to stderr and abort.
  *
- * @param dst_type         Destination type.
- * @param dst_type_name    Destination type name.
- * @param dst_type_max     Maximum value that fits destination type.
- * @param src_type         Source type.
- * @param dst_type_name    Source type name.
+ * @param pair    Source and destination types packed by CAST_TYPE_PAIR().
+ * @param value   Bits of source value returned by cast_value_bits().
  */
-#define CAST_DEFINE_TRY_U_FROM_S(dst_type, dst_type_name, dst_max, src_type,   \
-				 src_type_name)                                \
-	static inline int try_##dst_type_name##_from_##src_type_name(          \
-	    dst_type *dst, src_type src)                                       \
-	{                                                                      \
-		if (dst == NULL || src < 0 ||                                  \
-		    (cast_largest_utype)src > (cast_largest_utype)dst_max) {   \
-			return -1;                                             \
-		}                                                              \
-		*dst = (dst_type)src;                                          \
-		return 0;                                                      \
-	}                                                                      \
-	CAST_DEFINE_FROM(dst_type, dst_type_name, src_type, src_type_name)
+CAST_COLD _Noreturn void cast_panic_abort(unsigned pair, uint64_t value);
 
 /**
- * Define a conversion function for unsigned to unsigned conversions.
+ * Record failed conversion in ring buffer and return.
  *
- * @param dst_type         Destination type.
- * @param dst_type_name    Destination type name.
- * @param dst_type_max     Maximum value that fits destination type.
- * @param src_type         Source type.
- * @param dst_type_name    Source type name.
+ * It is lock-free and safe to call from many threads at once.
+ *
+ * @param pair    Source and destination types packed by CAST_TYPE_PAIR().
+ * @param value   Bits of source value returned by cast_value_bits().
  */
-#define CAST_DEFINE_TRY_U_FROM_U(...) CAST_DEFINE_TRY_U_FROM_S(__VA_ARGS__)
+CAST_COLD void cast_panic_log(unsigned pair, uint64_t value);
 
 /**
- * Define a conversion function for signed to unsigned conversions.
+ * Jump to the innermost recovery scope of the calling thread.
  *
- * @param dst_type         Destination type.
- * @param dst_type_name    Destination type name.
- * @param dst_type_max     Maximum value that fits destination type.
- * @param src_type         Source type.
- * @param dst_type_name    Source type name.
+ * Without active scope it behaves as cast_panic_conversion().
+ *
+ * @param pair    Source and destination types packed by CAST_TYPE_PAIR().
+ * @param value   Bits of source value returned by cast_value_bits().
  */
-#define CAST_DEFINE_TRY_S_FROM_U(...) CAST_DEFINE_TRY_U_FROM_S(__VA_ARGS__)
+CAST_COLD void cast_panic_longjmp(unsigned pair, uint64_t value);
+
+#if CAST_PANIC_POLICY == CAST_PANIC_TRAP &&                                    \
+    (defined(__GNUC__) || defined(__clang__))
+#define CAST_PANIC_CONVERSION(pair, value)                                     \
+	((void)(pair), (void)(value), __builtin_trap())
+#elif CAST_PANIC_POLICY == CAST_PANIC_TRAP ||                                  \
+    CAST_PANIC_POLICY == CAST_PANIC_ABORT
+#define CAST_PANIC_CONVERSION(pair, value) cast_panic_abort(pair, value)
+#elif CAST_PANIC_POLICY == CAST_PANIC_LOG_CONTINUE
+#define CAST_PANIC_CONVERSION(pair, value) cast_panic_log(pair, value)
+#elif CAST_PANIC_POLICY == CAST_PANIC_LONGJMP
+#define CAST_PANIC_CONVERSION(pair, value) cast_panic_longjmp(pair, value)
+#else
+#define CAST_PANIC_CONVERSION(pair, value) cast_panic_conversion(pair, value)
+#endif
 
 /**
- * Define a conversion function for signed to signed conversions.
+ * Return name of type, such as "u8" for CAST_TYPE_u8.
  *
- * @param dst_type         Destination type.
- * @param dst_type_name    Destination type name.
- * @param dst_min          Minimum value that fits destination type.
- * @param dst_max          Maximum value that fits destination type.
- * @param src_type         Source type.
- * @param dst_type_name    Source type name.
+ * @param type   Type identifier.
+ *
+ * @return Name of type or "unknown".
  */
-#define CAST_DEFINE_TRY_S_FROM_S(dst_type, dst_type_name, dst_min, dst_max,    \
-				 src_type, src_type_name)                      \
-	static inline int try_##dst_type_name##_from_##src_type_name(          \
-	    dst_type *dst, src_type src)                                       \
-	{                                                                      \
-		if (dst == NULL || src < dst_min || src > dst_max) {           \
-			return -1;                                             \
-		}                                                              \
-		*dst = (dst_type)src;                                          \
-		return 0;                                                      \
-	}                                                                      \
-	CAST_DEFINE_FROM(dst_type, dst_type_name, src_type, src_type_name)
+const char *cast_type_name(enum cast_type type);
 
 /**
- * Define a conversion function for unsigned from string conversions.
+ * Return number of failed conversions logged by log_continue policy.
  *
- * @param dst_type         Destination type.
- * @param dst_type_name    Destination type name.
+ * @return Number of failures since start of program, including ones, which
+ *         were already overwritten in the ring buffer.
  */
-#define CAST_DEFINE_TRY_U_FROM_STR(dst_type, dst_type_name)                    \
-	static inline int try_##dst_type_name##_from_str(dst_type *dst,        \
-							 const char *str)      \
-	{                                                                      \
-		unsigned long long tmp = 0U;                                   \
-		int ret = cast_try_ullong_from_str(&tmp, str);                 \
-		if (ret)                                                       \
-			return -1;                                             \
-		return try_##dst_type_name##_from_ullong(dst, tmp);            \
-	} \
-	CAST_DEFINE_FROM(dst_type, dst_type_name, const char *, str)
+size_t cast_panic_log_count(void);
 
 /**
- * Define a conversion function for floating point from string conversions.
+ * Read failed conversion logged by log_continue policy.
  *
- * @param dst_type         Destination type.
- * @param dst_type_name    Destination type name.
+ * @param index   Index of failure, counted from 0 since start of program.
+ * @param src     Where to store source type, may be NULL.
+ * @param dst     Where to store destination type, may be NULL.
+ *
+ * @return 0 on success, -1 if failure was not logged yet or it was
+ *         overwritten by newer ones.
  */
-#define CAST_DEFINE_TRY_F_FROM_STR(dst_type, dst_type_name)                    \
-	static inline int try_##dst_type_name##_from_str(dst_type *dst,        \
-							 const char *str)      \
-	{                                                                      \
-		int ret = cast_try_##dst_type##_from_str(dst, str);            \
-		if (ret)                                                       \
-			return -1;                                             \
-		return 0;                                                      \
-	}                                                                      \
-	CAST_DEFINE_FROM(dst_type, dst_type_name, const char *, str)
+int cast_panic_log_get(size_t index, enum cast_type *src,
+		       enum cast_type *dst);
+
+/* Scope of conversions, which recover from failures with longjmp policy */
+struct cast_recovery {
+	/* Where to jump on failure, set it with setjmp() */
+	jmp_buf env;
+	/* Scope, which was innermost before this one */
+	struct cast_recovery *prev;
+	/* Source type of failed conversion */
+	enum cast_type src;
+	/* Destination type of failed conversion */
+	enum cast_type dst;
+};
 
 /**
- * Define a conversion function for signed from string conversions.
+ * Make scope innermost recovery scope of the calling thread.
  *
- * @param dst_type         Destination type.
- * @param dst_type_name    Destination type name.
+ * @param scope   Scope, whose env has to be set by setjmp() before any
+ *                conversion fails.
  */
-#define CAST_DEFINE_TRY_S_FROM_STR(dst_type, dst_type_name)                    \
-	static inline int try_##dst_type_name##_from_str(dst_type *dst,        \
-							 const char *str)      \
-	{                                                                      \
-		long long tmp = 0U;                                            \
-		int ret = cast_try_llong_from_str(&tmp, str);                  \
-		if (ret)                                                       \
-			return -1;                                             \
-		return try_##dst_type_name##_from_llong(dst, tmp);             \
-	}                                                                      \
-	CAST_DEFINE_FROM(dst_type, dst_type_name, const char *, str)
+void cast_recovery_push(struct cast_recovery *scope);
 
 /**
- * Define a conversion function for signed to floating point conversions.
+ * Restore recovery scope, which was innermost before scope was pushed.
  *
- * @param dst_type         Destination type.
- * @param dst_type_name    Destination type name.
- * @param mantissa_bits    Number of mantissa bits
- * @param src_type         Source type.
- * @param src_type_name    Source type name.
- * @param src_min          Minimum value that fits source type.
+ * It has to be called after both normal and failed path, failed
+ * conversion already popped the scope, so calling it again is harmless.
+ *
+ * @param scope   Scope passed to cast_recovery_push().
  */
-#define CAST_DEFINE_TRY_F_FROM_S(dst_type, dst_type_name, mantissa_bits,       \
-				 src_type, src_type_name, src_min)             \
-	static inline int try_##dst_type_name##_from_##src_type_name(          \
-	    dst_type *dst, src_type src)                                       \
-	{                                                                      \
-		if (!dst)                                                      \
-			return -1;                                             \
-		if (sizeof(src) < sizeof(*dst)) {                              \
-			*dst = (dst_type)src;                                  \
-			return 0;                                              \
-		}                                                              \
-		/* Prune UB from `-(src)` operation. */                        \
-		if (src == src_min) {                                          \
-			*dst = (dst_type)src;                                  \
-			return 0;                                              \
-		}                                                              \
-		cast_largest_utype relevant = cast_shift_zeros_right(          \
-		    (cast_largest_utype)(src < 0 ? -src : src));               \
-		if (relevant > (1ULL << mantissa_bits) - 1ULL)                 \
-			return -1;                                             \
-		*dst = (dst_type)src;                                          \
-		return 0;                                                      \
-	}                                                                      \
-	CAST_DEFINE_FROM(dst_type, dst_type_name, src_type, src_type_name)
+void cast_recovery_pop(struct cast_recovery *scope);
+
+/* Number of calls and failures of one conversion */
+struct cast_stats_counter {
+	_Atomic uint64_t calls;
+	_Atomic uint64_t failures;
+};
+
+/* Counters of the calling thread indexed by source type * CAST_TYPE_COUNT +
+ * destination type, NULL until the thread records the first conversion */
+extern _Thread_local struct cast_stats_counter *cast_stats_thread;
 
 /**
- * Define a conversion function for unsigned to floating point conversions.
+ * Assign block of counters to the calling thread.
  *
- * @param dst_type         Destination type.
- * @param dst_type_name    Destination type name.
- * @param mantissa_bits    Number of mantissa bits
- * @param src_type         Source type.
- * @param src_type_name    Source type name.
+ * @return Counters of the thread.
  */
-#define CAST_DEFINE_TRY_F_FROM_U(dst_type, dst_type_name, mantissa_bits,       \
-				 src_type, src_type_name)                      \
-	static inline int try_##dst_type_name##_from_##src_type_name(          \
-	    dst_type *dst, src_type src)                                       \
-	{                                                                      \
-		if (!dst)                                                      \
-			return -1;                                             \
-		if (sizeof(src) < sizeof(*dst)) {                              \
-			*dst = (dst_type)src;                                  \
-			return 0;                                              \
-		}                                                              \
-		cast_largest_utype relevant = cast_shift_zeros_right(src);     \
-		if (relevant > (1ULL << mantissa_bits) - 1ULL)                 \
-			return -1;                                             \
-		*dst = (dst_type)src;                                          \
-		return 0;                                                      \
-	}                                                                      \
-	CAST_DEFINE_FROM(dst_type, dst_type_name, src_type, src_type_name)
+CAST_COLD struct cast_stats_counter *cast_stats_attach(void);
 
 /**
- * Define a conversion function for floating point to unsigned conversions.
+ * Count conversion done by the calling thread.
  *
- * @param dst_type         Destination type.
- * @param dst_type_name    Destination type name.
- * @param src_type         Source type.
- * @param src_type_name    Source type name.
+ * Only the owning thread writes its counters, so they are incremented
+ * without atomic read-modify-write instructions.
+ *
+ * @param src    Source type.
+ * @param dst    Destination type.
+ * @param fail   Whether conversion failed.
  */
-#define CAST_DEFINE_TRY_U_FROM_F(dst_type, dst_type_name, src_type,            \
-				 src_type_name)                                \
-	static inline int try_##dst_type_name##_from_##src_type_name(          \
-	    dst_type *dst, src_type src)                                       \
-	{                                                                      \
-		if (!dst)                                                      \
-			return -1;                                             \
-		const double src_upper = CAST_UNSIGNED_UPPER_LIMIT(double,     \
-								   dst_type);  \
-		double trunced_src = trunc(src);                               \
-		if (trunced_src != src)                                        \
-			return -1;                                             \
-		if (trunced_src < 0.0 || src_upper <= trunced_src)             \
-			return -1;                                             \
-		*dst = (dst_type)trunced_src;                                  \
-		return 0;                                                      \
-	}                                                                      \
-	CAST_DEFINE_FROM(dst_type, dst_type_name, src_type, src_type_name)
+static inline void cast_stats_record(enum cast_type src, enum cast_type dst,
+				     bool fail)
+{
+	struct cast_stats_counter *counters = cast_stats_thread;
+	if (CAST_UNLIKELY(!counters))
+		counters = cast_stats_attach();
+	struct cast_stats_counter *counter =
+	    &counters[(size_t)src * CAST_TYPE_COUNT + (size_t)dst];
+	atomic_store_explicit(
+	    &counter->calls,
+	    atomic_load_explicit(&counter->calls, memory_order_relaxed) + 1U,
+	    memory_order_relaxed);
+	atomic_store_explicit(&counter->failures,
+			      atomic_load_explicit(&counter->failures,
+						   memory_order_relaxed) +
+				  (uint64_t)fail,
+			      memory_order_relaxed);
+}
+
+/* Instrumentation hooks, which can be toggled at runtime */
+enum cast_hook {
+	/* Counting conversions compiled with CAST_STATS_TOGGLE */
+	CAST_HOOK_STATS,
+	/* Tracing failures of conversions compiled with CAST_TRACE */
+	CAST_HOOK_TRACE,
+	CAST_HOOK_COUNT
+};
+
+#if !defined(CAST_NO_JUMP_LABELS) && defined(__x86_64__) &&                    \
+    defined(__linux__) && (defined(__GNUC__) || defined(__clang__))
+/* Hooks are NOPs patched into jumps, instead of loads of flags */
+#define CAST_JUMP_LABELS
+#endif
 
+/* Whether hooks are enabled, indexed by enum cast_hook */
+extern _Atomic bool cast_hook_flags[CAST_HOOK_COUNT];
+
+#if defined(CAST_JUMP_LABELS)
 /**
- * Define a conversion function for floating point to signed conversions.
+ * Define function returning whether hook is enabled.
  *
- * @param dst_type         Destination type.
- * @param dst_type_name    Destination type name.
- * @param src_type         Source type.
- * @param src_type_name    Source type name.
+ * Function is a 5 byte NOP, which cast_hook_enable() patches into a jump to
+ * its true branch. Every inlined copy records its address, address of the
+ * true branch and the hook in cast_jump_table section. NOP is padded only if
+ * it would cross an 8 byte boundary, so it can be patched with a single
+ * store and costs at most 4 bytes of padding.
+ *
+ * @param name   Suffix of defined function.
+ * @param hook   Value of enum cast_hook.
  */
-#define CAST_DEFINE_TRY_S_FROM_F(dst_type, dst_type_name, dst_min, src_type,   \
-				 src_type_name)                                \
-	static inline int try_##dst_type_name##_from_##src_type_name(          \
-	    dst_type *dst, src_type src)                                       \
+#define CAST_DEFINE_HOOK(name, hook)                                           \
+	__attribute__((always_inline)) static inline bool                      \
+	    cast_hook_##name##_on(void)                                        \
 	{                                                                      \
-		if (!dst)                                                      \
-			return -1;                                             \
-		const double src_upper = CAST_SIGNED_UPPER_LIMIT(double,       \
-								 dst_min);     \
-		const double src_min = (double)(dst_min);                      \
-		double trunced_src = trunc(src);                               \
-		if (trunced_src != src)                                        \
-			return -1;                                             \
-		if (trunced_src < src_min || src_upper <= trunced_src)         \
-			return -1;                                             \
-		*dst = (dst_type)trunced_src;                                  \
-		return 0;                                                      \
-	}                                                                      \
-	CAST_DEFINE_FROM(dst_type, dst_type_name, src_type, src_type_name)
+		__asm__ goto(".p2align 3,,4\n\t"                               \
+			     "1: .byte 0x0f, 0x1f, 0x44, 0x00, 0x00\n\t"       \
+			     ".pushsection cast_jump_table, \"aw\"\n\t"        \
+			     ".balign 8\n\t"                                   \
+			     ".quad 1b, %l[on], %c0\n\t"                       \
+			     ".popsection"                                     \
+			     :                                                 \
+			     : "i"(hook)                                       \
+			     :                                                 \
+			     : on);                                            \
+		return false;                                                  \
+	on:                                                                    \
+		return true;                                                   \
+	}
+#else
+/**
+ * Define function returning whether hook is enabled.
+ *
+ * @param name   Suffix of defined function.
+ * @param hook   Value of enum cast_hook.
+ */
+#define CAST_DEFINE_HOOK(name, hook)                                           \
+	static inline bool cast_hook_##name##_on(void)                         \
+	{                                                                      \
+		return CAST_UNLIKELY(atomic_load_explicit(                     \
+		    &cast_hook_flags[hook], memory_order_relaxed));            \
+	}
+#endif
+
+CAST_DEFINE_HOOK(stats, CAST_HOOK_STATS)
+CAST_DEFINE_HOOK(trace, CAST_HOOK_TRACE)
 
 /**
- * Define a family of functions for conversions to unsigned type.
+ * Enable or disable hook in all threads.
  *
- * @param dst_type         Destination type.
- * @param dst_type_name    Destination type name.
- * @param dst_type_max     Maximum value that can fit desintation type.
+ * @param hook     Hook to toggle.
+ * @param enable   Whether to enable it.
+ *
+ * @return 0 on success, -1 if hook is invalid or code could not be patched,
+ *         then the hook is left unchanged.
  */
-#define CAST_DEFINE_TRY_U(dst_type, dst_type_name, dst_type_max)               \
-	/* From signed */                                                      \
-	CAST_DEFINE_TRY_U_FROM_S(dst_type, dst_type_name, dst_type_max,        \
-				 signed char, schar)                           \
-	CAST_DEFINE_TRY_U_FROM_S(dst_type, dst_type_name, dst_type_max,        \
-				 int8_t, i8)                                   \
-	CAST_DEFINE_TRY_U_FROM_S(dst_type, dst_type_name, dst_type_max,        \
-				 int16_t, i16)                                 \
-	CAST_DEFINE_TRY_U_FROM_S(dst_type, dst_type_name, dst_type_max,        \
-				 int32_t, i32)                                 \
-	CAST_DEFINE_TRY_U_FROM_S(dst_type, dst_type_name, dst_type_max,        \
-				 int64_t, i64)                                 \
-	CAST_DEFINE_TRY_U_FROM_S(dst_type, dst_type_name, dst_type_max, int,   \
-				 int)                                          \
-	CAST_DEFINE_TRY_U_FROM_S(dst_type, dst_type_name, dst_type_max, short, \
-				 short)                                        \
-	CAST_DEFINE_TRY_U_FROM_S(dst_type, dst_type_name, dst_type_max, long,  \
-				 long)                                         \
-	CAST_DEFINE_TRY_U_FROM_S(dst_type, dst_type_name, dst_type_max,        \
-				 long long, llong)                             \
-	CAST_DEFINE_TRY_U_FROM_S(dst_type, dst_type_name, dst_type_max,        \
-				 ptrdiff_t, ptrdiff)                           \
-	/* From unsigned */                                                    \
-	CAST_DEFINE_TRY_U_FROM_U(dst_type, dst_type_name, dst_type_max,        \
-				 unsigned char, uchar)                         \
-	CAST_DEFINE_TRY_U_FROM_U(dst_type, dst_type_name, dst_type_max,        \
-				 uint8_t, u8)                                  \
-	CAST_DEFINE_TRY_U_FROM_U(dst_type, dst_type_name, dst_type_max,        \
-				 uint16_t, u16)                                \
-	CAST_DEFINE_TRY_U_FROM_U(dst_type, dst_type_name, dst_type_max,        \
-				 uint32_t, u32)                                \
-	CAST_DEFINE_TRY_U_FROM_U(dst_type, dst_type_name, dst_type_max,        \
-				 uint64_t, u64)                                \
-	CAST_DEFINE_TRY_U_FROM_U(dst_type, dst_type_name, dst_type_max,        \
-				 unsigned, uint)                               \
-	CAST_DEFINE_TRY_U_FROM_U(dst_type, dst_type_name, dst_type_max,        \
-				 unsigned short, ushort)                       \
-	CAST_DEFINE_TRY_U_FROM_U(dst_type, dst_type_name, dst_type_max,        \
-				 unsigned long, ulong)                         \
-	CAST_DEFINE_TRY_U_FROM_U(dst_type, dst_type_name, dst_type_max,        \
-				 unsigned long long, ullong)                   \
-	CAST_DEFINE_TRY_U_FROM_U(dst_type, dst_type_name, dst_type_max,        \
-				 size_t, size)                                 \
-	CAST_DEFINE_TRY_U_FROM_U(dst_type, dst_type_name, dst_type_max,        \
-				 uintptr_t, uptr)                              \
-	/* From floating point */                                              \
-	CAST_DEFINE_TRY_U_FROM_F(dst_type, dst_type_name, float, float)        \
-	CAST_DEFINE_TRY_U_FROM_F(dst_type, dst_type_name, double, double)      \
-	/* From str */                                                         \
-	CAST_DEFINE_TRY_U_FROM_STR(dst_type, dst_type_name)                    \
-	/* END */
+int cast_hook_enable(enum cast_hook hook, bool enable);
 
 /**
- * Define a family of functions for conversions to signed type.
+ * Return whether hook is enabled.
  *
- * @param dst_type         Destination type.
- * @param dst_type_name    Destination type name.
- * @param dst_type_max     Maximum value that can fit desintation type.
+ * @param hook   Hook to check.
+ *
+ * @return True if hook is enabled.
  */
-#define CAST_DEFINE_TRY_S(dst_type, dst_type_name, dst_type_max)               \
-	/* From signed */                                                      \
-	CAST_DEFINE_TRY_S_FROM_S(dst_type, dst_type_name, dst_type_max##_MIN,  \
-				 dst_type_max##_MAX, signed char, schar)       \
-	CAST_DEFINE_TRY_S_FROM_S(dst_type, dst_type_name, dst_type_max##_MIN,  \
-				 dst_type_max##_MAX, int8_t, i8)               \
-	CAST_DEFINE_TRY_S_FROM_S(dst_type, dst_type_name, dst_type_max##_MIN,  \
-				 dst_type_max##_MAX, int16_t, i16)             \
-	CAST_DEFINE_TRY_S_FROM_S(dst_type, dst_type_name, dst_type_max##_MIN,  \
-				 dst_type_max##_MAX, int32_t, i32)             \
-	CAST_DEFINE_TRY_S_FROM_S(dst_type, dst_type_name, dst_type_max##_MIN,  \
-				 dst_type_max##_MAX, int64_t, i64)             \
-	CAST_DEFINE_TRY_S_FROM_S(dst_type, dst_type_name, dst_type_max##_MIN,  \
-				 dst_type_max##_MAX, int, int)                 \
-	CAST_DEFINE_TRY_S_FROM_S(dst_type, dst_type_name, dst_type_max##_MIN,  \
-				 dst_type_max##_MAX, short, short)             \
-	CAST_DEFINE_TRY_S_FROM_S(dst_type, dst_type_name, dst_type_max##_MIN,  \
-				 dst_type_max##_MAX, long, long)               \
-	CAST_DEFINE_TRY_S_FROM_S(dst_type, dst_type_name, dst_type_max##_MIN,  \
-				 dst_type_max##_MAX, long long, llong)         \
-	CAST_DEFINE_TRY_S_FROM_S(dst_type, dst_type_name, dst_type_max##_MIN,  \
-				 dst_type_max##_MAX, ptrdiff_t, ptrdiff)       \
-	/* From unsigned */                                                    \
-	CAST_DEFINE_TRY_S_FROM_U(dst_type, dst_type_name, dst_type_max##_MAX,  \
-				 unsigned char, uchar)                         \
-	CAST_DEFINE_TRY_S_FROM_U(dst_type, dst_type_name, dst_type_max##_MAX,  \
-				 uint8_t, u8)                                  \
-	CAST_DEFINE_TRY_S_FROM_U(dst_type, dst_type_name, dst_type_max##_MAX,  \
-				 uint16_t, u16)                                \
-	CAST_DEFINE_TRY_S_FROM_U(dst_type, dst_type_name, dst_type_max##_MAX,  \
-				 uint32_t, u32)                                \
-	CAST_DEFINE_TRY_S_FROM_U(dst_type, dst_type_name, dst_type_max##_MAX,  \
-				 uint64_t, u64)                                \
-	CAST_DEFINE_TRY_S_FROM_U(dst_type, dst_type_name, dst_type_max##_MAX,  \
-				 unsigned, uint)                               \
-	CAST_DEFINE_TRY_S_FROM_U(dst_type, dst_type_name, dst_type_max##_MAX,  \
-				 unsigned short, ushort)                       \
-	CAST_DEFINE_TRY_S_FROM_U(dst_type, dst_type_name, dst_type_max##_MAX,  \
-				 unsigned long, ulong)                         \
-	CAST_DEFINE_TRY_S_FROM_U(dst_type, dst_type_name, dst_type_max##_MAX,  \
-				 unsigned long long, ullong)                   \
-	CAST_DEFINE_TRY_S_FROM_U(dst_type, dst_type_name, dst_type_max##_MAX,  \
-				 size_t, size)                                 \
-	CAST_DEFINE_TRY_S_FROM_U(dst_type, dst_type_name, dst_type_max##_MAX,  \
-				 uintptr_t, uptr)                              \
-	/* From floating point */                                              \
-	CAST_DEFINE_TRY_S_FROM_F(dst_type, dst_type_name, dst_type_max##_MIN,  \
-				 float, float)                                 \
-	CAST_DEFINE_TRY_S_FROM_F(dst_type, dst_type_name, dst_type_max##_MIN,  \
-				 double, double)                               \
-	/* From str */                                                         \
-	CAST_DEFINE_TRY_S_FROM_STR(dst_type, dst_type_name)                    \
-	/* END */
+bool cast_hook_enabled(enum cast_hook hook);
 
 /**
- * Define a family of functions for conversions to floating point type.
+ * Toggle hook whenever the process receives signal, such as SIGUSR1.
  *
- * @param dst_type         Destination type.
- * @param dst_type_name    Destination type name.
- * @param mantissa_bits    Number of mantissa bits.
+ * Patching code is not async-signal-safe, so where hooks are jump labels the
+ * handler only counts the signal and wakes up a watcher thread, which
+ * toggles the hook shortly after. Where hooks are flags, the handler toggles
+ * the flag itself.
+ *
+ * @param hook     Hook to toggle.
+ * @param signum   Signal number.
+ *
+ * @return 0 on success, -1 if handler or watcher thread could not be set up,
+ *         or the platform has no sigaction().
  */
-#define CAST_DEFINE_TRY_F(dst_type, dst_type_name, mantissa_bits)              \
-	/* From signed */                                                      \
-	CAST_DEFINE_TRY_F_FROM_S(dst_type, dst_type_name, mantissa_bits,       \
-				 signed char, schar, SCHAR_MIN)                \
-	CAST_DEFINE_TRY_F_FROM_S(dst_type, dst_type_name, mantissa_bits,       \
-				 int8_t, i8, INT8_MIN)                         \
-	CAST_DEFINE_TRY_F_FROM_S(dst_type, dst_type_name, mantissa_bits,       \
+int cast_hook_toggle_on_signal(enum cast_hook hook, int signum);
+
+#if defined(CAST_STATS)
+#define CAST_STATS_RECORD(src, dst, fail) cast_stats_record(src, dst, fail)
+#elif defined(CAST_STATS_TOGGLE)
+#define CAST_STATS_RECORD(src, dst, fail)                                      \
+	do {                                                                   \
+		if (CAST_UNLIKELY(cast_hook_stats_on()))                       \
+			cast_stats_record(src, dst, fail);                     \
+	} while (0)
+#else
+#define CAST_STATS_RECORD(src, dst, fail) ((void)0)
+#endif
+
+/* Number of failures remembered by each thread, power of two */
+#ifndef CAST_TRACE_SIZE
+#define CAST_TRACE_SIZE 64U
+#endif
+
+/**
+ * Record failed conversion of the calling thread.
+ *
+ * It fires cast:failure USDT probe and appends failure to the flight
+ * recorder of the thread, which overwrites the oldest failures.
+ *
+ * @param pair    Source and destination types packed by CAST_TYPE_PAIR().
+ * @param value   Bits of source value returned by cast_value_bits().
+ */
+CAST_COLD void cast_trace_failure(unsigned pair, uint64_t value);
+
+/**
+ * Write failures remembered by flight recorders of all threads, including
+ * types, source value and address of code, which called the conversion.
+ *
+ * @param file   Where to write.
+ *
+ * @return 0 on success, -1 on write error.
+ */
+int cast_trace_dump(FILE *file);
+
+#if defined(CAST_TRACE)
+#define CAST_TRACE_FAILURE(src, dst, value, fail)                              \
+	do {                                                                   \
+		if (CAST_UNLIKELY(cast_hook_trace_on()) && (fail))             \
+			cast_trace_failure(CAST_TYPE_PAIR(src, dst),           \
+					   cast_value_bits(&(value),           \
+							   sizeof(value)));    \
+	} while (0)
+#else
+#define CAST_TRACE_FAILURE(src, dst, value, fail) ((void)0)
+#endif
+
+#if !defined(CAST_NO_PROFILE_SITES) && defined(__x86_64__) &&                  \
+    defined(__linux__) && (defined(__GNUC__) || defined(__clang__))
+/* Call sites can be registered in cast_profile_sites section */
+#define CAST_PROFILE_SITES
+#endif
+
+/* Observed results of conversions at one call site */
+struct cast_profile_site {
+	/* Address of code of the site */
+	uint64_t address;
+	/* Source and destination types packed by CAST_TYPE_PAIR() */
+	uint64_t pair;
+	/* Number of successful conversions */
+	_Atomic uint64_t count;
+	/* Smallest and largest result, signed ones with flipped sign bit, so
+	 * they are ordered as unsigned integers */
+	_Atomic uint64_t min;
+	_Atomic uint64_t max;
+};
+
+/**
+ * Return key of result, which orders results of destination type as
+ * unsigned integers.
+ *
+ * @param dst     Destination type.
+ * @param value   Result of conversion.
+ */
+#define CAST_PROFILE_KEY(dst, value)                                           \
+	((dst) >= CAST_TYPE_i8                                                 \
+	     ? (uint64_t)(int64_t)(value) ^ (UINT64_C(1) << 63)                \
+	     : (uint64_t)(value))
+
+#if defined(CAST_PROFILE_SITES)
+/**
+ * Store pointer to record of the call site in site.
+ *
+ * Record is emitted into cast_profile_sites section, so every inlined copy
+ * of a conversion gets its own one, without any registration at runtime.
+ *
+ * @param site   Where to store pointer to struct cast_profile_site.
+ * @param pair   Constant source and destination types packed by
+ *               CAST_TYPE_PAIR().
+ */
+#define CAST_PROFILE_SITE(site, pair)                                          \
+	__asm__ __volatile__(                                                  \
+	    "2: lea 3f(%%rip), %0\n\t"                                         \
+	    ".pushsection cast_profile_sites, \"aw\"\n\t"                      \
+	    ".balign 8\n\t"                                                    \
+	    "3: .quad 2b, %c1, 0, -1, 0\n\t"                                   \
+	    ".popsection"                                                      \
+	    : "=r"(site)                                                       \
+	    : "i"(pair))
+#elif defined(CAST_PROFILE)
+#error "CAST_PROFILE needs x86-64 Linux and GCC or clang"
+#endif
+
+/**
+ * Record result of conversion at call site.
+ *
+ * @param site   Record of the call site.
+ * @param key    Result returned by CAST_PROFILE_KEY().
+ */
+static inline void cast_profile_record(struct cast_profile_site *site,
+				       uint64_t key)
+{
+	atomic_fetch_add_explicit(&site->count, 1U, memory_order_relaxed);
+	uint64_t min = atomic_load_explicit(&site->min, memory_order_relaxed);
+	while (key < min && !atomic_compare_exchange_weak_explicit(
+				&site->min, &min, key, memory_order_relaxed,
+				memory_order_relaxed))
+		;
+	uint64_t max = atomic_load_explicit(&site->max, memory_order_relaxed);
+	while (key > max && !atomic_compare_exchange_weak_explicit(
+				&site->max, &max, key, memory_order_relaxed,
+				memory_order_relaxed))
+		;
+}
+
+/**
+ * Write JSON report of call sites, whose results would fit a narrower type.
+ *
+ * With CAST_PROFILE it is written at exit to file named by CAST_PROFILE_OUTPUT
+ * environment variable, or to cast-profile.json.
+ *
+ * @param file   Where to write.
+ *
+ * @return 0 on success, -1 on write error.
+ */
+int cast_profile_dump(FILE *file);
+
+/**
+ * Write report of call sites to file at exit, see cast_profile_dump().
+ *
+ * It is called by every translation unit compiled with CAST_PROFILE.
+ */
+void cast_profile_report_at_exit(void);
+
+#if defined(CAST_PROFILE)
+__attribute__((constructor)) static void cast_profile_register(void)
+{
+	cast_profile_report_at_exit();
+}
+
+/* Record integer results of successful conversions */
+#define CAST_PROFILE_RECORD(src, dst, value, ok)                               \
+	do {                                                                   \
+		if ((dst) < CAST_TYPE_float && (ok)) {                         \
+			struct cast_profile_site *cast_site;                   \
+			CAST_PROFILE_SITE(cast_site,                           \
+					  CAST_TYPE_PAIR(src, dst));           \
+			cast_profile_record(cast_site,                         \
+					    CAST_PROFILE_KEY(dst, value));     \
+		}                                                              \
+	} while (0)
+#else
+#define CAST_PROFILE_RECORD(src, dst, value, ok) ((void)0)
+#endif
+
+/*
+ * Return whether conversions have to be recorded. Instrumented conversions
+ * check it before converting, so a disabled hook leaves the uninstrumented
+ * conversion in hot code and only adds its NOP.
+ */
+#if defined(CAST_STATS) || defined(CAST_PROFILE)
+#define CAST_INSTRUMENTED() true
+#elif defined(CAST_STATS_TOGGLE) && defined(CAST_TRACE)
+#define CAST_INSTRUMENTED() (cast_hook_stats_on() || cast_hook_trace_on())
+#elif defined(CAST_STATS_TOGGLE)
+#define CAST_INSTRUMENTED() cast_hook_stats_on()
+#elif defined(CAST_TRACE)
+#define CAST_INSTRUMENTED() cast_hook_trace_on()
+#else
+#define CAST_INSTRUMENTED() false
+#endif
+
+/**
+ * Sum counters of one conversion over all threads.
+ *
+ * @param src        Source type.
+ * @param dst        Destination type.
+ * @param failures   Where to store number of failures, may be NULL.
+ *
+ * @return Number of calls.
+ */
+uint64_t cast_stats_get(enum cast_type src, enum cast_type dst,
+			uint64_t *failures);
+
+/**
+ * Write counters of conversions, which were called at least once, in
+ * OpenMetrics text format.
+ *
+ * @param file   Where to write.
+ *
+ * @return 0 on success, -1 on write error.
+ */
+int cast_stats_dump(FILE *file);
+
+/* Sticky error state of a batch of conversions */
+struct cast_ctx {
+	/* Number of conversions done with this context */
+	size_t count;
+	/* Index of the first failed conversion */
+	size_t first_index;
+	/* Name of the first failed conversion, such as "i64 to i32" */
+	const char *first_name;
+	/* Source file and line of the first failed conversion, or NULL and 0 */
+	const char *first_file;
+	int first_line;
+	/* Whether any conversion failed */
+	bool failed;
+};
+
+/* Initializer of struct cast_ctx without failures */
+#define CAST_CTX_INIT {0U, 0U, NULL, NULL, 0, false}
+
+/**
+ * Call `{conversion}_ctx()` with source file and line of the call, which are
+ * recorded in `ctx`, if it is the first failed conversion.
+ *
+ * @param ctx          Context of conversions.
+ * @param conversion   Name of conversion, such as i32_from_i64.
+ */
+#define CAST_CTX(ctx, conversion, ...)                                         \
+	conversion##_ctx(ctx, __FILE__, __LINE__, __VA_ARGS__)
+
+/**
+ * Record result of a conversion. Only the first failure branches to record
+ * its index and site, so the branch is never taken in batches without
+ * failures.
+ *
+ * @param ctx    Context of conversions.
+ * @param fail   Whether conversion failed.
+ * @param name   Name of conversion.
+ * @param file   Source file of conversion, or NULL.
+ * @param line   Source line of conversion, or 0.
+ */
+static inline void cast_ctx_record(struct cast_ctx *ctx, bool fail,
+				   const char *name, const char *file, int line)
+{
+	if (fail && !ctx->failed) {
+		ctx->first_index = ctx->count;
+		ctx->first_name = name;
+		ctx->first_file = file;
+		ctx->first_line = line;
+	}
+	ctx->failed = ctx->failed || fail;
+	++ctx->count;
+}
+
+/**
+ * Check if any conversion done with context failed.
+ *
+ * @param ctx   Context of conversions.
+ *
+ * @return 0 if all conversions succeeded, -1 otherwise.
+ */
+static inline int cast_ctx_check(const struct cast_ctx *ctx)
+{
+	return ctx->failed ? -1 : 0;
+}
+
+/**
+ * Shift all least significant zeros right.
+ *
+ * @param value    Value for which zeros are to be removed.
+ *
+ * @return value with all least significant zeros shifted away.
+ */
+static inline cast_largest_utype
+cast_shift_zeros_right(cast_largest_utype value)
+{
+#if defined(__GNU_C__) || defined(__clang__)
+	return value > 0U ? value >> (size_t)__builtin_ctzll(value) : 0U;
+#else
+	if ((value & 0xFFFFFFFFU) == 0U)
+		value >>= 32U;
+	if ((value & 0xFFFFU) == 0U)
+		value >>= 16U;
+	if ((value & 0xFFU) == 0U)
+		value >>= 8U;
+	if ((value & 0xFU) == 0U)
+		value >>= 4U;
+	if ((value & 0x3U) == 0U)
+		value >>= 2U;
+	if ((value & 0x1U) == 0U)
+		value >>= 1U;
+
+	return value;
+#endif
+}
+
+/**
+ * This is wrapper for strtoull(), but with easier error handling.
+ * 
+ * @param dst   Pointer to variable, where conversion result will be stored.
+ * @param str   NULL-terminated string to convert to unsigned long long.
+ *
+ * @return 0 on success, non-zero on failure.
+ */
+int cast_try_ullong_from_str(unsigned long long *dst, const char *str);
+
+/**
+ * This is wrapper for strtoll(), but with easier error handling.
+ *
+ * @param dst   Pointer to variable, where conversion result will be stored.
+ * @param str   NULL-terminated string to convert to long long.
+ *
+ * @return 0 on success, non-zero on failure.
+ */
+int cast_try_llong_from_str(long long *dst, const char *str);
+
+/**
+ * This is wrapper for strtof(), but with easier error handling.
+ *
+ * Plain decimal numbers are parsed without strtof(), with the same result.
+ *
+ * @param dst   Pointer to variable, where conversion result will be stored.
+ * @param str   NULL-terminated string to convert to float.
+ *
+ * @return 0 on success, non-zero on failure.
+ */
+int cast_try_float_from_str(float *dst, const char *str);
+
+/**
+ * This is wrapper for strtod(), but with easier error handling.
+ *
+ * Plain decimal numbers are parsed without strtod(), with the same result.
+ *
+ * @param dst   Pointer to variable, where conversion result will be stored.
+ * @param str   NULL-terminated string to convert to double.
+ *
+ * @return 0 on success, non-zero on failure.
+ */
+int cast_try_double_from_str(double *dst, const char *str);
+
+/**
+ * Parse decimal number rounded to nearest float.
+ *
+ * Accepts an optional sign, digits with an optional decimal point and an
+ * optional exponent. Values which overflow or are too small to be stored as
+ * normal floats are errors, as they are for strtof().
+ *
+ * @param dst   Pointer to variable, where conversion result will be stored.
+ * @param ptr   Characters to parse, they don't have to be NULL-terminated.
+ * @param len   Number of characters to parse.
+ *
+ * @return 0 on success, non-zero on failure.
+ */
+int cast_try_float_from_strn(float *dst, const char *ptr, size_t len);
+
+/**
+ * Parse decimal number rounded to nearest double.
+ *
+ * Same as cast_try_float_from_strn(), but for double.
+ *
+ * @param dst   Pointer to variable, where conversion result will be stored.
+ * @param ptr   Characters to parse, they don't have to be NULL-terminated.
+ * @param len   Number of characters to parse.
+ *
+ * @return 0 on success, non-zero on failure.
+ */
+int cast_try_double_from_strn(double *dst, const char *ptr, size_t len);
+
+/* Size of buffer, which fits any float or double formatted with its sign */
+#define CAST_FMT_FLOAT_SIZE 24U
+
+/**
+ * Format float as the shortest decimal number, which is parsed back to the
+ * same value.
+ *
+ * Numbers with decimal exponent from -4 to 15 are written in fixed notation,
+ * such as "0.001" or "12.5", and other numbers in scientific notation, such
+ * as "1e-5" or "1.5e300", as by repr() in Python, but without plus sign and
+ * leading zeros in exponent. Special values are written as "inf", "-inf" and
+ * "nan".
+ *
+ * @param buf     Where to write characters, no NULL character is written.
+ * @param cap     Size of buffer.
+ * @param value   Value to format.
+ *
+ * @return Number of characters or 0 if they don't fit the buffer, in which
+ *         case nothing is written.
+ */
+size_t cast_fmt_float(char *buf, size_t cap, float value);
+
+/**
+ * Format double as the shortest decimal number, which is parsed back to the
+ * same value.
+ *
+ * Same as cast_fmt_float(), but for double.
+ *
+ * @param buf     Where to write characters, no NULL character is written.
+ * @param cap     Size of buffer.
+ * @param value   Value to format.
+ *
+ * @return Number of characters or 0 if they don't fit the buffer, in which
+ *         case nothing is written.
+ */
+size_t cast_fmt_double(char *buf, size_t cap, double value);
+
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+/* Eight digits can be converted at once after loading them into uint64_t */
+#define CAST_SWAR_DIGITS
+#endif
+
+/**
+ * Check if 8 characters loaded into little endian integer are decimal digits.
+ *
+ * @param chunk    Characters loaded from memory.
+ *
+ * @return true if every character is a digit.
+ */
+static inline bool cast_swar_is_digits(uint64_t chunk)
+{
+	/* High nibble of each byte must be 3, also after adding 6 to it */
+	return ((chunk & 0xF0F0F0F0F0F0F0F0U) |
+		(((chunk + 0x0606060606060606U) & 0xF0F0F0F0F0F0F0F0U) >> 4)) ==
+	       0x3333333333333333U;
+}
+
+/**
+ * Convert 8 decimal digits loaded into little endian integer to their value.
+ *
+ * @param chunk    Characters loaded from memory, all of them must be digits.
+ *
+ * @return Value of the digits.
+ */
+static inline uint32_t cast_swar_parse_digits(uint64_t chunk)
+{
+	chunk -= 0x3030303030303030U;
+	chunk = (chunk * 10U + (chunk >> 8)) & 0x00FF00FF00FF00FFU;
+	chunk = (chunk * 100U + (chunk >> 16)) & 0x0000FFFF0000FFFFU;
+	chunk = (chunk * 10000U + (chunk >> 32)) & 0x00000000FFFFFFFFU;
+	return (uint32_t)chunk;
+}
+
+/**
+ * Parse string of decimal digits without sign.
+ *
+ * @param dst   Pointer to variable, where parsed value will be stored.
+ * @param ptr   Characters to parse, they don't have to be NULL-terminated.
+ * @param len   Number of characters to parse.
+ *
+ * @return 0 on success, non-zero if there are no characters, any of them is
+ *         not a digit or the value does not fit uint64_t.
+ */
+static inline int cast_parse_decimal(uint64_t *dst, const char *ptr,
+				     size_t len)
+{
+	if (len == 0U)
+		return -1;
+
+	/* Leading zeros don't change the value nor limit the length */
+	while (len > 1U && *ptr == '0') {
+		++ptr;
+		--len;
+	}
+
+	/* UINT64_MAX has 20 digits, only the 20th digit can overflow */
+	if (len > 20U)
+		return -1;
+	size_t safe = len == 20U ? 19U : len;
+
+	uint64_t val = 0U;
+	size_t i = 0U;
+#if defined(CAST_SWAR_DIGITS)
+	for (; safe - i >= 8U; i += 8U) {
+		uint64_t chunk;
+		memcpy(&chunk, ptr + i, sizeof(chunk));
+		if (!cast_swar_is_digits(chunk))
+			return -1;
+		val = val * 100000000U + cast_swar_parse_digits(chunk);
+	}
+#endif
+	for (; i < len; ++i) {
+		unsigned digit = (unsigned)(unsigned char)ptr[i] - (unsigned)'0';
+		if (digit > 9U)
+			return -1;
+		if (i >= safe && val > (UINT64_MAX - digit) / 10U)
+			return -1;
+		val = val * 10U + digit;
+	}
+
+	*dst = val;
+	return 0;
+}
+
+/**
+ * Parse decimal unsigned integer with optional plus sign.
+ *
+ * @param dst   Pointer to variable, where parsed value will be stored.
+ * @param ptr   Characters to parse, they don't have to be NULL-terminated.
+ * @param len   Number of characters to parse.
+ *
+ * @return 0 on success, non-zero on failure.
+ */
+static inline int cast_try_u64_from_strn(uint64_t *dst, const char *ptr,
+					 size_t len)
+{
+	if (dst == NULL || ptr == NULL)
+		return -1;
+	if (len > 0U && *ptr == '+') {
+		++ptr;
+		--len;
+	}
+	return cast_parse_decimal(dst, ptr, len);
+}
+
+/**
+ * Parse decimal signed integer with optional sign.
+ *
+ * @param dst   Pointer to variable, where parsed value will be stored.
+ * @param ptr   Characters to parse, they don't have to be NULL-terminated.
+ * @param len   Number of characters to parse.
+ *
+ * @return 0 on success, non-zero on failure.
+ */
+static inline int cast_try_i64_from_strn(int64_t *dst, const char *ptr,
+					 size_t len)
+{
+	if (dst == NULL || ptr == NULL)
+		return -1;
+
+	bool negative = false;
+	if (len > 0U && (*ptr == '+' || *ptr == '-')) {
+		negative = *ptr == '-';
+		++ptr;
+		--len;
+	}
+
+	uint64_t magnitude = 0U;
+	if (cast_parse_decimal(&magnitude, ptr, len))
+		return -1;
+
+	if (negative) {
+		if (magnitude > (uint64_t)INT64_MAX + 1U)
+			return -1;
+		*dst = magnitude == 0U ? 0 : -(int64_t)(magnitude - 1U) - 1;
+		return 0;
+	}
+	if (magnitude > (uint64_t)INT64_MAX)
+		return -1;
+	*dst = (int64_t)magnitude;
+	return 0;
+}
+
+/* Count leading zero bits of nonzero integer */
+static inline int cast_clz_64(uint64_t x)
+{
+#if defined(__GNUC__) || defined(__clang__)
+	return __builtin_clzll(x);
+#else
+	int n = 0;
+	while (!(x & 0x8000000000000000U)) {
+		x <<= 1;
+		++n;
+	}
+	return n;
+#endif
+}
+
+/* Size of buffer, which fits any integer formatted with its sign */
+#define CAST_FMT_INT_SIZE 21U
+
+/* Pairs of digits of numbers from 00 to 99 */
+static const char cast_digit_pairs[201] =
+    "00010203040506070809"
+    "10111213141516171819"
+    "20212223242526272829"
+    "30313233343536373839"
+    "40414243444546474849"
+    "50515253545556575859"
+    "60616263646566676869"
+    "70717273747576777879"
+    "80818283848586878889"
+    "90919293949596979899";
+
+/**
+ * Count decimal digits of an integer.
+ *
+ * @param val   Integer value.
+ *
+ * @return Number of digits, 1 for 0.
+ */
+static inline size_t cast_count_digits(uint64_t val)
+{
+	static const uint64_t powers[20] = {
+	    0U,
+	    10U,
+	    100U,
+	    1000U,
+	    10000U,
+	    100000U,
+	    1000000U,
+	    10000000U,
+	    100000000U,
+	    1000000000U,
+	    10000000000U,
+	    100000000000U,
+	    1000000000000U,
+	    10000000000000U,
+	    100000000000000U,
+	    1000000000000000U,
+	    10000000000000000U,
+	    100000000000000000U,
+	    1000000000000000000U,
+	    10000000000000000000U,
+	};
+	/* 1233 / 4096 is slightly more than log10(2) */
+	size_t bits = 64U - (size_t)cast_clz_64(val | 1U);
+	size_t guess = (bits * 1233U) >> 12;
+	return guess + 1U - (val < powers[guess]);
+}
+
+/**
+ * Write digits of an integer, which end just before `end`, two at a time.
+ *
+ * @param end   End of digits.
+ * @param val   Integer value.
+ */
+static inline void cast_fmt_digits(char *end, uint64_t val)
+{
+	/* Split off eight digits at a time to use 32-bit divisions for them */
+	while (val > UINT32_MAX) {
+		uint64_t high = val / 100000000U;
+		uint32_t low = (uint32_t)(val - high * 100000000U);
+		for (int i = 0; i < 4; ++i) {
+			end -= 2;
+			memcpy(end, &cast_digit_pairs[(low % 100U) * 2U], 2U);
+			low /= 100U;
+		}
+		val = high;
+	}
+
+	uint32_t small = (uint32_t)val;
+	while (small >= 100U) {
+		end -= 2;
+		memcpy(end, &cast_digit_pairs[(small % 100U) * 2U], 2U);
+		small /= 100U;
+	}
+	if (small >= 10U) {
+		end -= 2;
+		memcpy(end, &cast_digit_pairs[small * 2U], 2U);
+	} else {
+		*--end = (char)('0' + small);
+	}
+}
+
+/**
+ * Format integer given as sign and magnitude in decimal.
+ *
+ * @param buf        Where to write characters.
+ * @param cap        Size of buffer.
+ * @param negative   Whether to write minus sign.
+ * @param val        Magnitude of integer.
+ *
+ * @return Number of characters or 0 if they don't fit the buffer, in which
+ *         case nothing is written.
+ */
+static inline size_t cast_fmt_decimal(char *buf, size_t cap, bool negative,
+				      uint64_t val)
+{
+	size_t len = cast_count_digits(val) + negative;
+	if (buf == NULL || cap < len)
+		return 0U;
+
+	if (negative)
+		buf[0] = '-';
+	cast_fmt_digits(buf + len, val);
+	return len;
+}
+
+/**
+ * Define a structure holding converted value and whether conversion
+ * succeeded, which is small enough to be returned in registers.
+ *
+ * @param dst_type         Destination type.
+ * @param dst_type_name    Destination type name.
+ */
+#define CAST_DEFINE_RESULT(dst_type, dst_type_name)                            \
+	struct cast_##dst_type_name##_result {                                 \
+		dst_type value;                                                \
+		bool ok;                                                       \
+	};
+
+/**
+ * Define try_{T}_from_{U}() conversion function, a wrapper conversion
+ * function, which will trigger panic handler if conversion can't be
+ * performed, and a conversion function returning converted value in
+ * a structure. try_{T}_from_{U}() calls cast_raw_{T}_from_{U}() defined by
+ * one of CAST_DEFINE_TRY_* macros and records the conversion, when
+ * instrumentation is compiled in. Other functions go through it, so each
+ * conversion is recorded once.
+ *
+ * @param dst_type         Destination type.
+ * @param dst_type_name    Destination type name.
+ * @param src_type         Source type.
+ * @param dst_type_name    Source type name.
+ */
+#define CAST_DEFINE_FROM(dst_type, dst_type_name, src_type, src_type_name)     \
+	static inline int try_##dst_type_name##_from_##src_type_name(          \
+	    dst_type *dst, src_type src)                                       \
+	{                                                                      \
+		if (CAST_UNLIKELY(CAST_INSTRUMENTED())) {                      \
+			int err =                                              \
+			    cast_raw_##dst_type_name##_from_##src_type_name(   \
+				dst, src);                                     \
+			CAST_STATS_RECORD(CAST_TYPE_##src_type_name,           \
+					  CAST_TYPE_##dst_type_name,           \
+					  err != 0);                           \
+			CAST_TRACE_FAILURE(CAST_TYPE_##src_type_name,          \
+					   CAST_TYPE_##dst_type_name, src,     \
+					   err != 0);                          \
+			CAST_PROFILE_RECORD(CAST_TYPE_##src_type_name,         \
+					    CAST_TYPE_##dst_type_name, *dst,   \
+					    err == 0);                         \
+			return err;                                            \
+		}                                                              \
+		return cast_raw_##dst_type_name##_from_##src_type_name(dst,    \
+								       src);   \
+	}                                                                      \
+	static inline dst_type dst_type_name##_from_##src_type_name(           \
+	    src_type src)                                                      \
+	{                                                                      \
+		dst_type tmp = 0;                                              \
+		int err = try_##dst_type_name##_from_##src_type_name(&tmp,     \
+								     src);     \
+		if (CAST_UNLIKELY(err))                                        \
+			CAST_PANIC_CONVERSION(                                 \
+			    CAST_TYPE_PAIR(CAST_TYPE_##src_type_name,          \
+					   CAST_TYPE_##dst_type_name),         \
+			    cast_value_bits(&src, sizeof(src)));               \
+		return tmp;                                                    \
+	}                                                                      \
+	static inline struct cast_##dst_type_name##_result                     \
+	    try_##dst_type_name##_from_##src_type_name##_result(src_type src)  \
+	{                                                                      \
+		dst_type value = 0;                                            \
+		bool ok =                                                      \
+		    try_##dst_type_name##_from_##src_type_name(&value, src) == \
+		    0;                                                         \
+		return (struct cast_##dst_type_name##_result){value, ok};      \
+	}
+
+/**
+ * Define a conversion function recording errors in a context, which
+ * returns 0 if conversion can't be performed.
+ *
+ * @param dst_type         Destination type.
+ * @param dst_type_name    Destination type name.
+ * @param src_type         Source type.
+ * @param dst_type_name    Source type name.
+ */
+#define CAST_DEFINE_CTX_FROM(dst_type, dst_type_name, src_type, src_type_name) \
+	static inline dst_type dst_type_name##_from_##src_type_name##_ctx(     \
+	    struct cast_ctx *ctx, const char *file, int line, src_type src)    \
+	{                                                                      \
+		dst_type value = 0;                                            \
+		bool fail =                                                    \
+		    try_##dst_type_name##_from_##src_type_name(&value, src) != \
+		    0;                                                         \
+		cast_ctx_record(ctx, fail,                                     \
+				#src_type_name " to " #dst_type_name, file,    \
+				line);                                         \
+		return value;                                                  \
+	}
+
+/**
+ * Define a conversion function between integer types recording errors in a
+ * context, which checks range without branches.
+ *
+ * @param dst_type         Destination type.
+ * @param dst_type_name    Destination type name.
+ * @param dst_min          Minimum value that fits destination type.
+ * @param dst_max          Maximum value that fits destination type.
+ * @param src_type         Source type.
+ * @param dst_type_name    Source type name.
+ */
+#define CAST_DEFINE_CTX_FROM_INT(dst_type, dst_type_name, dst_min, dst_max,    \
+				 src_type, src_type_name)                      \
+	static inline dst_type dst_type_name##_from_##src_type_name##_ctx(     \
+	    struct cast_ctx *ctx, const char *file, int line, src_type src)    \
+	{                                                                      \
+		/* Bitwise or evaluates both comparisons */                    \
+		bool fail = (src < 0 && src < dst_min) |                       \
+			    (src > 0 && (cast_largest_utype)src >              \
+					    (cast_largest_utype)dst_max);      \
+		CAST_STATS_RECORD(CAST_TYPE_##src_type_name,                   \
+				  CAST_TYPE_##dst_type_name, fail);            \
+		CAST_TRACE_FAILURE(CAST_TYPE_##src_type_name,                  \
+				   CAST_TYPE_##dst_type_name, src, fail);      \
+		dst_type value = fail ? 0 : (dst_type)src;                     \
+		CAST_PROFILE_RECORD(CAST_TYPE_##src_type_name,                 \
+				    CAST_TYPE_##dst_type_name, value, !fail);  \
+		cast_ctx_record(ctx, fail,                                     \
+				#src_type_name " to " #dst_type_name, file,    \
+				line);                                         \
+		return value;                                                  \
+	}
+
+/**
+ * Define a conversion function for signed to unsigned conversions.
+ *
+ * @param dst_type         Destination type.
+ * @param dst_type_name    Destination type name.
+ * @param dst_type_max     Maximum value that fits destination type.
+ * @param src_type         Source type.
+ * @param dst_type_name    Source type name.
+ */
+#define CAST_DEFINE_TRY_U_FROM_S(dst_type, dst_type_name, dst_max, src_type,   \
+				 src_type_name)                                \
+	static inline int cast_raw_##dst_type_name##_from_##src_type_name(     \
+	    dst_type *dst, src_type src)                                       \
+	{                                                                      \
+		if (CAST_UNLIKELY(dst == NULL || src < 0 ||                    \
+				  (cast_largest_utype)src >                    \
+				      (cast_largest_utype)dst_max)) {          \
+			return -1;                                             \
+		}                                                              \
+		*dst = (dst_type)src;                                          \
+		return 0;                                                      \
+	}                                                                      \
+	CAST_DEFINE_FROM(dst_type, dst_type_name, src_type, src_type_name)     \
+	CAST_DEFINE_CTX_FROM_INT(dst_type, dst_type_name, 0, dst_max,          \
+				 src_type, src_type_name)
+
+/**
+ * Define a conversion function for unsigned to unsigned conversions.
+ *
+ * @param dst_type         Destination type.
+ * @param dst_type_name    Destination type name.
+ * @param dst_type_max     Maximum value that fits destination type.
+ * @param src_type         Source type.
+ * @param dst_type_name    Source type name.
+ */
+#define CAST_DEFINE_TRY_U_FROM_U(...) CAST_DEFINE_TRY_U_FROM_S(__VA_ARGS__)
+
+/**
+ * Define a conversion function for signed to unsigned conversions.
+ *
+ * @param dst_type         Destination type.
+ * @param dst_type_name    Destination type name.
+ * @param dst_type_max     Maximum value that fits destination type.
+ * @param src_type         Source type.
+ * @param dst_type_name    Source type name.
+ */
+#define CAST_DEFINE_TRY_S_FROM_U(...) CAST_DEFINE_TRY_U_FROM_S(__VA_ARGS__)
+
+/**
+ * Define a conversion function for signed to signed conversions.
+ *
+ * @param dst_type         Destination type.
+ * @param dst_type_name    Destination type name.
+ * @param dst_min          Minimum value that fits destination type.
+ * @param dst_max          Maximum value that fits destination type.
+ * @param src_type         Source type.
+ * @param dst_type_name    Source type name.
+ */
+#define CAST_DEFINE_TRY_S_FROM_S(dst_type, dst_type_name, dst_min, dst_max,    \
+				 src_type, src_type_name)                      \
+	static inline int cast_raw_##dst_type_name##_from_##src_type_name(     \
+	    dst_type *dst, src_type src)                                       \
+	{                                                                      \
+		if (CAST_UNLIKELY(dst == NULL || src < dst_min ||              \
+				  src > dst_max)) {                            \
+			return -1;                                             \
+		}                                                              \
+		*dst = (dst_type)src;                                          \
+		return 0;                                                      \
+	}                                                                      \
+	CAST_DEFINE_FROM(dst_type, dst_type_name, src_type, src_type_name)     \
+	CAST_DEFINE_CTX_FROM_INT(dst_type, dst_type_name, dst_min, dst_max,    \
+				 src_type, src_type_name)
+
+/**
+ * Define a conversion function for unsigned from string conversions.
+ *
+ * Parsing is done out of line by cast_raw_{T}_from_str() defined by
+ * CAST_DEFINE_RAW_U_FROM_STR() in the implementation, so conversion
+ * functions inlined into their callers stay a call and a branch.
+ *
+ * @param dst_type         Destination type.
+ * @param dst_type_name    Destination type name.
+ */
+#define CAST_DEFINE_TRY_U_FROM_STR(dst_type, dst_type_name)                    \
+	int cast_raw_##dst_type_name##_from_str(dst_type *dst,                 \
+						const char *str);              \
+	CAST_DEFINE_FROM(dst_type, dst_type_name, const char *, str)           \
+	CAST_DEFINE_CTX_FROM(dst_type, dst_type_name, const char *, str)
+
+/**
+ * Define try_{T}_from_strn() parsing function, which calls
+ * cast_raw_{T}_from_strn() and records the conversion like CAST_DEFINE_FROM(),
+ * a wrapper parsing function, which will trigger panic handler if string can't
+ * be parsed, a parsing function returning parsed value in a structure and
+ * a parsing function recording errors in a context.
+ *
+ * @param dst_type         Destination type.
+ * @param dst_type_name    Destination type name.
+ */
+#define CAST_DEFINE_FROM_STRN(dst_type, dst_type_name)                         \
+	static inline int try_##dst_type_name##_from_strn(                     \
+	    dst_type *dst, const char *ptr, size_t len)                        \
+	{                                                                      \
+		if (CAST_UNLIKELY(CAST_INSTRUMENTED())) {                      \
+			int err = cast_raw_##dst_type_name##_from_strn(        \
+			    dst, ptr, len);                                    \
+			CAST_STATS_RECORD(CAST_TYPE_strn,                      \
+					  CAST_TYPE_##dst_type_name,           \
+					  err != 0);                           \
+			CAST_TRACE_FAILURE(CAST_TYPE_strn,                     \
+					   CAST_TYPE_##dst_type_name, ptr,     \
+					   err != 0);                          \
+			CAST_PROFILE_RECORD(CAST_TYPE_strn,                    \
+					    CAST_TYPE_##dst_type_name, *dst,   \
+					    err == 0);                         \
+			return err;                                            \
+		}                                                              \
+		return cast_raw_##dst_type_name##_from_strn(dst, ptr, len);    \
+	}                                                                      \
+	static inline dst_type dst_type_name##_from_strn(const char *ptr,      \
+							 size_t len)           \
+	{                                                                      \
+		dst_type tmp = 0;                                              \
+		int err = try_##dst_type_name##_from_strn(&tmp, ptr, len);     \
+		if (CAST_UNLIKELY(err))                                        \
+			CAST_PANIC_CONVERSION(                                 \
+			    CAST_TYPE_PAIR(CAST_TYPE_strn,                     \
+					   CAST_TYPE_##dst_type_name),         \
+			    cast_value_bits(&ptr, sizeof(ptr)));               \
+		return tmp;                                                    \
+	}                                                                      \
+	static inline struct cast_##dst_type_name##_result                     \
+	    try_##dst_type_name##_from_strn_result(const char *ptr,            \
+						   size_t len)                 \
+	{                                                                      \
+		dst_type value = 0;                                            \
+		bool ok = try_##dst_type_name##_from_strn(&value, ptr, len) == \
+			  0;                                                   \
+		return (struct cast_##dst_type_name##_result){value, ok};      \
+	}                                                                      \
+	static inline dst_type dst_type_name##_from_strn_ctx(                  \
+	    struct cast_ctx *ctx, const char *file, int line, const char *ptr, \
+	    size_t len)                                                        \
+	{                                                                      \
+		dst_type value = 0;                                            \
+		bool fail =                                                    \
+		    try_##dst_type_name##_from_strn(&value, ptr, len) != 0;    \
+		cast_ctx_record(ctx, fail, "strn to " #dst_type_name, file,    \
+				line);                                         \
+		return value;                                                  \
+	}
+
+/**
+ * Define a parsing function for unsigned from string slice conversions.
+ *
+ * @param dst_type         Destination type.
+ * @param dst_type_name    Destination type name.
+ */
+#define CAST_DEFINE_TRY_U_FROM_STRN(dst_type, dst_type_name)                   \
+	static inline int cast_raw_##dst_type_name##_from_strn(                \
+	    dst_type *dst, const char *ptr, size_t len)                        \
+	{                                                                      \
+		uint64_t tmp = 0U;                                             \
+		if (cast_try_u64_from_strn(&tmp, ptr, len))                    \
+			return -1;                                             \
+		return cast_raw_##dst_type_name##_from_u64(dst, tmp);          \
+	}                                                                      \
+	CAST_DEFINE_FROM_STRN(dst_type, dst_type_name)
+
+/**
+ * Define a parsing function for signed from string slice conversions.
+ *
+ * @param dst_type         Destination type.
+ * @param dst_type_name    Destination type name.
+ */
+#define CAST_DEFINE_TRY_S_FROM_STRN(dst_type, dst_type_name)                   \
+	static inline int cast_raw_##dst_type_name##_from_strn(                \
+	    dst_type *dst, const char *ptr, size_t len)                        \
+	{                                                                      \
+		int64_t tmp = 0;                                               \
+		if (cast_try_i64_from_strn(&tmp, ptr, len))                    \
+			return -1;                                             \
+		return cast_raw_##dst_type_name##_from_i64(dst, tmp);          \
+	}                                                                      \
+	CAST_DEFINE_FROM_STRN(dst_type, dst_type_name)
+
+/**
+ * Define functions formatting values with NULL character and formatting
+ * arrays, which are based on cast_fmt_{T}().
+ *
+ * @param type        Value type.
+ * @param type_name   Value type name.
+ */
+#define CAST_DEFINE_FMT(type, type_name)                                       \
+	static inline size_t cast_fmt_##type_name##_str(char *buf, size_t cap, \
+							type value)            \
+	{                                                                      \
+		if (buf == NULL || cap == 0U)                                  \
+			return 0U;                                             \
+		size_t len = cast_fmt_##type_name(buf, cap - 1U, value);       \
+		if (len)                                                       \
+			buf[len] = '\0';                                       \
+		return len;                                                    \
+	}                                                                      \
+	static inline size_t cast_fmt_##type_name##_array(                     \
+	    char *buf, size_t cap, const type *src, size_t n, char sep,        \
+	    size_t *count)                                                     \
+	{                                                                      \
+		size_t len = 0U;                                               \
+		size_t i = 0U;                                                 \
+		if (buf == NULL || src == NULL)                                \
+			n = 0U;                                                \
+		for (; i < n; ++i) {                                           \
+			size_t sep_len = i > 0U;                               \
+			if (cap - len <= sep_len)                              \
+				break;                                         \
+			size_t written = cast_fmt_##type_name(                 \
+			    buf + len + sep_len, cap - len - sep_len, src[i]); \
+			if (written == 0U)                                     \
+				break;                                         \
+			if (sep_len)                                           \
+				buf[len] = sep;                                \
+			len += sep_len + written;                              \
+		}                                                              \
+		if (count)                                                     \
+			*count = i;                                            \
+		return len;                                                    \
+	}
+
+/**
+ * Define functions formatting unsigned integers in decimal.
+ *
+ * @param type        Integer type.
+ * @param type_name   Integer type name.
+ */
+#define CAST_DEFINE_FMT_U(type, type_name)                                     \
+	static inline size_t cast_fmt_##type_name(char *buf, size_t cap,       \
+						  type value)                  \
+	{                                                                      \
+		return cast_fmt_decimal(buf, cap, false, (uint64_t)value);     \
+	}                                                                      \
+	CAST_DEFINE_FMT(type, type_name)
+
+/**
+ * Define functions formatting signed integers in decimal.
+ *
+ * @param type        Integer type.
+ * @param type_name   Integer type name.
+ */
+#define CAST_DEFINE_FMT_S(type, type_name)                                     \
+	static inline size_t cast_fmt_##type_name(char *buf, size_t cap,       \
+						  type value)                  \
+	{                                                                      \
+		uint64_t magnitude = (uint64_t)value;                          \
+		if (value < 0)                                                 \
+			magnitude = 0U - magnitude;                            \
+		return cast_fmt_decimal(buf, cap, value < 0, magnitude);       \
+	}                                                                      \
+	CAST_DEFINE_FMT(type, type_name)
+
+/**
+ * Define a parsing function for floating point from string slice
+ * conversions.
+ *
+ * @param dst_type         Destination type.
+ * @param dst_type_name    Destination type name.
+ */
+#define CAST_DEFINE_TRY_F_FROM_STRN(dst_type, dst_type_name)                   \
+	static inline int cast_raw_##dst_type_name##_from_strn(                \
+	    dst_type *dst, const char *ptr, size_t len)                        \
+	{                                                                      \
+		return cast_try_##dst_type##_from_strn(dst, ptr, len);         \
+	}                                                                      \
+	CAST_DEFINE_FROM_STRN(dst_type, dst_type_name)
+
+/**
+ * Define a conversion function for floating point from string conversions.
+ *
+ * @param dst_type         Destination type.
+ * @param dst_type_name    Destination type name.
+ */
+#define CAST_DEFINE_TRY_F_FROM_STR(dst_type, dst_type_name)                    \
+	static inline int cast_raw_##dst_type_name##_from_str(                 \
+	    dst_type *dst, const char *str)                                    \
+	{                                                                      \
+		int ret = cast_try_##dst_type##_from_str(dst, str);            \
+		if (ret)                                                       \
+			return -1;                                             \
+		return 0;                                                      \
+	}                                                                      \
+	CAST_DEFINE_FROM(dst_type, dst_type_name, const char *, str)           \
+	CAST_DEFINE_CTX_FROM(dst_type, dst_type_name, const char *, str)
+
+/**
+ * Define a conversion function for signed from string conversions.
+ *
+ * Parsing is done out of line by cast_raw_{T}_from_str() defined by
+ * CAST_DEFINE_RAW_S_FROM_STR() in the implementation, so conversion
+ * functions inlined into their callers stay a call and a branch.
+ *
+ * @param dst_type         Destination type.
+ * @param dst_type_name    Destination type name.
+ */
+#define CAST_DEFINE_TRY_S_FROM_STR(dst_type, dst_type_name)                    \
+	int cast_raw_##dst_type_name##_from_str(dst_type *dst,                 \
+						const char *str);              \
+	CAST_DEFINE_FROM(dst_type, dst_type_name, const char *, str)           \
+	CAST_DEFINE_CTX_FROM(dst_type, dst_type_name, const char *, str)
+
+/**
+ * Define a conversion function for signed to floating point conversions.
+ *
+ * @param dst_type         Destination type.
+ * @param dst_type_name    Destination type name.
+ * @param mantissa_bits    Number of mantissa bits
+ * @param src_type         Source type.
+ * @param src_type_name    Source type name.
+ * @param src_min          Minimum value that fits source type.
+ */
+#define CAST_DEFINE_TRY_F_FROM_S(dst_type, dst_type_name, mantissa_bits,       \
+				 src_type, src_type_name, src_min)             \
+	static inline int cast_raw_##dst_type_name##_from_##src_type_name(     \
+	    dst_type *dst, src_type src)                                       \
+	{                                                                      \
+		if (CAST_UNLIKELY(!dst))                                       \
+			return -1;                                             \
+		if (sizeof(src) < sizeof(*dst)) {                              \
+			*dst = (dst_type)src;                                  \
+			return 0;                                              \
+		}                                                              \
+		/* Prune UB from `-(src)` operation. */                        \
+		if (src == src_min) {                                          \
+			*dst = (dst_type)src;                                  \
+			return 0;                                              \
+		}                                                              \
+		cast_largest_utype relevant = cast_shift_zeros_right(          \
+		    (cast_largest_utype)(src < 0 ? -src : src));               \
+		if (CAST_UNLIKELY(relevant > (1ULL << mantissa_bits) - 1ULL))  \
+			return -1;                                             \
+		*dst = (dst_type)src;                                          \
+		return 0;                                                      \
+	}                                                                      \
+	CAST_DEFINE_FROM(dst_type, dst_type_name, src_type, src_type_name)     \
+	CAST_DEFINE_CTX_FROM(dst_type, dst_type_name, src_type, src_type_name)
+
+/**
+ * Define a conversion function for unsigned to floating point conversions.
+ *
+ * @param dst_type         Destination type.
+ * @param dst_type_name    Destination type name.
+ * @param mantissa_bits    Number of mantissa bits
+ * @param src_type         Source type.
+ * @param src_type_name    Source type name.
+ */
+#define CAST_DEFINE_TRY_F_FROM_U(dst_type, dst_type_name, mantissa_bits,       \
+				 src_type, src_type_name)                      \
+	static inline int cast_raw_##dst_type_name##_from_##src_type_name(     \
+	    dst_type *dst, src_type src)                                       \
+	{                                                                      \
+		if (CAST_UNLIKELY(!dst))                                       \
+			return -1;                                             \
+		if (sizeof(src) < sizeof(*dst)) {                              \
+			*dst = (dst_type)src;                                  \
+			return 0;                                              \
+		}                                                              \
+		cast_largest_utype relevant = cast_shift_zeros_right(src);     \
+		if (CAST_UNLIKELY(relevant > (1ULL << mantissa_bits) - 1ULL))  \
+			return -1;                                             \
+		*dst = (dst_type)src;                                          \
+		return 0;                                                      \
+	}                                                                      \
+	CAST_DEFINE_FROM(dst_type, dst_type_name, src_type, src_type_name)     \
+	CAST_DEFINE_CTX_FROM(dst_type, dst_type_name, src_type, src_type_name)
+
+/**
+ * Define a conversion function for floating point to unsigned conversions.
+ *
+ * @param dst_type         Destination type.
+ * @param dst_type_name    Destination type name.
+ * @param src_type         Source type.
+ * @param src_type_name    Source type name.
+ */
+#define CAST_DEFINE_TRY_U_FROM_F(dst_type, dst_type_name, src_type,            \
+				 src_type_name)                                \
+	static inline int cast_raw_##dst_type_name##_from_##src_type_name(     \
+	    dst_type *dst, src_type src)                                       \
+	{                                                                      \
+		if (CAST_UNLIKELY(!dst))                                       \
+			return -1;                                             \
+		const src_type src_upper = CAST_UNSIGNED_UPPER_LIMIT(src_type, \
+								     dst_type); \
+		/* Negated comparison also rejects NaN */                      \
+		if (CAST_UNLIKELY(!(src >= (src_type)0.0 && src < src_upper))) \
+			return -1;                                             \
+		/* In range, so truncating conversion is defined */            \
+		dst_type tmp = (dst_type)src;                                  \
+		if (CAST_UNLIKELY((src_type)tmp != src))                       \
+			return -1;                                             \
+		*dst = tmp;                                                    \
+		return 0;                                                      \
+	}                                                                      \
+	CAST_DEFINE_FROM(dst_type, dst_type_name, src_type, src_type_name)     \
+	CAST_DEFINE_CTX_FROM(dst_type, dst_type_name, src_type, src_type_name)
+
+/**
+ * Define a conversion function for floating point to signed conversions.
+ *
+ * @param dst_type         Destination type.
+ * @param dst_type_name    Destination type name.
+ * @param src_type         Source type.
+ * @param src_type_name    Source type name.
+ */
+#define CAST_DEFINE_TRY_S_FROM_F(dst_type, dst_type_name, dst_min, src_type,   \
+				 src_type_name)                                \
+	static inline int cast_raw_##dst_type_name##_from_##src_type_name(     \
+	    dst_type *dst, src_type src)                                       \
+	{                                                                      \
+		if (CAST_UNLIKELY(!dst))                                       \
+			return -1;                                             \
+		const src_type src_upper = CAST_SIGNED_UPPER_LIMIT(src_type,   \
+								   dst_min);   \
+		const src_type src_min = (src_type)(dst_min);                  \
+		/* Negated comparison also rejects NaN */                      \
+		if (CAST_UNLIKELY(!(src >= src_min && src < src_upper)))       \
+			return -1;                                             \
+		/* In range, so truncating conversion is defined */            \
+		dst_type tmp = (dst_type)src;                                  \
+		if (CAST_UNLIKELY((src_type)tmp != src))                       \
+			return -1;                                             \
+		*dst = tmp;                                                    \
+		return 0;                                                      \
+	}                                                                      \
+	CAST_DEFINE_FROM(dst_type, dst_type_name, src_type, src_type_name)     \
+	CAST_DEFINE_CTX_FROM(dst_type, dst_type_name, src_type, src_type_name)
+
+/**
+ * Define a family of functions for conversions to unsigned type.
+ *
+ * @param dst_type         Destination type.
+ * @param dst_type_name    Destination type name.
+ * @param dst_type_max     Maximum value that can fit desintation type.
+ */
+#define CAST_DEFINE_TRY_U(dst_type, dst_type_name, dst_type_max)               \
+	CAST_DEFINE_RESULT(dst_type, dst_type_name)                            \
+	/* From signed */                                                      \
+	CAST_DEFINE_TRY_U_FROM_S(dst_type, dst_type_name, dst_type_max,        \
+				 signed char, schar)                           \
+	CAST_DEFINE_TRY_U_FROM_S(dst_type, dst_type_name, dst_type_max,        \
+				 int8_t, i8)                                   \
+	CAST_DEFINE_TRY_U_FROM_S(dst_type, dst_type_name, dst_type_max,        \
+				 int16_t, i16)                                 \
+	CAST_DEFINE_TRY_U_FROM_S(dst_type, dst_type_name, dst_type_max,        \
+				 int32_t, i32)                                 \
+	CAST_DEFINE_TRY_U_FROM_S(dst_type, dst_type_name, dst_type_max,        \
+				 int64_t, i64)                                 \
+	CAST_DEFINE_TRY_U_FROM_S(dst_type, dst_type_name, dst_type_max, int,   \
+				 int)                                          \
+	CAST_DEFINE_TRY_U_FROM_S(dst_type, dst_type_name, dst_type_max, short, \
+				 short)                                        \
+	CAST_DEFINE_TRY_U_FROM_S(dst_type, dst_type_name, dst_type_max, long,  \
+				 long)                                         \
+	CAST_DEFINE_TRY_U_FROM_S(dst_type, dst_type_name, dst_type_max,        \
+				 long long, llong)                             \
+	CAST_DEFINE_TRY_U_FROM_S(dst_type, dst_type_name, dst_type_max,        \
+				 ptrdiff_t, ptrdiff)                           \
+	/* From unsigned */                                                    \
+	CAST_DEFINE_TRY_U_FROM_U(dst_type, dst_type_name, dst_type_max,        \
+				 unsigned char, uchar)                         \
+	CAST_DEFINE_TRY_U_FROM_U(dst_type, dst_type_name, dst_type_max,        \
+				 uint8_t, u8)                                  \
+	CAST_DEFINE_TRY_U_FROM_U(dst_type, dst_type_name, dst_type_max,        \
+				 uint16_t, u16)                                \
+	CAST_DEFINE_TRY_U_FROM_U(dst_type, dst_type_name, dst_type_max,        \
+				 uint32_t, u32)                                \
+	CAST_DEFINE_TRY_U_FROM_U(dst_type, dst_type_name, dst_type_max,        \
+				 uint64_t, u64)                                \
+	CAST_DEFINE_TRY_U_FROM_U(dst_type, dst_type_name, dst_type_max,        \
+				 unsigned, uint)                               \
+	CAST_DEFINE_TRY_U_FROM_U(dst_type, dst_type_name, dst_type_max,        \
+				 unsigned short, ushort)                       \
+	CAST_DEFINE_TRY_U_FROM_U(dst_type, dst_type_name, dst_type_max,        \
+				 unsigned long, ulong)                         \
+	CAST_DEFINE_TRY_U_FROM_U(dst_type, dst_type_name, dst_type_max,        \
+				 unsigned long long, ullong)                   \
+	CAST_DEFINE_TRY_U_FROM_U(dst_type, dst_type_name, dst_type_max,        \
+				 size_t, size)                                 \
+	CAST_DEFINE_TRY_U_FROM_U(dst_type, dst_type_name, dst_type_max,        \
+				 uintptr_t, uptr)                              \
+	/* From floating point */                                              \
+	CAST_DEFINE_TRY_U_FROM_F(dst_type, dst_type_name, float, float)        \
+	CAST_DEFINE_TRY_U_FROM_F(dst_type, dst_type_name, double, double)      \
+	/* From str */                                                         \
+	CAST_DEFINE_TRY_U_FROM_STR(dst_type, dst_type_name)                    \
+	CAST_DEFINE_TRY_U_FROM_STRN(dst_type, dst_type_name)                   \
+	CAST_DEFINE_FMT_U(dst_type, dst_type_name)                             \
+	/* END */
+
+/**
+ * Define a family of functions for conversions to signed type.
+ *
+ * @param dst_type         Destination type.
+ * @param dst_type_name    Destination type name.
+ * @param dst_type_max     Maximum value that can fit desintation type.
+ */
+#define CAST_DEFINE_TRY_S(dst_type, dst_type_name, dst_type_max)               \
+	CAST_DEFINE_RESULT(dst_type, dst_type_name)                            \
+	/* From signed */                                                      \
+	CAST_DEFINE_TRY_S_FROM_S(dst_type, dst_type_name, dst_type_max##_MIN,  \
+				 dst_type_max##_MAX, signed char, schar)       \
+	CAST_DEFINE_TRY_S_FROM_S(dst_type, dst_type_name, dst_type_max##_MIN,  \
+				 dst_type_max##_MAX, int8_t, i8)               \
+	CAST_DEFINE_TRY_S_FROM_S(dst_type, dst_type_name, dst_type_max##_MIN,  \
+				 dst_type_max##_MAX, int16_t, i16)             \
+	CAST_DEFINE_TRY_S_FROM_S(dst_type, dst_type_name, dst_type_max##_MIN,  \
+				 dst_type_max##_MAX, int32_t, i32)             \
+	CAST_DEFINE_TRY_S_FROM_S(dst_type, dst_type_name, dst_type_max##_MIN,  \
+				 dst_type_max##_MAX, int64_t, i64)             \
+	CAST_DEFINE_TRY_S_FROM_S(dst_type, dst_type_name, dst_type_max##_MIN,  \
+				 dst_type_max##_MAX, int, int)                 \
+	CAST_DEFINE_TRY_S_FROM_S(dst_type, dst_type_name, dst_type_max##_MIN,  \
+				 dst_type_max##_MAX, short, short)             \
+	CAST_DEFINE_TRY_S_FROM_S(dst_type, dst_type_name, dst_type_max##_MIN,  \
+				 dst_type_max##_MAX, long, long)               \
+	CAST_DEFINE_TRY_S_FROM_S(dst_type, dst_type_name, dst_type_max##_MIN,  \
+				 dst_type_max##_MAX, long long, llong)         \
+	CAST_DEFINE_TRY_S_FROM_S(dst_type, dst_type_name, dst_type_max##_MIN,  \
+				 dst_type_max##_MAX, ptrdiff_t, ptrdiff)       \
+	/* From unsigned */                                                    \
+	CAST_DEFINE_TRY_S_FROM_U(dst_type, dst_type_name, dst_type_max##_MAX,  \
+				 unsigned char, uchar)                         \
+	CAST_DEFINE_TRY_S_FROM_U(dst_type, dst_type_name, dst_type_max##_MAX,  \
+				 uint8_t, u8)                                  \
+	CAST_DEFINE_TRY_S_FROM_U(dst_type, dst_type_name, dst_type_max##_MAX,  \
+				 uint16_t, u16)                                \
+	CAST_DEFINE_TRY_S_FROM_U(dst_type, dst_type_name, dst_type_max##_MAX,  \
+				 uint32_t, u32)                                \
+	CAST_DEFINE_TRY_S_FROM_U(dst_type, dst_type_name, dst_type_max##_MAX,  \
+				 uint64_t, u64)                                \
+	CAST_DEFINE_TRY_S_FROM_U(dst_type, dst_type_name, dst_type_max##_MAX,  \
+				 unsigned, uint)                               \
+	CAST_DEFINE_TRY_S_FROM_U(dst_type, dst_type_name, dst_type_max##_MAX,  \
+				 unsigned short, ushort)                       \
+	CAST_DEFINE_TRY_S_FROM_U(dst_type, dst_type_name, dst_type_max##_MAX,  \
+				 unsigned long, ulong)                         \
+	CAST_DEFINE_TRY_S_FROM_U(dst_type, dst_type_name, dst_type_max##_MAX,  \
+				 unsigned long long, ullong)                   \
+	CAST_DEFINE_TRY_S_FROM_U(dst_type, dst_type_name, dst_type_max##_MAX,  \
+				 size_t, size)                                 \
+	CAST_DEFINE_TRY_S_FROM_U(dst_type, dst_type_name, dst_type_max##_MAX,  \
+				 uintptr_t, uptr)                              \
+	/* From floating point */                                              \
+	CAST_DEFINE_TRY_S_FROM_F(dst_type, dst_type_name, dst_type_max##_MIN,  \
+				 float, float)                                 \
+	CAST_DEFINE_TRY_S_FROM_F(dst_type, dst_type_name, dst_type_max##_MIN,  \
+				 double, double)                               \
+	/* From str */                                                         \
+	CAST_DEFINE_TRY_S_FROM_STR(dst_type, dst_type_name)                    \
+	CAST_DEFINE_TRY_S_FROM_STRN(dst_type, dst_type_name)                   \
+	CAST_DEFINE_FMT_S(dst_type, dst_type_name)                             \
+	/* END */
+
+/**
+ * Define a family of functions for conversions to floating point type.
+ *
+ * @param dst_type         Destination type.
+ * @param dst_type_name    Destination type name.
+ * @param mantissa_bits    Number of mantissa bits.
+ */
+#define CAST_DEFINE_TRY_F(dst_type, dst_type_name, mantissa_bits)              \
+	CAST_DEFINE_RESULT(dst_type, dst_type_name)                            \
+	/* From signed */                                                      \
+	CAST_DEFINE_TRY_F_FROM_S(dst_type, dst_type_name, mantissa_bits,       \
+				 signed char, schar, SCHAR_MIN)                \
+	CAST_DEFINE_TRY_F_FROM_S(dst_type, dst_type_name, mantissa_bits,       \
+				 int8_t, i8, INT8_MIN)                         \
+	CAST_DEFINE_TRY_F_FROM_S(dst_type, dst_type_name, mantissa_bits,       \
 				 int16_t, i16, INT16_MIN)                      \
 	CAST_DEFINE_TRY_F_FROM_S(dst_type, dst_type_name, mantissa_bits,       \
 				 int32_t, i32, INT32_MIN)                      \
@@ -833,301 +2570,6355 @@ int cast_try_double_from_str(double *dst, const char *str);
 	CAST_DEFINE_TRY_F_FROM_S(dst_type, dst_type_name, mantissa_bits,       \
 				 ptrdiff_t, ptrdiff, PTRDIFF_MIN)              \
 	/* From unsigned */                                                    \
-	CAST_DEFINE_TRY_F_FROM_U(dst_type, dst_type_name, mantissa_bits,       \
-				 unsigned char, uchar)                         \
-	CAST_DEFINE_TRY_F_FROM_U(dst_type, dst_type_name, mantissa_bits,       \
-				 uint8_t, u8)                                  \
-	CAST_DEFINE_TRY_F_FROM_U(dst_type, dst_type_name, mantissa_bits,       \
-				 uint16_t, u16)                                \
-	CAST_DEFINE_TRY_F_FROM_U(dst_type, dst_type_name, mantissa_bits,       \
-				 uint32_t, u32)                                \
-	CAST_DEFINE_TRY_F_FROM_U(dst_type, dst_type_name, mantissa_bits,       \
-				 uint64_t, u64)                                \
-	CAST_DEFINE_TRY_F_FROM_U(dst_type, dst_type_name, mantissa_bits,       \
-				 unsigned int, uint)                           \
-	CAST_DEFINE_TRY_F_FROM_U(dst_type, dst_type_name, mantissa_bits,       \
-				 unsigned short, ushort)                       \
-	CAST_DEFINE_TRY_F_FROM_U(dst_type, dst_type_name, mantissa_bits,       \
-				 unsigned long, ulong)                         \
-	CAST_DEFINE_TRY_F_FROM_U(dst_type, dst_type_name, mantissa_bits,       \
-				 unsigned long long, ullong)                   \
-	CAST_DEFINE_TRY_F_FROM_U(dst_type, dst_type_name, mantissa_bits,       \
-				 size_t, size)                                 \
-	/* From str */                                                         \
-	CAST_DEFINE_TRY_F_FROM_STR(dst_type, dst_type_name)                    \
+	CAST_DEFINE_TRY_F_FROM_U(dst_type, dst_type_name, mantissa_bits,       \
+				 unsigned char, uchar)                         \
+	CAST_DEFINE_TRY_F_FROM_U(dst_type, dst_type_name, mantissa_bits,       \
+				 uint8_t, u8)                                  \
+	CAST_DEFINE_TRY_F_FROM_U(dst_type, dst_type_name, mantissa_bits,       \
+				 uint16_t, u16)                                \
+	CAST_DEFINE_TRY_F_FROM_U(dst_type, dst_type_name, mantissa_bits,       \
+				 uint32_t, u32)                                \
+	CAST_DEFINE_TRY_F_FROM_U(dst_type, dst_type_name, mantissa_bits,       \
+				 uint64_t, u64)                                \
+	CAST_DEFINE_TRY_F_FROM_U(dst_type, dst_type_name, mantissa_bits,       \
+				 unsigned int, uint)                           \
+	CAST_DEFINE_TRY_F_FROM_U(dst_type, dst_type_name, mantissa_bits,       \
+				 unsigned short, ushort)                       \
+	CAST_DEFINE_TRY_F_FROM_U(dst_type, dst_type_name, mantissa_bits,       \
+				 unsigned long, ulong)                         \
+	CAST_DEFINE_TRY_F_FROM_U(dst_type, dst_type_name, mantissa_bits,       \
+				 unsigned long long, ullong)                   \
+	CAST_DEFINE_TRY_F_FROM_U(dst_type, dst_type_name, mantissa_bits,       \
+				 size_t, size)                                 \
+	/* From str */                                                         \
+	CAST_DEFINE_TRY_F_FROM_STR(dst_type, dst_type_name)                    \
+	CAST_DEFINE_TRY_F_FROM_STRN(dst_type, dst_type_name)                   \
+	CAST_DEFINE_FMT(dst_type, dst_type_name)                               \
+	/* END */
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wpragmas"
+#pragma GCC diagnostic ignored "-Wtype-limits"
+#pragma GCC diagnostic ignored "-Wtautological-constant-out-of-range-compare"
+CAST_DEFINE_TRY_U(uint8_t, u8, UINT8_MAX)
+CAST_DEFINE_TRY_U(uint16_t, u16, UINT16_MAX)
+CAST_DEFINE_TRY_U(uint32_t, u32, UINT32_MAX)
+CAST_DEFINE_TRY_U(uint64_t, u64, UINT64_MAX)
+CAST_DEFINE_TRY_U(unsigned char, uchar, UCHAR_MAX)
+CAST_DEFINE_TRY_U(unsigned, uint, UINT_MAX)
+CAST_DEFINE_TRY_U(unsigned short, ushort, USHRT_MAX)
+CAST_DEFINE_TRY_U(unsigned long, ulong, ULONG_MAX)
+CAST_DEFINE_TRY_U(unsigned long long, ullong, ULLONG_MAX)
+CAST_DEFINE_TRY_U(size_t, size, SIZE_MAX)
+CAST_DEFINE_TRY_U(uintptr_t, uptr, UINTPTR_MAX)
+CAST_DEFINE_TRY_S(int8_t, i8, INT8)
+CAST_DEFINE_TRY_S(int16_t, i16, INT16)
+CAST_DEFINE_TRY_S(int32_t, i32, INT32)
+CAST_DEFINE_TRY_S(int64_t, i64, INT64)
+CAST_DEFINE_TRY_S(signed char, schar, SCHAR)
+CAST_DEFINE_TRY_S(int, int, INT)
+CAST_DEFINE_TRY_S(short, short, SHRT)
+CAST_DEFINE_TRY_S(long, long, LONG)
+CAST_DEFINE_TRY_S(long long, llong, LLONG)
+CAST_DEFINE_TRY_S(ptrdiff_t, ptrdiff, PTRDIFF)
+#pragma GCC diagnostic pop
+CAST_DEFINE_TRY_F(float, float, 24U)
+CAST_DEFINE_TRY_F(double, double, 53U)
+
+/* List of all types supported by cast library */
+#define CAST_TYPES                                                             \
+	F(uint8_t, u8)                                                         \
+	F(uint16_t, u16)                                                       \
+	F(uint32_t, u32)                                                       \
+	F(uint64_t, u64)                                                       \
+	F(unsigned char, uchar)                                                \
+	F(unsigned, uint)                                                      \
+	F(unsigned short, ushort)                                              \
+	F(unsigned long, ulong)                                                \
+	F(unsigned long long, ullong)                                          \
+	F(size_t, size)                                                        \
+	F(uintptr_t, uptr)                                                     \
+	F(int8_t, i8)                                                          \
+	F(int16_t, i16)                                                        \
+	F(int32_t, i32)                                                        \
+	F(int64_t, i64)                                                        \
+	F(signed char, schar)                                                  \
+	F(int, int)                                                            \
+	F(short, short)                                                        \
+	F(long, long)                                                          \
+	F(long long, llong)                                                    \
+	F(ptrdiff_t, ptrdiff)                                                  \
+	F(float, float)                                                        \
+	F(double, double)                                                      \
+	F(bool, bool)                                                          \
+	/* END */
+
+CAST_DEFINE_RESULT(bool, bool)
+
+static inline int cast_raw_bool_from_str(bool *val, const char *str)
+{
+	if (!val)
+		return -1;
+
+	long long tmp = 0;
+	int err = cast_raw_llong_from_str(&tmp, str);
+	if (err)
+		return -1;
+
+	*val = tmp != 0U;
+	return 0;
+}
+CAST_DEFINE_FROM(bool, bool, const char *, str)
+CAST_DEFINE_CTX_FROM(bool, bool, const char *, str)
+
+static inline int cast_raw_bool_from_strn(bool *val, const char *ptr,
+					  size_t len)
+{
+	if (!val)
+		return -1;
+
+	int64_t tmp = 0;
+	int err = cast_try_i64_from_strn(&tmp, ptr, len);
+	if (err)
+		return -1;
+
+	*val = tmp != 0;
+	return 0;
+}
+CAST_DEFINE_FROM_STRN(bool, bool)
+
+/* Instruction set levels of array conversion kernels */
+enum cast_isa {
+	CAST_ISA_SCALAR,
+	CAST_ISA_SSE2,
+	CAST_ISA_AVX2,
+	CAST_ISA_AVX512,
+};
+
+#if !defined(CAST_NO_DISPATCH) && (defined(__x86_64__) || defined(__i386__)) && \
+    (defined(__GNUC__) || defined(__clang__))
+/* Kernels are compiled for every level and selected at runtime */
+#define CAST_DISPATCH
+#define CAST_TARGET(isa) __attribute__((target(isa)))
+#define CAST_WITH_SSE2
+#define CAST_WITH_AVX2
+#define CAST_WITH_AVX512
+#else
+/* Kernels are compiled only for levels enabled for the translation unit */
+#define CAST_TARGET(isa)
+#if defined(__SSE2__)
+#define CAST_WITH_SSE2
+#endif
+#if defined(__AVX2__)
+#define CAST_WITH_AVX2
+#endif
+#if defined(__AVX512F__) && defined(__AVX512DQ__)
+#define CAST_WITH_AVX512
+#endif
+#endif
+
+#if defined(__AVX512F__) && defined(__AVX512DQ__)
+#define CAST_ISA_BUILTIN CAST_ISA_AVX512
+#elif defined(__AVX2__)
+#define CAST_ISA_BUILTIN CAST_ISA_AVX2
+#elif defined(__SSE2__)
+#define CAST_ISA_BUILTIN CAST_ISA_SSE2
+#else
+#define CAST_ISA_BUILTIN CAST_ISA_SCALAR
+#endif
+
+#define CAST_TARGET_SSE2 CAST_TARGET("sse2")
+#define CAST_TARGET_AVX2 CAST_TARGET("avx2")
+#define CAST_TARGET_AVX512 CAST_TARGET("avx2,avx512f,avx512dq")
+
+/* Number of elements checked at once by the portable array conversion loop */
+#define CAST_ARRAY_BLOCK 64U
+
+/* Whether integer type is signed */
+#define CAST_IS_SIGNED(type) ((type)-1 < (type)0)
+
+/**
+ * Return the smallest value of `src_type` that fits destination type.
+ *
+ * @param src_type       Source type.
+ * @param src_min        Minimum value that fits source type.
+ * @param dst_min        Minimum value that fits destination type.
+ *
+ * @return Lower limit of valid source values expressed in `src_type`.
+ */
+#define CAST_ARRAY_LO(src_type, src_min, dst_min)                              \
+	((intmax_t)(dst_min) < (intmax_t)(src_min) ? (src_type)(src_min)       \
+						   : (src_type)(dst_min))
+
+/**
+ * Return the largest value of `src_type` that fits destination type.
+ *
+ * @param src_type       Source type.
+ * @param src_max        Maximum value that fits source type.
+ * @param dst_max        Maximum value that fits destination type.
+ *
+ * @return Upper limit of valid source values expressed in `src_type`.
+ */
+#define CAST_ARRAY_HI(src_type, src_max, dst_max)                              \
+	((uintmax_t)(dst_max) < (uintmax_t)(src_max) ? (src_type)(dst_max)     \
+						     : (src_type)(src_max))
+
+/**
+ * Return the smallest value of floating point type `src_type` which is too
+ * large to fit integer type with maximum value `dst_max`.
+ *
+ * Maximum of integer type is 2^k - 1, which is either exact or is rounded
+ * to 2^k, adding one yields 2^k in both cases.
+ *
+ * @param src_type       Floating point source type.
+ * @param dst_max        Maximum value that fits destination type.
+ *
+ * @return Upper limit of valid source values expressed in `src_type`.
+ */
+#define CAST_ARRAY_F_UPPER(src_type, dst_max)                                  \
+	((src_type)(dst_max) + (src_type)1.0)
+
+/*
+ * With runtime dispatch kernels are compiled only into the translation unit,
+ * which defines CAST_IMPLEMENTATION. Other ones call them through
+ * cast_kernel_*() functions and don't include intrinsics headers.
+ */
+#if !defined(CAST_DISPATCH) || defined(CAST_IMPLEMENTATION)
+#if defined(CAST_WITH_SSE2)
+#include <emmintrin.h>
+#endif
+#if defined(CAST_WITH_AVX2) || defined(CAST_WITH_AVX512)
+#include <immintrin.h>
+#endif
+
+#if defined(CAST_WITH_SSE2)
+CAST_TARGET_SSE2 static inline __m128i
+cast_sse2_set1(uint64_t value, size_t size)
+{
+	switch (size) {
+	case 1U:
+		return _mm_set1_epi8((char)(uint8_t)value);
+	case 2U:
+		return _mm_set1_epi16((short)(uint16_t)value);
+	case 4U:
+		return _mm_set1_epi32((int)(uint32_t)value);
+	default:
+		return _mm_set1_epi64x((long long)value);
+	}
+}
+
+CAST_TARGET_SSE2 static inline __m128i
+cast_sse2_add(__m128i a, __m128i b, size_t size)
+{
+	switch (size) {
+	case 1U:
+		return _mm_add_epi8(a, b);
+	case 2U:
+		return _mm_add_epi16(a, b);
+	case 4U:
+		return _mm_add_epi32(a, b);
+	default:
+		return _mm_add_epi64(a, b);
+	}
+}
+
+/**
+ * Narrow `n` elements of `src_size` bytes into elements of `dst_size` bytes.
+ *
+ * An element fits if `((element + bias) & mask) == 0`, which is how every
+ * integer range [lo, hi] with `hi - lo + 1` being a power of two can be
+ * tested with a single add and a single and. Elements are processed in
+ * blocks of 64 source bytes; a block is stored only if all its elements fit.
+ *
+ * @param dst          Destination array.
+ * @param dst_size     Size of destination element.
+ * @param src          Source array.
+ * @param src_size     Size of source element.
+ * @param n            Number of elements in `src`.
+ * @param bias         Value added to each element before masking.
+ * @param mask         Bits that must be zero after adding bias.
+ *
+ * @return Number of leading elements which were converted.
+ */
+CAST_TARGET_SSE2 static inline size_t
+cast_sse2_narrow(void *dst, size_t dst_size,
+				      const void *src, size_t src_size,
+				      size_t n, uint64_t bias, uint64_t mask)
+{
+	const __m128i vbias = cast_sse2_set1(bias, src_size);
+	const __m128i vmask = cast_sse2_set1(mask, src_size);
+	const __m128i zero = _mm_setzero_si128();
+	const size_t step = 64U / src_size;
+	const unsigned char *s = (const unsigned char *)src;
+	unsigned char *d = (unsigned char *)dst;
+	size_t i = 0U;
+
+	for (; n - i >= step; i += step) {
+		__m128i v[4];
+		__m128i acc = zero;
+		for (size_t k = 0U; k < 4U; ++k) {
+			v[k] = _mm_loadu_si128((const __m128i *)(s + 16U * k));
+			acc = _mm_or_si128(
+			    acc, _mm_and_si128(cast_sse2_add(v[k], vbias,
+							     src_size),
+					       vmask));
+		}
+		if (_mm_movemask_epi8(_mm_cmpeq_epi8(acc, zero)) != 0xFFFF)
+			break;
+
+		if (src_size == dst_size) {
+			for (size_t k = 0U; k < 4U; ++k)
+				_mm_storeu_si128((__m128i *)(d + 16U * k),
+						 v[k]);
+		} else if (src_size == 2U && dst_size == 1U) {
+			const __m128i lo = _mm_set1_epi16(0xFF);
+			for (size_t k = 0U; k < 2U; ++k) {
+				__m128i a = _mm_and_si128(v[2U * k], lo);
+				__m128i b = _mm_and_si128(v[2U * k + 1U], lo);
+				_mm_storeu_si128((__m128i *)(d + 16U * k),
+						 _mm_packus_epi16(a, b));
+			}
+		} else if (src_size == 4U && dst_size == 2U) {
+			for (size_t k = 0U; k < 2U; ++k) {
+				__m128i a = _mm_srai_epi32(
+				    _mm_slli_epi32(v[2U * k], 16), 16);
+				__m128i b = _mm_srai_epi32(
+				    _mm_slli_epi32(v[2U * k + 1U], 16), 16);
+				_mm_storeu_si128((__m128i *)(d + 16U * k),
+						 _mm_packs_epi32(a, b));
+			}
+		} else if (src_size == 4U && dst_size == 1U) {
+			const __m128i lo = _mm_set1_epi32(0xFF);
+			__m128i a = _mm_packs_epi32(_mm_and_si128(v[0], lo),
+						    _mm_and_si128(v[1], lo));
+			__m128i b = _mm_packs_epi32(_mm_and_si128(v[2], lo),
+						    _mm_and_si128(v[3], lo));
+			_mm_storeu_si128((__m128i *)d, _mm_packus_epi16(a, b));
+		} else {
+			/* 8 -> 4 */
+			for (size_t k = 0U; k < 2U; ++k) {
+				__m128 a = _mm_castsi128_ps(v[2U * k]);
+				__m128 b = _mm_castsi128_ps(v[2U * k + 1U]);
+				_mm_storeu_si128(
+				    (__m128i *)(d + 16U * k),
+				    _mm_castps_si128(_mm_shuffle_ps(
+					a, b, _MM_SHUFFLE(2, 0, 2, 0))));
+			}
+		}
+		s += 64U;
+		d += step * dst_size;
+	}
+	return i;
+}
+#endif
+
+#if defined(CAST_WITH_AVX2)
+CAST_TARGET_AVX2 static inline __m256i
+cast_avx2_set1(uint64_t value, size_t size)
+{
+	switch (size) {
+	case 1U:
+		return _mm256_set1_epi8((char)(uint8_t)value);
+	case 2U:
+		return _mm256_set1_epi16((short)(uint16_t)value);
+	case 4U:
+		return _mm256_set1_epi32((int)(uint32_t)value);
+	default:
+		return _mm256_set1_epi64x((long long)value);
+	}
+}
+
+CAST_TARGET_AVX2 static inline __m256i
+cast_avx2_add(__m256i a, __m256i b, size_t size)
+{
+	switch (size) {
+	case 1U:
+		return _mm256_add_epi8(a, b);
+	case 2U:
+		return _mm256_add_epi16(a, b);
+	case 4U:
+		return _mm256_add_epi32(a, b);
+	default:
+		return _mm256_add_epi64(a, b);
+	}
+}
+
+/**
+ * AVX2 version of cast_sse2_narrow(), working on blocks of 128 source bytes.
+ */
+CAST_TARGET_AVX2 static inline size_t
+cast_avx2_narrow(void *dst, size_t dst_size,
+				      const void *src, size_t src_size,
+				      size_t n, uint64_t bias, uint64_t mask)
+{
+	const __m256i vbias = cast_avx2_set1(bias, src_size);
+	const __m256i vmask = cast_avx2_set1(mask, src_size);
+	const size_t step = 128U / src_size;
+	const unsigned char *s = (const unsigned char *)src;
+	unsigned char *d = (unsigned char *)dst;
+	size_t i = 0U;
+
+	for (; n - i >= step; i += step) {
+		__m256i v[4];
+		__m256i acc = _mm256_setzero_si256();
+		for (size_t k = 0U; k < 4U; ++k) {
+			v[k] = _mm256_loadu_si256(
+			    (const __m256i *)(s + 32U * k));
+			acc = _mm256_or_si256(
+			    acc, _mm256_and_si256(cast_avx2_add(v[k], vbias,
+								src_size),
+						  vmask));
+		}
+		if (!_mm256_testz_si256(acc, acc))
+			break;
+
+		if (src_size == dst_size) {
+			for (size_t k = 0U; k < 4U; ++k)
+				_mm256_storeu_si256((__m256i *)(d + 32U * k),
+						    v[k]);
+		} else if (src_size == 2U && dst_size == 1U) {
+			const __m256i lo = _mm256_set1_epi16(0xFF);
+			for (size_t k = 0U; k < 2U; ++k) {
+				__m256i a = _mm256_and_si256(v[2U * k], lo);
+				__m256i b =
+				    _mm256_and_si256(v[2U * k + 1U], lo);
+				_mm256_storeu_si256(
+				    (__m256i *)(d + 32U * k),
+				    _mm256_permute4x64_epi64(
+					_mm256_packus_epi16(a, b), 0xD8));
+			}
+		} else if (src_size == 4U && dst_size == 2U) {
+			const __m256i lo = _mm256_set1_epi32(0xFFFF);
+			for (size_t k = 0U; k < 2U; ++k) {
+				__m256i a = _mm256_and_si256(v[2U * k], lo);
+				__m256i b =
+				    _mm256_and_si256(v[2U * k + 1U], lo);
+				_mm256_storeu_si256(
+				    (__m256i *)(d + 32U * k),
+				    _mm256_permute4x64_epi64(
+					_mm256_packus_epi32(a, b), 0xD8));
+			}
+		} else if (src_size == 4U && dst_size == 1U) {
+			const __m256i lo = _mm256_set1_epi32(0xFF);
+			const __m256i order =
+			    _mm256_setr_epi32(0, 4, 1, 5, 2, 6, 3, 7);
+			__m256i a = _mm256_packus_epi32(
+			    _mm256_and_si256(v[0], lo),
+			    _mm256_and_si256(v[1], lo));
+			__m256i b = _mm256_packus_epi32(
+			    _mm256_and_si256(v[2], lo),
+			    _mm256_and_si256(v[3], lo));
+			_mm256_storeu_si256(
+			    (__m256i *)d,
+			    _mm256_permutevar8x32_epi32(
+				_mm256_packus_epi16(a, b), order));
+		} else {
+			/* 8 -> 4 */
+			const __m256i order =
+			    _mm256_setr_epi32(0, 2, 4, 6, 1, 3, 5, 7);
+			for (size_t k = 0U; k < 2U; ++k) {
+				__m256i a = _mm256_permutevar8x32_epi32(
+				    v[2U * k], order);
+				__m256i b = _mm256_permutevar8x32_epi32(
+				    v[2U * k + 1U], order);
+				_mm256_storeu_si256(
+				    (__m256i *)(d + 32U * k),
+				    _mm256_permute2x128_si256(a, b, 0x20));
+			}
+		}
+		s += 128U;
+		d += step * dst_size;
+	}
+	return i;
+}
+#endif
+
+#if defined(CAST_WITH_SSE2)
+/**
+ * Check if `n` elements of `src_size` bytes fit a range, which is described
+ * by bias and mask as in cast_sse2_narrow().
+ *
+ * @param src          Source array.
+ * @param src_size     Size of source element.
+ * @param n            Number of elements in `src`.
+ * @param bias         Value added to each element before masking.
+ * @param mask         Bits that must be zero after adding bias.
+ * @param full         Whether to scan all elements before checking the result
+ *                     instead of stopping at the first block which does not
+ *                     fit.
+ *
+ * @return Number of leading elements which fit or SIZE_MAX if any of checked
+ *         elements does not fit.
+ */
+CAST_TARGET_SSE2 static inline size_t
+cast_sse2_fits(const void *src, size_t src_size, size_t n, uint64_t bias,
+	       uint64_t mask, bool full)
+{
+	const __m128i vbias = cast_sse2_set1(bias, src_size);
+	const __m128i vmask = cast_sse2_set1(mask, src_size);
+	const __m128i zero = _mm_setzero_si128();
+	const size_t step = 64U / src_size;
+	const unsigned char *s = (const unsigned char *)src;
+	__m128i acc = zero;
+	size_t i = 0U;
+
+	for (; n - i >= step; i += step) {
+		for (size_t k = 0U; k < 4U; ++k) {
+			__m128i v =
+			    _mm_loadu_si128((const __m128i *)(s + 16U * k));
+			acc = _mm_or_si128(
+			    acc, _mm_and_si128(cast_sse2_add(v, vbias,
+							     src_size),
+					       vmask));
+		}
+		if (!full &&
+		    _mm_movemask_epi8(_mm_cmpeq_epi8(acc, zero)) != 0xFFFF)
+			return SIZE_MAX;
+		s += 64U;
+	}
+	if (_mm_movemask_epi8(_mm_cmpeq_epi8(acc, zero)) != 0xFFFF)
+		return SIZE_MAX;
+	return i;
+}
+#endif
+
+#if defined(CAST_WITH_AVX2)
+/**
+ * AVX2 version of cast_sse2_fits(), working on blocks of 128 source bytes.
+ */
+CAST_TARGET_AVX2 static inline size_t
+cast_avx2_fits(const void *src, size_t src_size, size_t n, uint64_t bias,
+	       uint64_t mask, bool full)
+{
+	const __m256i vbias = cast_avx2_set1(bias, src_size);
+	const __m256i vmask = cast_avx2_set1(mask, src_size);
+	const size_t step = 128U / src_size;
+	const unsigned char *s = (const unsigned char *)src;
+	__m256i acc = _mm256_setzero_si256();
+	size_t i = 0U;
+
+	for (; n - i >= step; i += step) {
+		for (size_t k = 0U; k < 4U; ++k) {
+			__m256i v = _mm256_loadu_si256(
+			    (const __m256i *)(s + 32U * k));
+			acc = _mm256_or_si256(
+			    acc, _mm256_and_si256(cast_avx2_add(v, vbias,
+								src_size),
+						  vmask));
+		}
+		if (!full && !_mm256_testz_si256(acc, acc))
+			return SIZE_MAX;
+		s += 128U;
+	}
+	if (!_mm256_testz_si256(acc, acc))
+		return SIZE_MAX;
+	return i;
+}
+#endif
+
+/**
+ * Convert leading elements of an integer array using SIMD instructions of
+ * the given level.
+ *
+ * Only narrowing conversions and conversions between types of the same size
+ * are vectorized here, remaining elements are left to the caller.
+ *
+ * @param isa          Instruction set level to use.
+ * @param dst          Destination array.
+ * @param dst_size     Size of destination element.
+ * @param src          Source array.
+ * @param src_size     Size of source element.
+ * @param n            Number of elements in `src`.
+ * @param lo           Smallest valid source value, sign extended.
+ * @param hi           Largest valid source value, sign extended.
+ *
+ * @return Number of leading elements which were converted.
+ */
+static inline size_t cast_array_simd_narrow(enum cast_isa isa, void *dst,
+					    size_t dst_size, const void *src,
+					    size_t src_size, size_t n,
+					    uint64_t lo, uint64_t hi)
+{
+	if (dst_size > src_size || (src_size == 8U && dst_size < 4U))
+		return 0U;
+
+#if defined(CAST_WITH_AVX2)
+	if (isa >= CAST_ISA_AVX2)
+		return cast_avx2_narrow(dst, dst_size, src, src_size, n,
+					0U - lo, ~(hi - lo));
+#endif
+#if defined(CAST_WITH_SSE2)
+	if (isa >= CAST_ISA_SSE2)
+		return cast_sse2_narrow(dst, dst_size, src, src_size, n,
+					0U - lo, ~(hi - lo));
+#endif
+	(void)isa;
+	(void)dst;
+	(void)src;
+	(void)n;
+	(void)lo;
+	(void)hi;
+	return 0U;
+}
+
+#if defined(CAST_WITH_SSE2)
+/**
+ * Store `count` vectors of 32-bit integers as elements of `dst_size` bytes.
+ *
+ * Values must already fit destination type, `count` must be even unless
+ * `dst_size` is 4.
+ */
+CAST_TARGET_SSE2 static inline void
+cast_sse2_store_i32(unsigned char *d, size_t dst_size,
+				       const __m128i *v, size_t count)
+{
+	if (dst_size == 4U) {
+		for (size_t k = 0U; k < count; ++k)
+			_mm_storeu_si128((__m128i *)(d + 16U * k), v[k]);
+		return;
+	}
+	for (size_t k = 0U; k < count; k += 2U) {
+		if (dst_size == 2U) {
+			__m128i a = _mm_srai_epi32(_mm_slli_epi32(v[k], 16), 16);
+			__m128i b =
+			    _mm_srai_epi32(_mm_slli_epi32(v[k + 1U], 16), 16);
+			_mm_storeu_si128((__m128i *)(d + 8U * k),
+					 _mm_packs_epi32(a, b));
+		} else {
+			const __m128i lo = _mm_set1_epi32(0xFF);
+			__m128i w = _mm_packs_epi32(_mm_and_si128(v[k], lo),
+						    _mm_and_si128(v[k + 1U], lo));
+			_mm_storel_epi64((__m128i *)(d + 4U * k),
+					 _mm_packus_epi16(w, w));
+		}
+	}
+}
+
+/**
+ * Convert floats in range [lo, hi) to integers of `dst_size` bytes.
+ *
+ * Integrality is checked by truncating to 32-bit integer and converting the
+ * result back, so [lo, hi) must be within the range of int32_t.
+ *
+ * @return Number of leading elements which were converted.
+ */
+CAST_TARGET_SSE2 static inline size_t
+cast_sse2_from_float(void *dst, size_t dst_size,
+					  const float *src, size_t n, float lo,
+					  float hi)
+{
+	const __m128 vlo = _mm_set1_ps(lo);
+	const __m128 vhi = _mm_set1_ps(hi);
+	unsigned char *d = (unsigned char *)dst;
+	size_t i = 0U;
+
+	for (; n - i >= 16U; i += 16U) {
+		__m128i t[4];
+		int ok = 0xF;
+		for (size_t k = 0U; k < 4U; ++k) {
+			__m128 x = _mm_loadu_ps(src + i + 4U * k);
+			__m128 in = _mm_and_ps(_mm_cmpge_ps(x, vlo),
+					       _mm_cmplt_ps(x, vhi));
+			/* Out of range lanes are masked to zero */
+			t[k] = _mm_cvttps_epi32(_mm_and_ps(x, in));
+			ok &= _mm_movemask_ps(_mm_and_ps(
+			    in, _mm_cmpeq_ps(_mm_cvtepi32_ps(t[k]), x)));
+		}
+		if (ok != 0xF)
+			break;
+		cast_sse2_store_i32(d + i * dst_size, dst_size, t, 4U);
+	}
+	return i;
+}
+
+/**
+ * Convert doubles in range [lo, hi) to integers of `dst_size` bytes.
+ *
+ * @see cast_sse2_from_float()
+ */
+CAST_TARGET_SSE2 static inline size_t
+cast_sse2_from_double(void *dst, size_t dst_size,
+					   const double *src, size_t n,
+					   double lo, double hi)
+{
+	const __m128d vlo = _mm_set1_pd(lo);
+	const __m128d vhi = _mm_set1_pd(hi);
+	unsigned char *d = (unsigned char *)dst;
+	size_t i = 0U;
+
+	for (; n - i >= 8U; i += 8U) {
+		__m128i t[4];
+		int ok = 0x3;
+		for (size_t k = 0U; k < 4U; ++k) {
+			__m128d x = _mm_loadu_pd(src + i + 2U * k);
+			__m128d in = _mm_and_pd(_mm_cmpge_pd(x, vlo),
+						_mm_cmplt_pd(x, vhi));
+			t[k] = _mm_cvttpd_epi32(_mm_and_pd(x, in));
+			ok &= _mm_movemask_pd(_mm_and_pd(
+			    in, _mm_cmpeq_pd(_mm_cvtepi32_pd(t[k]), x)));
+		}
+		if (ok != 0x3)
+			break;
+		__m128i v[2] = {_mm_unpacklo_epi64(t[0], t[1]),
+				_mm_unpacklo_epi64(t[2], t[3])};
+		cast_sse2_store_i32(d + i * dst_size, dst_size, v, 2U);
+	}
+	return i;
+}
+#endif
+
+#if defined(CAST_WITH_AVX2)
+/**
+ * AVX2 version of cast_sse2_from_float().
+ */
+CAST_TARGET_AVX2 static inline size_t
+cast_avx2_from_float(void *dst, size_t dst_size,
+					  const float *src, size_t n, float lo,
+					  float hi)
+{
+	const __m256 vlo = _mm256_set1_ps(lo);
+	const __m256 vhi = _mm256_set1_ps(hi);
+	unsigned char *d = (unsigned char *)dst;
+	size_t i = 0U;
+
+	for (; n - i >= 32U; i += 32U) {
+		__m128i t[8];
+		int ok = 0xFF;
+		for (size_t k = 0U; k < 4U; ++k) {
+			__m256 x = _mm256_loadu_ps(src + i + 8U * k);
+			__m256 in =
+			    _mm256_and_ps(_mm256_cmp_ps(x, vlo, _CMP_GE_OQ),
+					  _mm256_cmp_ps(x, vhi, _CMP_LT_OQ));
+			__m256i v = _mm256_cvttps_epi32(_mm256_and_ps(x, in));
+			ok &= _mm256_movemask_ps(_mm256_and_ps(
+			    in, _mm256_cmp_ps(_mm256_cvtepi32_ps(v), x,
+					      _CMP_EQ_OQ)));
+			t[2U * k] = _mm256_castsi256_si128(v);
+			t[2U * k + 1U] = _mm256_extracti128_si256(v, 1);
+		}
+		if (ok != 0xFF)
+			break;
+		cast_sse2_store_i32(d + i * dst_size, dst_size, t, 8U);
+	}
+	return i;
+}
+
+/**
+ * AVX2 version of cast_sse2_from_double().
+ */
+CAST_TARGET_AVX2 static inline size_t
+cast_avx2_from_double(void *dst, size_t dst_size,
+					   const double *src, size_t n,
+					   double lo, double hi)
+{
+	const __m256d vlo = _mm256_set1_pd(lo);
+	const __m256d vhi = _mm256_set1_pd(hi);
+	unsigned char *d = (unsigned char *)dst;
+	size_t i = 0U;
+
+	for (; n - i >= 16U; i += 16U) {
+		__m128i t[4];
+		int ok = 0xF;
+		for (size_t k = 0U; k < 4U; ++k) {
+			__m256d x = _mm256_loadu_pd(src + i + 4U * k);
+			__m256d in =
+			    _mm256_and_pd(_mm256_cmp_pd(x, vlo, _CMP_GE_OQ),
+					  _mm256_cmp_pd(x, vhi, _CMP_LT_OQ));
+			t[k] = _mm256_cvttpd_epi32(_mm256_and_pd(x, in));
+			ok &= _mm256_movemask_pd(_mm256_and_pd(
+			    in, _mm256_cmp_pd(_mm256_cvtepi32_pd(t[k]), x,
+					      _CMP_EQ_OQ)));
+		}
+		if (ok != 0xF)
+			break;
+		cast_sse2_store_i32(d + i * dst_size, dst_size, t, 4U);
+	}
+	return i;
+}
+#endif
+
+#if defined(CAST_WITH_AVX512)
+/**
+ * Convert doubles in range [lo, hi) to 64-bit integers.
+ *
+ * @return Number of leading elements which were converted.
+ */
+CAST_TARGET_AVX512 static inline size_t
+cast_avx512_from_double(void *dst, bool dst_signed,
+					     const double *src, size_t n,
+					     double lo, double hi)
+{
+	const __m512d vlo = _mm512_set1_pd(lo);
+	const __m512d vhi = _mm512_set1_pd(hi);
+	unsigned char *d = (unsigned char *)dst;
+	size_t i = 0U;
+
+	for (; n - i >= 8U; i += 8U) {
+		__m512d x = _mm512_loadu_pd(src + i);
+		__mmask8 in = _mm512_cmp_pd_mask(x, vlo, _CMP_GE_OQ) &
+			      _mm512_cmp_pd_mask(x, vhi, _CMP_LT_OQ);
+		__m512i t;
+		__m512d back;
+		if (dst_signed) {
+			t = _mm512_maskz_cvttpd_epi64(in, x);
+			back = _mm512_cvtepi64_pd(t);
+		} else {
+			t = _mm512_maskz_cvttpd_epu64(in, x);
+			back = _mm512_cvtepu64_pd(t);
+		}
+		if (_mm512_mask_cmp_pd_mask(in, back, x, _CMP_EQ_OQ) != 0xFF)
+			break;
+		_mm512_storeu_si512((void *)(d + 8U * i), t);
+	}
+	return i;
+}
+
+/**
+ * Convert floats in range [lo, hi) to 64-bit integers.
+ *
+ * @return Number of leading elements which were converted.
+ */
+CAST_TARGET_AVX512 static inline size_t
+cast_avx512_from_float(void *dst, bool dst_signed,
+					    const float *src, size_t n,
+					    float lo, float hi)
+{
+	const __m256 vlo = _mm256_set1_ps(lo);
+	const __m256 vhi = _mm256_set1_ps(hi);
+	unsigned char *d = (unsigned char *)dst;
+	size_t i = 0U;
+
+	for (; n - i >= 8U; i += 8U) {
+		__m256 x = _mm256_loadu_ps(src + i);
+		__m256 in =
+		    _mm256_and_ps(_mm256_cmp_ps(x, vlo, _CMP_GE_OQ),
+				  _mm256_cmp_ps(x, vhi, _CMP_LT_OQ));
+		__m256 safe = _mm256_and_ps(x, in);
+		__m512i t;
+		__m256 back;
+		if (dst_signed) {
+			t = _mm512_cvttps_epi64(safe);
+			back = _mm512_cvtepi64_ps(t);
+		} else {
+			t = _mm512_cvttps_epu64(safe);
+			back = _mm512_cvtepu64_ps(t);
+		}
+		if (_mm256_movemask_ps(_mm256_and_ps(
+			in, _mm256_cmp_ps(back, x, _CMP_EQ_OQ))) != 0xFF)
+			break;
+		_mm512_storeu_si512((void *)(d + 8U * i), t);
+	}
+	return i;
+}
+#endif
+
+/**
+ * Check if leading elements of an integer array fit range [lo, hi] using SIMD
+ * instructions of the given level.
+ *
+ * @param isa          Instruction set level to use.
+ * @param src          Source array.
+ * @param src_size     Size of source element.
+ * @param n            Number of elements in `src`.
+ * @param lo           Smallest valid source value, sign extended.
+ * @param hi           Largest valid source value, sign extended.
+ * @param full         Whether to scan all elements, even if some of them
+ *                     don't fit.
+ *
+ * @return Number of leading elements which fit or SIZE_MAX if any of checked
+ *         elements does not fit.
+ */
+static inline size_t cast_array_simd_fits(enum cast_isa isa, const void *src,
+					  size_t src_size, size_t n,
+					  uint64_t lo, uint64_t hi, bool full)
+{
+#if defined(CAST_WITH_AVX2)
+	if (isa >= CAST_ISA_AVX2)
+		return cast_avx2_fits(src, src_size, n, 0U - lo, ~(hi - lo),
+				      full);
+#endif
+#if defined(CAST_WITH_SSE2)
+	if (isa >= CAST_ISA_SSE2)
+		return cast_sse2_fits(src, src_size, n, 0U - lo, ~(hi - lo),
+				      full);
+#endif
+	(void)isa;
+	(void)src;
+	(void)src_size;
+	(void)n;
+	(void)lo;
+	(void)hi;
+	(void)full;
+	return 0U;
+}
+
+/**
+ * Find minimum and maximum of array with at least one element.
+ *
+ * @param type         Element type.
+ * @param src          Source array.
+ * @param n            Number of elements in `src`.
+ * @param min          Variable holding minimum, initialized to `src[0]`.
+ * @param max          Variable holding maximum, initialized to `src[0]`.
+ */
+#define CAST_MINMAX_LOOP(type, src, n, min, max)                               \
+	do {                                                                   \
+		for (size_t i_ = 1U; i_ < (n); ++i_) {                         \
+			type v_ = (src)[i_];                                   \
+			min = v_ < min ? v_ : min;                             \
+			max = v_ > max ? v_ : max;                             \
+		}                                                              \
+	} while (0)
+
+/**
+ * Convert leading elements of a float array to integers of `dst_size` bytes
+ * using SIMD instructions of the given level.
+ *
+ * @param isa          Instruction set level to use.
+ * @param dst          Destination array.
+ * @param dst_size     Size of destination element.
+ * @param src          Source array.
+ * @param n            Number of elements in `src`.
+ * @param lo           Smallest valid source value.
+ * @param hi           Smallest source value which is too large.
+ *
+ * @return Number of leading elements which were converted.
+ */
+static inline size_t cast_array_simd_from_float(enum cast_isa isa, void *dst,
+						size_t dst_size,
+						const float *src, size_t n,
+						float lo, float hi)
+{
+#if defined(CAST_WITH_AVX512)
+	if (isa >= CAST_ISA_AVX512 && dst_size == 8U)
+		return cast_avx512_from_float(dst, lo < 0.0f, src, n, lo, hi);
+#endif
+	if (dst_size == 8U || hi > 0x1p31f)
+		return 0U;
+#if defined(CAST_WITH_AVX2)
+	if (isa >= CAST_ISA_AVX2)
+		return cast_avx2_from_float(dst, dst_size, src, n, lo, hi);
+#endif
+#if defined(CAST_WITH_SSE2)
+	if (isa >= CAST_ISA_SSE2)
+		return cast_sse2_from_float(dst, dst_size, src, n, lo, hi);
+#endif
+	(void)isa;
+	(void)dst;
+	(void)src;
+	(void)n;
+	(void)lo;
+	return 0U;
+}
+
+/**
+ * Double version of cast_array_simd_from_float().
+ */
+static inline size_t cast_array_simd_from_double(enum cast_isa isa, void *dst,
+						 size_t dst_size,
+						 const double *src, size_t n,
+						 double lo, double hi)
+{
+#if defined(CAST_WITH_AVX512)
+	if (isa >= CAST_ISA_AVX512 && dst_size == 8U)
+		return cast_avx512_from_double(dst, lo < 0.0, src, n, lo, hi);
+#endif
+	if (dst_size == 8U || hi > 0x1p31)
+		return 0U;
+#if defined(CAST_WITH_AVX2)
+	if (isa >= CAST_ISA_AVX2)
+		return cast_avx2_from_double(dst, dst_size, src, n, lo, hi);
+#endif
+#if defined(CAST_WITH_SSE2)
+	if (isa >= CAST_ISA_SSE2)
+		return cast_sse2_from_double(dst, dst_size, src, n, lo, hi);
+#endif
+	(void)isa;
+	(void)dst;
+	(void)src;
+	(void)n;
+	(void)lo;
+	return 0U;
+}
+
+#if defined(CAST_WITH_SSE2)
+/**
+ * Convert 32-bit integers to floats, stopping at the first block with a value
+ * which can't be represented exactly. Exactness is checked by converting each
+ * float back and comparing it with the source value. Unsigned values above
+ * INT32_MAX are left to the caller.
+ *
+ * @return Number of leading elements which were converted.
+ */
+CAST_TARGET_SSE2 static inline size_t
+cast_sse2_float_from_32(float *dst, const void *src,
+					     bool src_signed, size_t n)
+{
+	const __m128i sign = _mm_set1_epi32(src_signed ? 0 : INT32_MIN);
+	const __m128i zero = _mm_setzero_si128();
+	const unsigned char *s = (const unsigned char *)src;
+	size_t i = 0U;
+
+	for (; n - i >= 16U; i += 16U) {
+		__m128 f[4];
+		__m128i acc = _mm_cmpeq_epi32(zero, zero);
+		for (size_t k = 0U; k < 4U; ++k) {
+			__m128i x = _mm_loadu_si128(
+			    (const __m128i *)(s + 4U * i + 16U * k));
+			f[k] = _mm_cvtepi32_ps(x);
+			acc = _mm_and_si128(
+			    acc, _mm_cmpeq_epi32(_mm_cvttps_epi32(f[k]), x));
+			acc = _mm_and_si128(
+			    acc,
+			    _mm_cmpeq_epi32(_mm_and_si128(x, sign), zero));
+		}
+		if (_mm_movemask_epi8(acc) != 0xFFFF)
+			break;
+		for (size_t k = 0U; k < 4U; ++k)
+			_mm_storeu_ps(dst + i + 4U * k, f[k]);
+	}
+	return i;
+}
+
+/**
+ * Convert 64-bit integers to doubles or floats, stopping at the first block
+ * with a value out of range [lo, lo + 2^bits). Range must be chosen so that
+ * all values in it are exact in destination type and bits must be at most 52.
+ *
+ * Conversion adds 1.5 * 2^52 to the integer reinterpreted as double mantissa
+ * and subtracts it back in floating point, which is exact for |x| < 2^51.
+ *
+ * @return Number of leading elements which were converted.
+ */
+CAST_TARGET_SSE2 static inline size_t
+cast_sse2_f_from_64(void *dst, bool to_float,
+					 const void *src, size_t n,
+					 uint64_t lo, unsigned bits)
+{
+	const __m128i bias = _mm_set1_epi64x((long long)(0U - lo));
+	const __m128i mask = _mm_set1_epi64x((long long)~((1ULL << bits) - 1U));
+	const __m128i magic_bits = _mm_set1_epi64x(0x4338000000000000LL);
+	const __m128d magic = _mm_set1_pd(0x1.8p52);
+	const __m128i zero = _mm_setzero_si128();
+	const unsigned char *s = (const unsigned char *)src;
+	unsigned char *d = (unsigned char *)dst;
+	size_t i = 0U;
+
+	for (; n - i >= 8U; i += 8U) {
+		__m128d f[4];
+		__m128i acc = zero;
+		for (size_t k = 0U; k < 4U; ++k) {
+			__m128i x = _mm_loadu_si128(
+			    (const __m128i *)(s + 8U * i + 16U * k));
+			acc = _mm_or_si128(
+			    acc, _mm_and_si128(_mm_add_epi64(x, bias), mask));
+			f[k] = _mm_sub_pd(
+			    _mm_castsi128_pd(_mm_add_epi64(x, magic_bits)),
+			    magic);
+		}
+		if (_mm_movemask_epi8(_mm_cmpeq_epi8(acc, zero)) != 0xFFFF)
+			break;
+		if (to_float) {
+			for (size_t k = 0U; k < 4U; k += 2U)
+				_mm_storeu_ps((float *)(void *)(d + 4U * i +
+								8U * k),
+					      _mm_movelh_ps(
+						  _mm_cvtpd_ps(f[k]),
+						  _mm_cvtpd_ps(f[k + 1U])));
+		} else {
+			for (size_t k = 0U; k < 4U; ++k)
+				_mm_storeu_pd((double *)(void *)(d + 8U * i +
+								 16U * k),
+					      f[k]);
+		}
+	}
+	return i;
+}
+#endif
+
+#if defined(CAST_WITH_AVX2)
+/**
+ * AVX2 version of cast_sse2_float_from_32().
+ */
+CAST_TARGET_AVX2 static inline size_t
+cast_avx2_float_from_32(float *dst, const void *src,
+					     bool src_signed, size_t n)
+{
+	const __m256i sign = _mm256_set1_epi32(src_signed ? 0 : INT32_MIN);
+	const unsigned char *s = (const unsigned char *)src;
+	size_t i = 0U;
+
+	for (; n - i >= 32U; i += 32U) {
+		__m256 f[4];
+		__m256i acc = _mm256_setzero_si256();
+		for (size_t k = 0U; k < 4U; ++k) {
+			__m256i x = _mm256_loadu_si256(
+			    (const __m256i *)(s + 4U * i + 32U * k));
+			f[k] = _mm256_cvtepi32_ps(x);
+			acc = _mm256_or_si256(
+			    acc, _mm256_xor_si256(_mm256_cvttps_epi32(f[k]),
+						  x));
+			acc = _mm256_or_si256(acc, _mm256_and_si256(x, sign));
+		}
+		if (!_mm256_testz_si256(acc, acc))
+			break;
+		for (size_t k = 0U; k < 4U; ++k)
+			_mm256_storeu_ps(dst + i + 8U * k, f[k]);
+	}
+	return i;
+}
+
+/**
+ * AVX2 version of cast_sse2_f_from_64().
+ */
+CAST_TARGET_AVX2 static inline size_t
+cast_avx2_f_from_64(void *dst, bool to_float,
+					 const void *src, size_t n,
+					 uint64_t lo, unsigned bits)
+{
+	const __m256i bias = _mm256_set1_epi64x((long long)(0U - lo));
+	const __m256i mask =
+	    _mm256_set1_epi64x((long long)~((1ULL << bits) - 1U));
+	const __m256i magic_bits = _mm256_set1_epi64x(0x4338000000000000LL);
+	const __m256d magic = _mm256_set1_pd(0x1.8p52);
+	const unsigned char *s = (const unsigned char *)src;
+	unsigned char *d = (unsigned char *)dst;
+	size_t i = 0U;
+
+	for (; n - i >= 16U; i += 16U) {
+		__m256d f[4];
+		__m256i acc = _mm256_setzero_si256();
+		for (size_t k = 0U; k < 4U; ++k) {
+			__m256i x = _mm256_loadu_si256(
+			    (const __m256i *)(s + 8U * i + 32U * k));
+			acc = _mm256_or_si256(
+			    acc, _mm256_and_si256(_mm256_add_epi64(x, bias),
+						  mask));
+			f[k] = _mm256_sub_pd(
+			    _mm256_castsi256_pd(
+				_mm256_add_epi64(x, magic_bits)),
+			    magic);
+		}
+		if (!_mm256_testz_si256(acc, acc))
+			break;
+		for (size_t k = 0U; k < 4U; ++k) {
+			if (to_float)
+				_mm_storeu_ps((float *)(void *)(d + 4U * i +
+								16U * k),
+					      _mm256_cvtpd_ps(f[k]));
+			else
+				_mm256_storeu_pd((double *)(void *)(d + 8U * i +
+								    32U * k),
+						 f[k]);
+		}
+	}
+	return i;
+}
+#endif
+
+#if defined(CAST_WITH_AVX512)
+/**
+ * Convert 64-bit integers to doubles or floats, stopping at the first block
+ * with a value which can't be represented exactly. Exactness is checked by
+ * converting each value back, values rounded to 2^63 (or 2^64 for unsigned
+ * source) are rejected before converting back.
+ *
+ * @return Number of leading elements which were converted.
+ */
+CAST_TARGET_AVX512 static inline size_t
+cast_avx512_f_from_64(void *dst, bool to_float,
+					   const void *src, bool src_signed,
+					   size_t n)
+{
+	const __m512d upper = _mm512_set1_pd(src_signed ? 0x1p63 : 0x1p64);
+	const unsigned char *s = (const unsigned char *)src;
+	unsigned char *d = (unsigned char *)dst;
+	size_t i = 0U;
+
+	for (; n - i >= 8U; i += 8U) {
+		__m512i x = _mm512_loadu_si512((const void *)(s + 8U * i));
+		__m512i back;
+		__mmask8 in;
+		if (to_float) {
+			__m256 f = src_signed ? _mm512_cvtepi64_ps(x)
+					      : _mm512_cvtepu64_ps(x);
+			in = _mm512_cmp_pd_mask(_mm512_cvtps_pd(f), upper,
+						_CMP_LT_OQ);
+			back = src_signed ? _mm512_maskz_cvttps_epi64(in, f)
+					  : _mm512_maskz_cvttps_epu64(in, f);
+			if (_mm512_mask_cmpeq_epi64_mask(in, back, x) != 0xFF)
+				break;
+			_mm256_storeu_ps((float *)(void *)(d + 4U * i), f);
+		} else {
+			__m512d f = src_signed ? _mm512_cvtepi64_pd(x)
+					       : _mm512_cvtepu64_pd(x);
+			in = _mm512_cmp_pd_mask(f, upper, _CMP_LT_OQ);
+			back = src_signed ? _mm512_maskz_cvttpd_epi64(in, f)
+					  : _mm512_maskz_cvttpd_epu64(in, f);
+			if (_mm512_mask_cmpeq_epi64_mask(in, back, x) != 0xFF)
+				break;
+			_mm512_storeu_pd((double *)(void *)(d + 8U * i), f);
+		}
+	}
+	return i;
+}
+#endif
+
+/**
+ * Convert leading elements of an integer array to floating point values
+ * using SIMD instructions of the given level.
+ *
+ * Only conversions which can lose precision are vectorized here, remaining
+ * elements are left to the caller.
+ *
+ * @param isa          Instruction set level to use.
+ * @param dst          Destination array.
+ * @param to_float     Whether destination is float or double array.
+ * @param src          Source array.
+ * @param src_size     Size of source element.
+ * @param src_signed   Whether source type is signed.
+ * @param n            Number of elements in `src`.
+ *
+ * @return Number of leading elements which were converted.
+ */
+static inline size_t cast_array_simd_to_f(enum cast_isa isa, void *dst,
+					  bool to_float, const void *src,
+					  size_t src_size, bool src_signed,
+					  size_t n)
+{
+	if (src_size == 8U) {
+		/* Ranges where every integer is exact in destination type */
+		const unsigned bits = to_float ? (src_signed ? 25U : 24U)
+					       : (src_signed ? 52U : 51U);
+		const uint64_t lo =
+		    src_signed ? 0U - (1ULL << (bits - 1U)) : 0U;
+		(void)lo;
+#if defined(CAST_WITH_AVX512)
+		if (isa >= CAST_ISA_AVX512)
+			return cast_avx512_f_from_64(dst, to_float, src,
+						     src_signed, n);
+#endif
+#if defined(CAST_WITH_AVX2)
+		if (isa >= CAST_ISA_AVX2)
+			return cast_avx2_f_from_64(dst, to_float, src, n, lo,
+						   bits);
+#endif
+#if defined(CAST_WITH_SSE2)
+		if (isa >= CAST_ISA_SSE2)
+			return cast_sse2_f_from_64(dst, to_float, src, n, lo,
+						   bits);
+#endif
+	}
+	if (src_size == 4U && to_float) {
+#if defined(CAST_WITH_AVX2)
+		if (isa >= CAST_ISA_AVX2)
+			return cast_avx2_float_from_32((float *)dst, src,
+						       src_signed, n);
+#endif
+#if defined(CAST_WITH_SSE2)
+		if (isa >= CAST_ISA_SSE2)
+			return cast_sse2_float_from_32((float *)dst, src,
+						       src_signed, n);
+#endif
+	}
+	(void)isa;
+	(void)dst;
+	(void)src;
+	(void)src_signed;
+	(void)n;
+	return 0U;
+}
+
+#endif
+
+/**
+ * Return instruction set level used by array conversions.
+ *
+ * With runtime dispatch the level is selected on first call, it is the best
+ * level supported by the CPU, unless `CAST_FORCE_ISA` environment variable is
+ * set to one of `scalar`, `sse2`, `avx2` or `avx512`, in which case the lower
+ * of the two is used. Without runtime dispatch the level is fixed by the
+ * compiler flags of the translation unit which defines `CAST_IMPLEMENTATION`.
+ *
+ * @return Instruction set level.
+ */
+enum cast_isa cast_isa(void);
+
+/**
+ * Override instruction set level used by array conversions.
+ *
+ * @param isa     Requested level, it is lowered to the best level supported by
+ *                the CPU. Has no effect without runtime dispatch.
+ *
+ * @return Level which will be used.
+ */
+enum cast_isa cast_set_isa(enum cast_isa isa);
+
+/**
+ * Return name of instruction set level.
+ *
+ * @param isa     Instruction set level.
+ *
+ * @return Name of level, as accepted by `CAST_FORCE_ISA`.
+ */
+const char *cast_isa_name(enum cast_isa isa);
+
+#if defined(CAST_DISPATCH)
+/**
+ * Runtime dispatched versions of cast_array_simd_*() functions.
+ */
+size_t cast_kernel_narrow(void *dst, size_t dst_size, const void *src,
+			  size_t src_size, size_t n, uint64_t lo, uint64_t hi);
+size_t cast_kernel_from_float(void *dst, size_t dst_size, const float *src,
+			      size_t n, float lo, float hi);
+size_t cast_kernel_from_double(void *dst, size_t dst_size, const double *src,
+			       size_t n, double lo, double hi);
+size_t cast_kernel_to_f(void *dst, bool to_float, const void *src,
+			size_t src_size, bool src_signed, size_t n);
+size_t cast_kernel_fits(const void *src, size_t src_size, size_t n,
+			uint64_t lo, uint64_t hi, bool full);
+void cast_kernel_minmax(const void *src, size_t size, bool is_signed, size_t n,
+			void *min, void *max);
+
+#define CAST_ARRAY_SIMD(kernel, ...) cast_kernel_##kernel(__VA_ARGS__)
+#else
+#define CAST_ARRAY_SIMD(kernel, ...)                                           \
+	cast_array_simd_##kernel(CAST_ISA_BUILTIN, __VA_ARGS__)
+#endif
+
+#if !defined(CAST_NO_THREADS) && (defined(__unix__) || defined(__APPLE__))
+/* Large arrays can be converted by a pool of POSIX threads */
+#define CAST_PARALLEL
+#endif
+
+/* Smallest source array, in bytes, which is split across threads */
+#ifndef CAST_PARALLEL_MIN_BYTES
+#define CAST_PARALLEL_MIN_BYTES (1U << 20)
+#endif
+
+/* Number of source bytes converted by a thread at once */
+#ifndef CAST_PARALLEL_CHUNK
+#define CAST_PARALLEL_CHUNK (1U << 18)
+#endif
+
+/**
+ * Set number of threads used by parallel array conversions.
+ *
+ * @param threads     Number of threads including the calling one, 0 selects
+ *                    the default, which is the value of `CAST_THREADS`
+ *                    environment variable or the number of online CPUs.
+ *
+ * @return Number of threads which will be used, it is always 1 without thread
+ *         support.
+ */
+unsigned cast_set_threads(unsigned threads);
+
+/**
+ * Return number of threads used by parallel array conversions.
+ *
+ * @return Number of threads including the calling one.
+ */
+unsigned cast_threads(void);
+
+#if defined(CAST_PARALLEL)
+/* Array conversion function with element types erased */
+typedef int (*cast_array_fn)(void *dst, const void *src, size_t n,
+			     size_t *first_bad);
+
+/**
+ * Split array conversion into cache aligned chunks and convert them using
+ * the thread pool.
+ *
+ * Chunks are claimed in order and a chunk is skipped only if it starts after
+ * an element which already failed, so the reported index is always the first
+ * bad element of the whole array. Small arrays are converted by the calling
+ * thread, as well as arrays passed while the pool is busy with a conversion
+ * requested by another thread.
+ *
+ * @param fn           Conversion function for a single chunk.
+ * @param dst          Destination array.
+ * @param dst_size     Size of destination element.
+ * @param src          Source array.
+ * @param src_size     Size of source element.
+ * @param n            Number of elements in `src`.
+ * @param first_bad    Where to store index of the first element which does
+ *                     not fit.
+ *
+ * @return 0 on success, -1 on failure.
+ */
+int cast_parallel_array(cast_array_fn fn, void *dst, size_t dst_size,
+			const void *src, size_t src_size, size_t n,
+			size_t *first_bad);
+
+/**
+ * Define a parallel conversion function for arrays.
+ *
+ * @param dst_type         Destination type.
+ * @param dst_type_name    Destination type name.
+ * @param src_type         Source type.
+ * @param src_type_name    Source type name.
+ */
+#define CAST_DEFINE_TRY_ARRAY_MT(dst_type, dst_type_name, src_type,            \
+				 src_type_name)                                \
+	static inline int                                                      \
+	    cast_array_fn_##dst_type_name##_from_##src_type_name(              \
+		void *dst, const void *src, size_t n, size_t *first_bad)       \
+	{                                                                      \
+		return try_##dst_type_name##_from_##src_type_name##_array(     \
+		    (dst_type *)dst, (const src_type *)src, n, first_bad);     \
+	}                                                                      \
+	static inline int                                                      \
+	    try_##dst_type_name##_from_##src_type_name##_array_mt(             \
+		dst_type *restrict dst, const src_type *restrict src,          \
+		size_t n, size_t *first_bad)                                   \
+	{                                                                      \
+		return cast_parallel_array(                                    \
+		    cast_array_fn_##dst_type_name##_from_##src_type_name, dst, \
+		    sizeof(*dst), src, sizeof(*src), n, first_bad);            \
+	}
+#else
+#define CAST_DEFINE_TRY_ARRAY_MT(dst_type, dst_type_name, src_type,            \
+				 src_type_name)                                \
+	static inline int                                                      \
+	    try_##dst_type_name##_from_##src_type_name##_array_mt(             \
+		dst_type *restrict dst, const src_type *restrict src,          \
+		size_t n, size_t *first_bad)                                   \
+	{                                                                      \
+		return try_##dst_type_name##_from_##src_type_name##_array(     \
+		    dst, src, n, first_bad);                                   \
+	}
+#endif
+
+/* Kinds of values in text columns */
+enum cast_column_kind {
+	CAST_COLUMN_UNSIGNED,
+	CAST_COLUMN_SIGNED,
+	CAST_COLUMN_FLOAT,
+};
+
+/**
+ * Parse column of numbers separated by a delimiter or newlines.
+ *
+ * Integers are decimal with an optional sign, as for try_{T'}_from_strn(),
+ * floating point values are parsed as by cast_try_double_from_strn(). Empty
+ * tokens are errors, except after the last separator. A carriage return at
+ * the end of a token is ignored.
+ *
+ * @param buf          Text to parse, it doesn't have to be NULL-terminated.
+ * @param len          Length of text.
+ * @param delim        Delimiter of values, newline is always a delimiter.
+ * @param out          Where to store values.
+ * @param size         Size of a value.
+ * @param kind         Kind of values.
+ * @param cap          Number of values which fit `out`.
+ * @param count        Where to store the number of parsed values, can be
+ *                     NULL.
+ * @param err_offset   Where to store the offset of the first token which is
+ *                     not valid or doesn't fit `out`, can be NULL.
+ *
+ * @return 0 on success, -1 on failure.
+ */
+int cast_parse_column(const char *buf, size_t len, char delim, void *out,
+		      size_t size, enum cast_column_kind kind, size_t cap,
+		      size_t *count, size_t *err_offset);
+
+/**
+ * Define a function parsing text column into an array.
+ *
+ * @param type         Element type.
+ * @param type_name    Element type name.
+ * @param kind         Kind of values.
+ */
+#define CAST_DEFINE_PARSE_COLUMN(type, type_name, kind)                        \
+	static inline int cast_parse_column_##type_name(                       \
+	    const char *buf, size_t len, char delim, type *out, size_t cap,    \
+	    size_t *count, size_t *err_offset)                                 \
+	{                                                                      \
+		if ((len > 0U && buf == NULL) || (cap > 0U && out == NULL)) {  \
+			if (count)                                             \
+				*count = 0U;                                   \
+			if (err_offset)                                        \
+				*err_offset = 0U;                              \
+			return -1;                                             \
+		}                                                              \
+		return cast_parse_column(buf, len, delim, out, sizeof(*out),   \
+					 kind, cap, count, err_offset);        \
+	}
+
+/**
+ * Define a conversion function for integer arrays.
+ *
+ * @param dst_type         Destination type.
+ * @param dst_type_name    Destination type name.
+ * @param dst_min          Minimum value that fits destination type.
+ * @param dst_max          Maximum value that fits destination type.
+ * @param src_type         Source type.
+ * @param src_type_name    Source type name.
+ * @param src_min          Minimum value that fits source type.
+ * @param src_max          Maximum value that fits source type.
+ */
+#define CAST_DEFINE_TRY_ARRAY_FROM(dst_type, dst_type_name, dst_min, dst_max,  \
+				   src_type, src_type_name, src_min, src_max)  \
+	static inline int try_##dst_type_name##_from_##src_type_name##_array(  \
+	    dst_type *restrict dst, const src_type *restrict src, size_t n,    \
+	    size_t *first_bad)                                                 \
+	{                                                                      \
+		const src_type lo = CAST_ARRAY_LO(src_type, src_min, dst_min); \
+		const src_type hi = CAST_ARRAY_HI(src_type, src_max, dst_max); \
+		if (n > 0U && (dst == NULL || src == NULL)) {                  \
+			if (first_bad)                                         \
+				*first_bad = 0U;                               \
+			return -1;                                             \
+		}                                                              \
+		size_t i = CAST_ARRAY_SIMD(narrow, dst, sizeof(*dst), src,     \
+					   sizeof(*src), n,                    \
+					   (uint64_t)(intmax_t)lo,             \
+					   (uint64_t)(intmax_t)hi);            \
+		for (; n - i >= CAST_ARRAY_BLOCK; i += CAST_ARRAY_BLOCK) {     \
+			unsigned bad = 0U;                                     \
+			for (size_t j = 0U; j < CAST_ARRAY_BLOCK; ++j)         \
+				bad |= (unsigned)((src[i + j] < lo) |          \
+						  (src[i + j] > hi));          \
+			if (bad)                                               \
+				break;                                         \
+			for (size_t j = 0U; j < CAST_ARRAY_BLOCK; ++j)         \
+				dst[i + j] = (dst_type)src[i + j];             \
+		}                                                              \
+		for (; i < n; ++i) {                                           \
+			if (src[i] < lo || src[i] > hi) {                      \
+				if (first_bad)                                 \
+					*first_bad = i;                        \
+				return -1;                                     \
+			}                                                      \
+			dst[i] = (dst_type)src[i];                             \
+		}                                                              \
+		return 0;                                                      \
+	}                                                                      \
+	static inline bool                                                     \
+	    cast_all_fit_##dst_type_name##_from_##src_type_name(               \
+		const src_type *src, size_t n)                                 \
+	{                                                                      \
+		const src_type lo = CAST_ARRAY_LO(src_type, src_min, dst_min); \
+		const src_type hi = CAST_ARRAY_HI(src_type, src_max, dst_max); \
+		if (n > 0U && src == NULL)                                     \
+			return false;                                          \
+		size_t i = CAST_ARRAY_SIMD(fits, src, sizeof(*src), n,         \
+					   (uint64_t)(intmax_t)lo,             \
+					   (uint64_t)(intmax_t)hi, false);     \
+		if (i == SIZE_MAX)                                             \
+			return false;                                          \
+		while (i < n) {                                                \
+			size_t m = n - i < CAST_ARRAY_BLOCK ? n - i            \
+							    : CAST_ARRAY_BLOCK; \
+			unsigned bad = 0U;                                     \
+			for (size_t j = 0U; j < m; ++j)                        \
+				bad |= (unsigned)((src[i + j] < lo) |          \
+						  (src[i + j] > hi));          \
+			if (bad)                                               \
+				return false;                                  \
+			i += m;                                                \
+		}                                                              \
+		return true;                                                   \
+	}                                                                      \
+	static inline bool                                                     \
+	    cast_all_fit_##dst_type_name##_from_##src_type_name##_full(        \
+		const src_type *src, size_t n)                                 \
+	{                                                                      \
+		const src_type lo = CAST_ARRAY_LO(src_type, src_min, dst_min); \
+		const src_type hi = CAST_ARRAY_HI(src_type, src_max, dst_max); \
+		if (n > 0U && src == NULL)                                     \
+			return false;                                          \
+		size_t i = CAST_ARRAY_SIMD(fits, src, sizeof(*src), n,         \
+					   (uint64_t)(intmax_t)lo,             \
+					   (uint64_t)(intmax_t)hi, true);      \
+		if (i == SIZE_MAX)                                             \
+			return false;                                          \
+		unsigned bad = 0U;                                             \
+		for (; i < n; ++i)                                             \
+			bad |= (unsigned)((src[i] < lo) | (src[i] > hi));      \
+		return bad == 0U;                                              \
+	}                                                                      \
+	CAST_DEFINE_TRY_ARRAY_MT(dst_type, dst_type_name, src_type,            \
+				 src_type_name)
+
+/**
+ * Define a function which finds minimum and maximum of an integer array.
+ *
+ * @param type         Element type.
+ * @param type_name    Element type name.
+ */
+#if defined(CAST_DISPATCH)
+#define CAST_DEFINE_MINMAX(type, type_name)                                    \
+	static inline int cast_minmax_##type_name(const type *src, size_t n,   \
+						  type *min, type *max)        \
+	{                                                                      \
+		if (src == NULL || n == 0U)                                    \
+			return -1;                                             \
+		type lo = src[0];                                              \
+		type hi = src[0];                                              \
+		cast_kernel_minmax(src, sizeof(type), CAST_IS_SIGNED(type), n, \
+				   &lo, &hi);                                  \
+		if (min)                                                       \
+			*min = lo;                                             \
+		if (max)                                                       \
+			*max = hi;                                             \
+		return 0;                                                      \
+	}
+#else
+#define CAST_DEFINE_MINMAX(type, type_name)                                    \
+	static inline int cast_minmax_##type_name(const type *src, size_t n,   \
+						  type *min, type *max)        \
+	{                                                                      \
+		if (src == NULL || n == 0U)                                    \
+			return -1;                                             \
+		type lo = src[0];                                              \
+		type hi = src[0];                                              \
+		CAST_MINMAX_LOOP(type, src, n, lo, hi);                        \
+		if (min)                                                       \
+			*min = lo;                                             \
+		if (max)                                                       \
+			*max = hi;                                             \
+		return 0;                                                      \
+	}
+#endif
+
+/**
+ * Define a conversion function for floating point to integer arrays.
+ *
+ * A value converts if it is in range [lo, hi) and converting it to
+ * destination type and back yields the same value.
+ *
+ * @param dst_type         Destination type.
+ * @param dst_type_name    Destination type name.
+ * @param dst_min          Minimum value that fits destination type.
+ * @param dst_max          Maximum value that fits destination type.
+ * @param src_type         Source type.
+ * @param src_type_name    Source type name.
+ */
+#define CAST_DEFINE_TRY_ARRAY_FROM_F(dst_type, dst_type_name, dst_min,         \
+				     dst_max, src_type, src_type_name)         \
+	static inline int try_##dst_type_name##_from_##src_type_name##_array(  \
+	    dst_type *restrict dst, const src_type *restrict src, size_t n,    \
+	    size_t *first_bad)                                                 \
+	{                                                                      \
+		const src_type lo = (src_type)(dst_min);                       \
+		const src_type hi = CAST_ARRAY_F_UPPER(src_type, dst_max);     \
+		if (n > 0U && (dst == NULL || src == NULL)) {                  \
+			if (first_bad)                                         \
+				*first_bad = 0U;                               \
+			return -1;                                             \
+		}                                                              \
+		size_t i = CAST_ARRAY_SIMD(from_##src_type_name, dst,          \
+					   sizeof(*dst), src, n, lo, hi);      \
+		for (; n - i >= CAST_ARRAY_BLOCK; i += CAST_ARRAY_BLOCK) {     \
+			dst_type tmp[CAST_ARRAY_BLOCK];                        \
+			unsigned bad = 0U;                                     \
+			for (size_t j = 0U; j < CAST_ARRAY_BLOCK; ++j) {       \
+				src_type x = src[i + j];                       \
+				unsigned in = (unsigned)((x >= lo) & (x < hi)); \
+				bad |= in ^ 1U;                                \
+				tmp[j] = (dst_type)(in ? x : (src_type)0);     \
+				bad |= (unsigned)((src_type)tmp[j] != x);      \
+			}                                                      \
+			if (bad)                                               \
+				break;                                         \
+			for (size_t j = 0U; j < CAST_ARRAY_BLOCK; ++j)         \
+				dst[i + j] = tmp[j];                           \
+		}                                                              \
+		for (; i < n; ++i) {                                           \
+			if (!(src[i] >= lo && src[i] < hi) ||                  \
+			    (src_type)(dst_type)src[i] != src[i]) {            \
+				if (first_bad)                                 \
+					*first_bad = i;                        \
+				return -1;                                     \
+			}                                                      \
+			dst[i] = (dst_type)src[i];                             \
+		}                                                              \
+		return 0;                                                      \
+	}                                                                      \
+	CAST_DEFINE_TRY_ARRAY_MT(dst_type, dst_type_name, src_type,            \
+				 src_type_name)
+
+/**
+ * Define a family of functions for conversions of integer arrays.
+ *
+ * @param dst_type         Destination type.
+ * @param dst_type_name    Destination type name.
+ * @param dst_min          Minimum value that fits destination type.
+ * @param dst_max          Maximum value that fits destination type.
+ */
+#define CAST_DEFINE_TRY_ARRAY(dst_type, dst_type_name, dst_min, dst_max)       \
+	/* From signed */                                                      \
+	CAST_DEFINE_TRY_ARRAY_FROM(dst_type, dst_type_name, dst_min, dst_max,  \
+				   signed char, schar, SCHAR_MIN, SCHAR_MAX)   \
+	CAST_DEFINE_TRY_ARRAY_FROM(dst_type, dst_type_name, dst_min, dst_max,  \
+				   int8_t, i8, INT8_MIN, INT8_MAX)             \
+	CAST_DEFINE_TRY_ARRAY_FROM(dst_type, dst_type_name, dst_min, dst_max,  \
+				   int16_t, i16, INT16_MIN, INT16_MAX)         \
+	CAST_DEFINE_TRY_ARRAY_FROM(dst_type, dst_type_name, dst_min, dst_max,  \
+				   int32_t, i32, INT32_MIN, INT32_MAX)         \
+	CAST_DEFINE_TRY_ARRAY_FROM(dst_type, dst_type_name, dst_min, dst_max,  \
+				   int64_t, i64, INT64_MIN, INT64_MAX)         \
+	CAST_DEFINE_TRY_ARRAY_FROM(dst_type, dst_type_name, dst_min, dst_max,  \
+				   int, int, INT_MIN, INT_MAX)                 \
+	CAST_DEFINE_TRY_ARRAY_FROM(dst_type, dst_type_name, dst_min, dst_max,  \
+				   short, short, SHRT_MIN, SHRT_MAX)           \
+	CAST_DEFINE_TRY_ARRAY_FROM(dst_type, dst_type_name, dst_min, dst_max,  \
+				   long, long, LONG_MIN, LONG_MAX)             \
+	CAST_DEFINE_TRY_ARRAY_FROM(dst_type, dst_type_name, dst_min, dst_max,  \
+				   long long, llong, LLONG_MIN, LLONG_MAX)     \
+	CAST_DEFINE_TRY_ARRAY_FROM(dst_type, dst_type_name, dst_min, dst_max,  \
+				   ptrdiff_t, ptrdiff, PTRDIFF_MIN,            \
+				   PTRDIFF_MAX)                                \
+	/* From unsigned */                                                    \
+	CAST_DEFINE_TRY_ARRAY_FROM(dst_type, dst_type_name, dst_min, dst_max,  \
+				   unsigned char, uchar, 0, UCHAR_MAX)         \
+	CAST_DEFINE_TRY_ARRAY_FROM(dst_type, dst_type_name, dst_min, dst_max,  \
+				   uint8_t, u8, 0, UINT8_MAX)                  \
+	CAST_DEFINE_TRY_ARRAY_FROM(dst_type, dst_type_name, dst_min, dst_max,  \
+				   uint16_t, u16, 0, UINT16_MAX)               \
+	CAST_DEFINE_TRY_ARRAY_FROM(dst_type, dst_type_name, dst_min, dst_max,  \
+				   uint32_t, u32, 0, UINT32_MAX)               \
+	CAST_DEFINE_TRY_ARRAY_FROM(dst_type, dst_type_name, dst_min, dst_max,  \
+				   uint64_t, u64, 0, UINT64_MAX)               \
+	CAST_DEFINE_TRY_ARRAY_FROM(dst_type, dst_type_name, dst_min, dst_max,  \
+				   unsigned, uint, 0, UINT_MAX)                \
+	CAST_DEFINE_TRY_ARRAY_FROM(dst_type, dst_type_name, dst_min, dst_max,  \
+				   unsigned short, ushort, 0, USHRT_MAX)       \
+	CAST_DEFINE_TRY_ARRAY_FROM(dst_type, dst_type_name, dst_min, dst_max,  \
+				   unsigned long, ulong, 0, ULONG_MAX)         \
+	CAST_DEFINE_TRY_ARRAY_FROM(dst_type, dst_type_name, dst_min, dst_max,  \
+				   unsigned long long, ullong, 0, ULLONG_MAX)  \
+	CAST_DEFINE_TRY_ARRAY_FROM(dst_type, dst_type_name, dst_min, dst_max,  \
+				   size_t, size, 0, SIZE_MAX)                  \
+	CAST_DEFINE_TRY_ARRAY_FROM(dst_type, dst_type_name, dst_min, dst_max,  \
+				   uintptr_t, uptr, 0, UINTPTR_MAX)            \
+	/* From floating point */                                              \
+	CAST_DEFINE_TRY_ARRAY_FROM_F(dst_type, dst_type_name, dst_min,         \
+				     dst_max, float, float)                    \
+	CAST_DEFINE_TRY_ARRAY_FROM_F(dst_type, dst_type_name, dst_min,         \
+				     dst_max, double, double)                  \
+	/* Minimum and maximum */                                              \
+	CAST_DEFINE_MINMAX(dst_type, dst_type_name)                            \
+	/* From text column */                                                 \
+	CAST_DEFINE_PARSE_COLUMN(dst_type, dst_type_name,                      \
+				 CAST_IS_SIGNED(dst_type)                      \
+				     ? CAST_COLUMN_SIGNED                      \
+				     : CAST_COLUMN_UNSIGNED)                   \
+	/* END */
+
+/**
+ * Define a conversion function for integer to floating point arrays.
+ *
+ * A value converts if converting it to floating point type and back yields
+ * the same value.
+ *
+ * @param dst_type         Destination type.
+ * @param dst_type_name    Destination type name.
+ * @param src_type         Source type.
+ * @param src_type_name    Source type name.
+ * @param src_max          Maximum value that fits source type.
+ */
+#define CAST_DEFINE_TRY_F_ARRAY_FROM(dst_type, dst_type_name, src_type,        \
+				     src_type_name, src_max)                   \
+	static inline int try_##dst_type_name##_from_##src_type_name##_array(  \
+	    dst_type *restrict dst, const src_type *restrict src, size_t n,    \
+	    size_t *first_bad)                                                 \
+	{                                                                      \
+		const dst_type hi = CAST_ARRAY_F_UPPER(dst_type, src_max);     \
+		if (n > 0U && (dst == NULL || src == NULL)) {                  \
+			if (first_bad)                                         \
+				*first_bad = 0U;                               \
+			return -1;                                             \
+		}                                                              \
+		if (sizeof(src_type) < sizeof(dst_type)) {                     \
+			for (size_t i = 0U; i < n; ++i)                        \
+				dst[i] = (dst_type)src[i];                     \
+			return 0;                                              \
+		}                                                              \
+		size_t i = CAST_ARRAY_SIMD(                                    \
+		    to_f, dst, sizeof(dst_type) == sizeof(float), src,         \
+		    sizeof(src_type), CAST_IS_SIGNED(src_type), n);            \
+		for (; n - i >= CAST_ARRAY_BLOCK; i += CAST_ARRAY_BLOCK) {     \
+			dst_type tmp[CAST_ARRAY_BLOCK];                        \
+			unsigned bad = 0U;                                     \
+			for (size_t j = 0U; j < CAST_ARRAY_BLOCK; ++j) {       \
+				src_type x = src[i + j];                       \
+				tmp[j] = (dst_type)x;                          \
+				unsigned in = (unsigned)(tmp[j] < hi);         \
+				bad |= in ^ 1U;                                \
+				bad |= (unsigned)((src_type)(                  \
+				    in ? tmp[j] : (dst_type)0) != x);          \
+			}                                                      \
+			if (bad)                                               \
+				break;                                         \
+			for (size_t j = 0U; j < CAST_ARRAY_BLOCK; ++j)         \
+				dst[i + j] = tmp[j];                           \
+		}                                                              \
+		for (; i < n; ++i) {                                           \
+			dst_type tmp = (dst_type)src[i];                       \
+			if (!(tmp < hi) || (src_type)tmp != src[i]) {          \
+				if (first_bad)                                 \
+					*first_bad = i;                        \
+				return -1;                                     \
+			}                                                      \
+			dst[i] = tmp;                                          \
+		}                                                              \
+		return 0;                                                      \
+	}                                                                      \
+	CAST_DEFINE_TRY_ARRAY_MT(dst_type, dst_type_name, src_type,            \
+				 src_type_name)
+
+/**
+ * Define a family of functions for conversions of integer arrays to floating
+ * point arrays.
+ *
+ * @param dst_type         Destination type.
+ * @param dst_type_name    Destination type name.
+ */
+#define CAST_DEFINE_TRY_F_ARRAY(dst_type, dst_type_name)                       \
+	/* From signed */                                                      \
+	CAST_DEFINE_TRY_F_ARRAY_FROM(dst_type, dst_type_name, signed char,     \
+				     schar, SCHAR_MAX)                         \
+	CAST_DEFINE_TRY_F_ARRAY_FROM(dst_type, dst_type_name, int8_t, i8,      \
+				     INT8_MAX)                                 \
+	CAST_DEFINE_TRY_F_ARRAY_FROM(dst_type, dst_type_name, int16_t, i16,    \
+				     INT16_MAX)                                \
+	CAST_DEFINE_TRY_F_ARRAY_FROM(dst_type, dst_type_name, int32_t, i32,    \
+				     INT32_MAX)                                \
+	CAST_DEFINE_TRY_F_ARRAY_FROM(dst_type, dst_type_name, int64_t, i64,    \
+				     INT64_MAX)                                \
+	CAST_DEFINE_TRY_F_ARRAY_FROM(dst_type, dst_type_name, int, int,        \
+				     INT_MAX)                                  \
+	CAST_DEFINE_TRY_F_ARRAY_FROM(dst_type, dst_type_name, short, short,    \
+				     SHRT_MAX)                                 \
+	CAST_DEFINE_TRY_F_ARRAY_FROM(dst_type, dst_type_name, long, long,      \
+				     LONG_MAX)                                 \
+	CAST_DEFINE_TRY_F_ARRAY_FROM(dst_type, dst_type_name, long long,       \
+				     llong, LLONG_MAX)                         \
+	CAST_DEFINE_TRY_F_ARRAY_FROM(dst_type, dst_type_name, ptrdiff_t,       \
+				     ptrdiff, PTRDIFF_MAX)                     \
+	/* From unsigned */                                                    \
+	CAST_DEFINE_TRY_F_ARRAY_FROM(dst_type, dst_type_name, unsigned char,   \
+				     uchar, UCHAR_MAX)                         \
+	CAST_DEFINE_TRY_F_ARRAY_FROM(dst_type, dst_type_name, uint8_t, u8,     \
+				     UINT8_MAX)                                \
+	CAST_DEFINE_TRY_F_ARRAY_FROM(dst_type, dst_type_name, uint16_t, u16,   \
+				     UINT16_MAX)                               \
+	CAST_DEFINE_TRY_F_ARRAY_FROM(dst_type, dst_type_name, uint32_t, u32,   \
+				     UINT32_MAX)                               \
+	CAST_DEFINE_TRY_F_ARRAY_FROM(dst_type, dst_type_name, uint64_t, u64,   \
+				     UINT64_MAX)                               \
+	CAST_DEFINE_TRY_F_ARRAY_FROM(dst_type, dst_type_name, unsigned int,    \
+				     uint, UINT_MAX)                           \
+	CAST_DEFINE_TRY_F_ARRAY_FROM(dst_type, dst_type_name, unsigned short,  \
+				     ushort, USHRT_MAX)                        \
+	CAST_DEFINE_TRY_F_ARRAY_FROM(dst_type, dst_type_name, unsigned long,   \
+				     ulong, ULONG_MAX)                         \
+	CAST_DEFINE_TRY_F_ARRAY_FROM(dst_type, dst_type_name,                  \
+				     unsigned long long, ullong, ULLONG_MAX)   \
+	CAST_DEFINE_TRY_F_ARRAY_FROM(dst_type, dst_type_name, size_t, size,    \
+				     SIZE_MAX)                                 \
+	/* From text column */                                                 \
+	CAST_DEFINE_PARSE_COLUMN(dst_type, dst_type_name, CAST_COLUMN_FLOAT)   \
 	/* END */
 
-CAST_DEFINE_TRY_U(uint8_t, u8, UINT8_MAX)
-CAST_DEFINE_TRY_U(uint16_t, u16, UINT16_MAX)
-CAST_DEFINE_TRY_U(uint32_t, u32, UINT32_MAX)
-CAST_DEFINE_TRY_U(uint64_t, u64, UINT64_MAX)
-CAST_DEFINE_TRY_U(unsigned char, uchar, UCHAR_MAX)
-CAST_DEFINE_TRY_U(unsigned, uint, UINT_MAX)
-CAST_DEFINE_TRY_U(unsigned short, ushort, USHRT_MAX)
-CAST_DEFINE_TRY_U(unsigned long, ulong, ULONG_MAX)
-CAST_DEFINE_TRY_U(unsigned long long, ullong, ULLONG_MAX)
-CAST_DEFINE_TRY_U(size_t, size, SIZE_MAX)
-CAST_DEFINE_TRY_U(uintptr_t, uptr, UINTPTR_MAX)
-#pragma GCC diagnostic push
-#pragma GCC diagnostic ignored "-Wpragmas"
-#pragma GCC diagnostic ignored "-Wtype-limits"
-#pragma GCC diagnostic ignored "-Wtautological-constant-out-of-range-compare"
-CAST_DEFINE_TRY_S(int8_t, i8, INT8)
-CAST_DEFINE_TRY_S(int16_t, i16, INT16)
-CAST_DEFINE_TRY_S(int32_t, i32, INT32)
-CAST_DEFINE_TRY_S(int64_t, i64, INT64)
-CAST_DEFINE_TRY_S(signed char, schar, SCHAR)
-CAST_DEFINE_TRY_S(int, int, INT)
-CAST_DEFINE_TRY_S(short, short, SHRT)
-CAST_DEFINE_TRY_S(long, long, LONG)
-CAST_DEFINE_TRY_S(long long, llong, LLONG)
-CAST_DEFINE_TRY_S(ptrdiff_t, ptrdiff, PTRDIFF)
-#pragma GCC diagnostic pop
-CAST_DEFINE_TRY_F(float, float, 24U)
-CAST_DEFINE_TRY_F(double, double, 54U)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wpragmas"
+#pragma GCC diagnostic ignored "-Wtype-limits"
+#pragma GCC diagnostic ignored "-Wtautological-constant-out-of-range-compare"
+CAST_DEFINE_TRY_ARRAY(uint8_t, u8, 0, UINT8_MAX)
+CAST_DEFINE_TRY_ARRAY(uint16_t, u16, 0, UINT16_MAX)
+CAST_DEFINE_TRY_ARRAY(uint32_t, u32, 0, UINT32_MAX)
+CAST_DEFINE_TRY_ARRAY(uint64_t, u64, 0, UINT64_MAX)
+CAST_DEFINE_TRY_ARRAY(unsigned char, uchar, 0, UCHAR_MAX)
+CAST_DEFINE_TRY_ARRAY(unsigned, uint, 0, UINT_MAX)
+CAST_DEFINE_TRY_ARRAY(unsigned short, ushort, 0, USHRT_MAX)
+CAST_DEFINE_TRY_ARRAY(unsigned long, ulong, 0, ULONG_MAX)
+CAST_DEFINE_TRY_ARRAY(unsigned long long, ullong, 0, ULLONG_MAX)
+CAST_DEFINE_TRY_ARRAY(size_t, size, 0, SIZE_MAX)
+CAST_DEFINE_TRY_ARRAY(uintptr_t, uptr, 0, UINTPTR_MAX)
+CAST_DEFINE_TRY_ARRAY(int8_t, i8, INT8_MIN, INT8_MAX)
+CAST_DEFINE_TRY_ARRAY(int16_t, i16, INT16_MIN, INT16_MAX)
+CAST_DEFINE_TRY_ARRAY(int32_t, i32, INT32_MIN, INT32_MAX)
+CAST_DEFINE_TRY_ARRAY(int64_t, i64, INT64_MIN, INT64_MAX)
+CAST_DEFINE_TRY_ARRAY(signed char, schar, SCHAR_MIN, SCHAR_MAX)
+CAST_DEFINE_TRY_ARRAY(int, int, INT_MIN, INT_MAX)
+CAST_DEFINE_TRY_ARRAY(short, short, SHRT_MIN, SHRT_MAX)
+CAST_DEFINE_TRY_ARRAY(long, long, LONG_MIN, LONG_MAX)
+CAST_DEFINE_TRY_ARRAY(long long, llong, LLONG_MIN, LLONG_MAX)
+CAST_DEFINE_TRY_ARRAY(ptrdiff_t, ptrdiff, PTRDIFF_MIN, PTRDIFF_MAX)
+CAST_DEFINE_TRY_F_ARRAY(float, float)
+CAST_DEFINE_TRY_F_ARRAY(double, double)
+#pragma GCC diagnostic pop
+
+#define CAST_ACCEPTABLE(x)                                                     \
+	_Generic((x),                                                          \
+	    char: (x),                                                         \
+	    signed char: (x),                                                  \
+	    signed short: (x),                                                 \
+	    signed int: (x),                                                   \
+	    signed long: (x),                                                  \
+	    signed long long: (x),                                             \
+	    unsigned char: (x),                                                \
+	    unsigned short: (x),                                               \
+	    unsigned int: (x),                                                 \
+	    unsigned long: (x),                                                \
+	    unsigned long long: (x))
+
+#define CAST_BIT_CAST(To, From, x)                                             \
+	(((union {                                                             \
+		 To to;                                                        \
+		 From from;                                                    \
+	 }){.from = (x)})                                                      \
+	     .to)
+
+/**
+ * Cast integer value to integer type T
+ *
+ * @param x    value to cast
+ *
+ * @return Value converted to a different integer type
+ */
+#define integer_cast(T, x)                                                     \
+	_Generic((T)(0),                                                       \
+	    char: CAST_BIT_CAST(T, unsigned char,                              \
+				(unsigned char)CAST_ACCEPTABLE(x)),            \
+	    signed char: CAST_BIT_CAST(T, unsigned char,                       \
+				       (unsigned char)CAST_ACCEPTABLE(x)),     \
+	    signed short: CAST_BIT_CAST(T, unsigned short,                     \
+					(unsigned short)CAST_ACCEPTABLE(x)),   \
+	    signed int: CAST_BIT_CAST(T, unsigned int,                         \
+				      (unsigned int)CAST_ACCEPTABLE(x)),       \
+	    signed long: CAST_BIT_CAST(T, unsigned long,                       \
+				       (unsigned long)CAST_ACCEPTABLE(x)),     \
+	    signed long long: CAST_BIT_CAST(                                   \
+		     T, unsigned long long,                                    \
+		     (unsigned long long)CAST_ACCEPTABLE(x)),                  \
+	    unsigned char: (unsigned char)CAST_ACCEPTABLE(x),                  \
+	    unsigned short: (unsigned short)CAST_ACCEPTABLE(x),                \
+	    unsigned int: (unsigned int)CAST_ACCEPTABLE(x),                    \
+	    unsigned long: (unsigned long)CAST_ACCEPTABLE(x),                  \
+	    unsigned long long: (unsigned long long)CAST_ACCEPTABLE(x))
+
+#ifdef CAST_IMPLEMENTATION
+#include <stdio.h>
+#include <inttypes.h>
+#include <errno.h>
+#include <float.h>
+#include <stdlib.h>
+#include <stdarg.h>
+#include <stdatomic.h>
+
+#ifndef CAST_CUSTOM_PANIC
+void cast_panic_impl(const char *format, ...)
+{
+	va_list args;
+
+	va_start(args, format);
+	vfprintf(stderr, format, args);
+	va_end(args);
+	exit(1);
+}
+#endif
+
+#define CAST_TYPE_ID_NAME(type_name) #type_name,
+/* Names of types indexed by enum cast_type */
+static const char *const cast_type_names[] = {
+    CAST_TYPE_IDS(CAST_TYPE_ID_NAME)};
+#undef CAST_TYPE_ID_NAME
+
+const char *cast_type_name(enum cast_type type)
+{
+	if ((size_t)type >= sizeof(cast_type_names) / sizeof(cast_type_names[0]))
+		return "unknown";
+	return cast_type_names[type];
+}
+
+/* Handler of threads, which did not push their own, NULL for default */
+static _Atomic(cast_panic_handler) cast_panic_handler_global;
+/* Handlers pushed by the thread */
+static _Thread_local cast_panic_handler
+    cast_panic_handler_stack[CAST_PANIC_HANDLER_DEPTH];
+static _Thread_local unsigned cast_panic_handler_depth;
+/* Innermost pushed handler, kept apart, so panic loads it at once */
+static _Thread_local cast_panic_handler cast_panic_handler_thread;
+
+cast_panic_handler cast_set_panic_handler(cast_panic_handler handler)
+{
+	return atomic_exchange_explicit(&cast_panic_handler_global, handler,
+					memory_order_acq_rel);
+}
+
+int cast_push_panic_handler(cast_panic_handler handler)
+{
+	if (cast_panic_handler_depth >= CAST_PANIC_HANDLER_DEPTH)
+		return -1;
+	cast_panic_handler_stack[cast_panic_handler_depth++] = handler;
+	cast_panic_handler_thread = handler;
+	return 0;
+}
+
+int cast_pop_panic_handler(void)
+{
+	if (cast_panic_handler_depth == 0U)
+		return -1;
+	--cast_panic_handler_depth;
+	cast_panic_handler_thread =
+	    cast_panic_handler_depth
+		? cast_panic_handler_stack[cast_panic_handler_depth - 1U]
+		: NULL;
+	return 0;
+}
+
+#if !defined(CAST_NO_USDT) && defined(__x86_64__) && defined(__linux__) &&     \
+    (defined(__GNUC__) || defined(__clang__))
+/**
+ * Fire USDT probe cast:name with four 8 byte arguments.
+ *
+ * It is a NOP described by a .note.stapsdt entry, in the format used by
+ * sys/sdt.h, so bpftrace, perf and SystemTap can attach to it.
+ */
+#define CAST_PROBE4(name, arg1, arg2, arg3, arg4)                              \
+	__asm__ __volatile__(                                                  \
+	    "990: nop\n"                                                       \
+	    ".pushsection .note.stapsdt, \"?\", \"note\"\n"                    \
+	    ".balign 4\n"                                                      \
+	    ".4byte 992f - 991f, 994f - 993f, 3\n"                             \
+	    "991: .asciz \"stapsdt\"\n"                                        \
+	    "992: .balign 4\n"                                                 \
+	    "993: .8byte 990b\n"                                               \
+	    ".8byte _.stapsdt.base\n"                                          \
+	    ".8byte 0\n"                                                       \
+	    ".asciz \"cast\"\n"                                                \
+	    ".asciz \"" #name "\"\n"                                           \
+	    ".asciz \"8@%0 8@%1 8@%2 8@%3\"\n"                                 \
+	    "994: .balign 4\n"                                                 \
+	    ".popsection\n"                                                    \
+	    ".ifndef _.stapsdt.base\n"                                         \
+	    ".pushsection .stapsdt.base, \"aG\", \"progbits\", "               \
+	    ".stapsdt.base, comdat\n"                                          \
+	    ".weak _.stapsdt.base\n"                                           \
+	    ".hidden _.stapsdt.base\n"                                         \
+	    "_.stapsdt.base: .space 1\n"                                       \
+	    ".size _.stapsdt.base, 1\n"                                        \
+	    ".popsection\n"                                                    \
+	    ".endif"                                                           \
+	    :                                                                  \
+	    : "nor"((uint64_t)(arg1)), "nor"((uint64_t)(arg2)),                \
+	      "nor"((uint64_t)(arg3)), "nor"((uint64_t)(arg4)))
+#else
+#define CAST_PROBE4(name, arg1, arg2, arg3, arg4)                              \
+	((void)(arg1), (void)(arg2), (void)(arg3), (void)(arg4))
+#endif
+
+#if defined(__GNUC__) || defined(__clang__)
+/* Address of code, which called the conversion */
+#define CAST_RETURN_ADDRESS() ((uintptr_t)__builtin_return_address(0))
+#else
+#define CAST_RETURN_ADDRESS() ((uintptr_t)0)
+#endif
+
+/*
+ * Fire cast:panic probe with source type, destination type, bits of source
+ * value and return address.
+ */
+#define CAST_PROBE_PANIC(pair, value)                                          \
+	CAST_PROBE4(panic, (pair) >> 8, (pair)&0xFFU, value,                   \
+		    CAST_RETURN_ADDRESS())
+
+/* Invoke handler of the thread, global handler or cast_panic_impl() */
+static void cast_panic_handle(unsigned pair)
+{
+	cast_panic_handler handler = cast_panic_handler_thread;
+	if (!handler)
+		handler = atomic_load_explicit(&cast_panic_handler_global,
+					       memory_order_acquire);
+	if (handler) {
+		handler((enum cast_type)(pair >> 8),
+			(enum cast_type)(pair & 0xFFU));
+		return;
+	}
+
+	const char *src = cast_type_names[pair >> 8];
+	const char *dst = cast_type_names[pair & 0xFFU];
+	cast_panic_impl("cast: panic in %s_from_%s(): failed to convert %s to "
+			"%s\n",
+			dst, src, src, dst);
+}
+
+void cast_panic_conversion(unsigned pair, uint64_t value)
+{
+	CAST_PROBE_PANIC(pair, value);
+	cast_panic_handle(pair);
+}
+
+void cast_panic_abort(unsigned pair, uint64_t value)
+{
+	CAST_PROBE_PANIC(pair, value);
+	const char *src = cast_type_names[pair >> 8];
+	const char *dst = cast_type_names[pair & 0xFFU];
+	fprintf(stderr,
+		"cast: panic in %s_from_%s(): failed to convert %s to %s\n",
+		dst, src, src, dst);
+	abort();
+}
+
+_Static_assert((CAST_PANIC_LOG_SIZE & (CAST_PANIC_LOG_SIZE - 1U)) == 0U,
+	       "CAST_PANIC_LOG_SIZE has to be a power of two");
+
+/*
+ * Entries of log_continue ring buffer, each one holds index of failure plus
+ * one in upper 48 bits and packed pair of types in lower 16 bits, so readers
+ * can tell if entry was overwritten.
+ */
+static _Atomic uint64_t cast_panic_log_entries[CAST_PANIC_LOG_SIZE];
+/* Number of failures logged so far */
+static atomic_size_t cast_panic_log_head;
+
+void cast_panic_log(unsigned pair, uint64_t value)
+{
+	CAST_PROBE_PANIC(pair, value);
+	size_t index = atomic_fetch_add_explicit(&cast_panic_log_head, 1U,
+						 memory_order_relaxed);
+	uint64_t entry = ((uint64_t)index + 1U) << 16 | (pair & 0xFFFFU);
+	atomic_store_explicit(
+	    &cast_panic_log_entries[index & (CAST_PANIC_LOG_SIZE - 1U)],
+	    entry, memory_order_release);
+}
+
+size_t cast_panic_log_count(void)
+{
+	return atomic_load_explicit(&cast_panic_log_head, memory_order_acquire);
+}
+
+int cast_panic_log_get(size_t index, enum cast_type *src,
+		       enum cast_type *dst)
+{
+	uint64_t entry = atomic_load_explicit(
+	    &cast_panic_log_entries[index & (CAST_PANIC_LOG_SIZE - 1U)],
+	    memory_order_acquire);
+	if (entry >> 16 != (((uint64_t)index + 1U) & 0xFFFFFFFFFFFFU))
+		return -1;
+	if (src)
+		*src = (enum cast_type)(entry >> 8 & 0xFFU);
+	if (dst)
+		*dst = (enum cast_type)(entry & 0xFFU);
+	return 0;
+}
+
+/* Innermost recovery scope of the thread */
+static _Thread_local struct cast_recovery *cast_recovery_top;
+
+void cast_recovery_push(struct cast_recovery *scope)
+{
+	scope->prev = cast_recovery_top;
+	cast_recovery_top = scope;
+}
+
+void cast_recovery_pop(struct cast_recovery *scope)
+{
+	cast_recovery_top = scope->prev;
+}
+
+void cast_panic_longjmp(unsigned pair, uint64_t value)
+{
+	CAST_PROBE_PANIC(pair, value);
+	struct cast_recovery *scope = cast_recovery_top;
+	if (!scope) {
+		cast_panic_handle(pair);
+		return;
+	}
+	scope->src = (enum cast_type)(pair >> 8);
+	scope->dst = (enum cast_type)(pair & 0xFFU);
+	cast_recovery_top = scope->prev;
+	longjmp(scope->env, 1);
+}
+
+int cast_try_ullong_from_str(unsigned long long *dst, const char *str)
+{
+	if (!dst)
+		return -1;
+	if (!str)
+		return -1;
+
+	errno = 0;
+
+	char *endptr;
+	unsigned long long val = strtoull(str, &endptr, 0);
+
+	/* If there is an error */
+	if (errno != 0) {
+		return -1;
+	}
+
+	/* If there are unparsed characters */
+	if (*endptr != '\0') {
+		return -1;
+	}
+
+	/* If there were not characters */
+	if (endptr == str || str[0] == '\0') {
+		return -1;
+	}
+
+	*dst = val;
+
+	return 0;
+}
+
+int cast_try_llong_from_str(long long *dst, const char *str)
+{
+	if (!dst)
+		return -1;
+	if (!str)
+		return -1;
+
+	errno = 0;
+
+	char *endptr;
+	long long val = strtoll(str, &endptr, 0);
+
+	/* If there is an error */
+	if (errno != 0) {
+		return -1;
+	}
+
+	/* If there are unparsed characters */
+	if (*endptr != '\0') {
+		return -1;
+	}
+
+	/* If there were not characters */
+	if (endptr == str || str[0] == '\0') {
+		return -1;
+	}
+
+	*dst = val;
+
+	return 0;
+}
+
+/**
+ * Parse NULL-terminated string of decimal digits, which is a value of type
+ * with at most 32 bits, stopping as soon as the value exceeds `max`.
+ *
+ * Only plain decimal numbers are handled, strings with leading zeros (which
+ * are octal or hexadecimal numbers for strtoull()), signs and whitespace are
+ * left to the caller.
+ *
+ * @param dst   Pointer to variable, where parsed value will be stored.
+ * @param str   NULL-terminated string to parse.
+ * @param max   Largest valid value, it is expected to be a constant.
+ *
+ * @return 0 on success, -1 if string is not a valid number or it is larger
+ *         than `max`, 1 if string has to be parsed by strtoull().
+ */
+static int cast_parse_decimal_str(uint32_t *dst, const char *str,
+				  uint32_t max)
+{
+	uint32_t val = (unsigned)(unsigned char)str[0] - (unsigned)'0';
+	if (val > 9U || (val == 0U && str[1] != '\0'))
+		return 1;
+
+	for (const char *p = str + 1; *p != '\0'; ++p) {
+		unsigned digit = (unsigned)(unsigned char)*p - (unsigned)'0';
+		if (digit > 9U)
+			return -1;
+		if (val > max / 10U || (val == max / 10U && digit > max % 10U))
+			return -1;
+		val = val * 10U + digit;
+	}
+
+	*dst = val;
+	return 0;
+}
+
+/**
+ * Define cast_raw_{T}_from_str() parsing function for unsigned types.
+ *
+ * Types with at most 32 bits parse plain decimal numbers directly, without
+ * going through strtoull().
+ *
+ * @param dst_type         Destination type.
+ * @param dst_type_name    Destination type name.
+ * @param dst_max          Maximum value that fits destination type.
+ */
+#define CAST_DEFINE_RAW_U_FROM_STR(dst_type, dst_type_name, dst_max)           \
+	int cast_raw_##dst_type_name##_from_str(dst_type *dst,                 \
+						const char *str)               \
+	{                                                                      \
+		if (dst_max <= UINT32_MAX && dst != NULL && str != NULL) {     \
+			uint32_t val = 0U;                                     \
+			int ret = cast_parse_decimal_str(                      \
+			    &val, str + (str[0] == '+'), (uint32_t)dst_max);   \
+			if (ret < 0)                                           \
+				return -1;                                     \
+			if (ret == 0) {                                        \
+				*dst = (dst_type)val;                          \
+				return 0;                                      \
+			}                                                      \
+		}                                                              \
+		unsigned long long tmp = 0U;                                   \
+		int ret = cast_try_ullong_from_str(&tmp, str);                 \
+		if (ret)                                                       \
+			return -1;                                             \
+		return cast_raw_##dst_type_name##_from_ullong(dst, tmp);       \
+	}
+
+/**
+ * Define cast_raw_{T}_from_str() parsing function for signed types.
+ *
+ * Types with at most 32 bits parse plain decimal numbers directly, without
+ * going through strtoll().
+ *
+ * @param dst_type         Destination type.
+ * @param dst_type_name    Destination type name.
+ * @param dst_min          Minimum value that fits destination type.
+ * @param dst_max          Maximum value that fits destination type.
+ */
+#define CAST_DEFINE_RAW_S_FROM_STR(dst_type, dst_type_name, dst_min, dst_max)  \
+	int cast_raw_##dst_type_name##_from_str(dst_type *dst,                 \
+						const char *str)               \
+	{                                                                      \
+		if (dst_min >= INT32_MIN && dst_max <= INT32_MAX &&            \
+		    dst != NULL && str != NULL) {                              \
+			bool negative = str[0] == '-';                         \
+			uint32_t val = 0U;                                     \
+			int ret = cast_parse_decimal_str(                      \
+			    &val, str + (negative || str[0] == '+'),           \
+			    negative ? (uint32_t)-(dst_min + 1) + 1U           \
+				     : (uint32_t)dst_max);                     \
+			if (ret < 0)                                           \
+				return -1;                                     \
+			if (ret == 0) {                                        \
+				*dst = negative && val != 0U                   \
+					   ? (dst_type)(-(int32_t)(val - 1U) - \
+							1)                     \
+					   : (dst_type)val;                    \
+				return 0;                                      \
+			}                                                      \
+		}                                                              \
+		long long tmp = 0U;                                            \
+		int ret = cast_try_llong_from_str(&tmp, str);                  \
+		if (ret)                                                       \
+			return -1;                                             \
+		return cast_raw_##dst_type_name##_from_llong(dst, tmp);        \
+	}
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wpragmas"
+#pragma GCC diagnostic ignored "-Wtype-limits"
+#pragma GCC diagnostic ignored "-Wtautological-constant-out-of-range-compare"
+CAST_DEFINE_RAW_U_FROM_STR(uint8_t, u8, UINT8_MAX)
+CAST_DEFINE_RAW_U_FROM_STR(uint16_t, u16, UINT16_MAX)
+CAST_DEFINE_RAW_U_FROM_STR(uint32_t, u32, UINT32_MAX)
+CAST_DEFINE_RAW_U_FROM_STR(uint64_t, u64, UINT64_MAX)
+CAST_DEFINE_RAW_U_FROM_STR(unsigned char, uchar, UCHAR_MAX)
+CAST_DEFINE_RAW_U_FROM_STR(unsigned, uint, UINT_MAX)
+CAST_DEFINE_RAW_U_FROM_STR(unsigned short, ushort, USHRT_MAX)
+CAST_DEFINE_RAW_U_FROM_STR(unsigned long, ulong, ULONG_MAX)
+CAST_DEFINE_RAW_U_FROM_STR(unsigned long long, ullong, ULLONG_MAX)
+CAST_DEFINE_RAW_U_FROM_STR(size_t, size, SIZE_MAX)
+CAST_DEFINE_RAW_U_FROM_STR(uintptr_t, uptr, UINTPTR_MAX)
+CAST_DEFINE_RAW_S_FROM_STR(int8_t, i8, INT8_MIN, INT8_MAX)
+CAST_DEFINE_RAW_S_FROM_STR(int16_t, i16, INT16_MIN, INT16_MAX)
+CAST_DEFINE_RAW_S_FROM_STR(int32_t, i32, INT32_MIN, INT32_MAX)
+CAST_DEFINE_RAW_S_FROM_STR(int64_t, i64, INT64_MIN, INT64_MAX)
+CAST_DEFINE_RAW_S_FROM_STR(signed char, schar, SCHAR_MIN, SCHAR_MAX)
+CAST_DEFINE_RAW_S_FROM_STR(int, int, INT_MIN, INT_MAX)
+CAST_DEFINE_RAW_S_FROM_STR(short, short, SHRT_MIN, SHRT_MAX)
+CAST_DEFINE_RAW_S_FROM_STR(long, long, LONG_MIN, LONG_MAX)
+CAST_DEFINE_RAW_S_FROM_STR(long long, llong, LLONG_MIN, LLONG_MAX)
+CAST_DEFINE_RAW_S_FROM_STR(ptrdiff_t, ptrdiff, PTRDIFF_MIN, PTRDIFF_MAX)
+#pragma GCC diagnostic pop
+
+/* Parameters of IEEE 754 binary floating point format */
+struct cast_float_format {
+	/* Explicitly stored mantissa bits */
+	int mantissa_bits;
+	int exponent_bits;
+	/* Exponent bias, negated */
+	int min_exponent;
+	/* Decimal exponents outside this range are always zero or infinity */
+	int smallest_power_of_ten;
+	int largest_power_of_ten;
+	/* Decimal exponents for which result can be exactly halfway */
+	int min_round_to_even;
+	int max_round_to_even;
+};
+
+static const struct cast_float_format cast_binary32 = {23, 8,   -127, -65,
+							 38, -17, 10};
+static const struct cast_float_format cast_binary64 = {52,   11, -1023, -342,
+							 308, -4, 23};
+
+/* Decimal number split into parts by cast_parse_float_parts() */
+struct cast_float_parts {
+	/* First 19 significant digits */
+	uint64_t mantissa;
+	/* Decimal exponent of mantissa */
+	int64_t exponent;
+	bool negative;
+	/* Whether digits after the first 19 were dropped from mantissa */
+	bool many_digits;
+};
+
+/* Normalized 128-bit approximations of 5^q for q in [-342, 308] */
+static const uint64_t cast_power_of_five_128[][2] = {
+	{0xEEF453D6923BD65AU, 0x113FAA2906A13B3FU},
+	{0x9558B4661B6565F8U, 0x4AC7CA59A424C507U},
+	{0xBAAEE17FA23EBF76U, 0x5D79BCF00D2DF649U},
+	{0xE95A99DF8ACE6F53U, 0xF4D82C2C107973DCU},
+	{0x91D8A02BB6C10594U, 0x79071B9B8A4BE869U},
+	{0xB64EC836A47146F9U, 0x9748E2826CDEE284U},
+	{0xE3E27A444D8D98B7U, 0xFD1B1B2308169B25U},
+	{0x8E6D8C6AB0787F72U, 0xFE30F0F5E50E20F7U},
+	{0xB208EF855C969F4FU, 0xBDBD2D335E51A935U},
+	{0xDE8B2B66B3BC4723U, 0xAD2C788035E61382U},
+	{0x8B16FB203055AC76U, 0x4C3BCB5021AFCC31U},
+	{0xADDCB9E83C6B1793U, 0xDF4ABE242A1BBF3DU},
+	{0xD953E8624B85DD78U, 0xD71D6DAD34A2AF0DU},
+	{0x87D4713D6F33AA6BU, 0x8672648C40E5AD68U},
+	{0xA9C98D8CCB009506U, 0x680EFDAF511F18C2U},
+	{0xD43BF0EFFDC0BA48U, 0x0212BD1B2566DEF2U},
+	{0x84A57695FE98746DU, 0x014BB630F7604B57U},
+	{0xA5CED43B7E3E9188U, 0x419EA3BD35385E2DU},
+	{0xCF42894A5DCE35EAU, 0x52064CAC828675B9U},
+	{0x818995CE7AA0E1B2U, 0x7343EFEBD1940993U},
+	{0xA1EBFB4219491A1FU, 0x1014EBE6C5F90BF8U},
+	{0xCA66FA129F9B60A6U, 0xD41A26E077774EF6U},
+	{0xFD00B897478238D0U, 0x8920B098955522B4U},
+	{0x9E20735E8CB16382U, 0x55B46E5F5D5535B0U},
+	{0xC5A890362FDDBC62U, 0xEB2189F734AA831DU},
+	{0xF712B443BBD52B7BU, 0xA5E9EC7501D523E4U},
+	{0x9A6BB0AA55653B2DU, 0x47B233C92125366EU},
+	{0xC1069CD4EABE89F8U, 0x999EC0BB696E840AU},
+	{0xF148440A256E2C76U, 0xC00670EA43CA250DU},
+	{0x96CD2A865764DBCAU, 0x380406926A5E5728U},
+	{0xBC807527ED3E12BCU, 0xC605083704F5ECF2U},
+	{0xEBA09271E88D976BU, 0xF7864A44C633682EU},
+	{0x93445B8731587EA3U, 0x7AB3EE6AFBE0211DU},
+	{0xB8157268FDAE9E4CU, 0x5960EA05BAD82964U},
+	{0xE61ACF033D1A45DFU, 0x6FB92487298E33BDU},
+	{0x8FD0C16206306BABU, 0xA5D3B6D479F8E056U},
+	{0xB3C4F1BA87BC8696U, 0x8F48A4899877186CU},
+	{0xE0B62E2929ABA83CU, 0x331ACDABFE94DE87U},
+	{0x8C71DCD9BA0B4925U, 0x9FF0C08B7F1D0B14U},
+	{0xAF8E5410288E1B6FU, 0x07ECF0AE5EE44DD9U},
+	{0xDB71E91432B1A24AU, 0xC9E82CD9F69D6150U},
+	{0x892731AC9FAF056EU, 0xBE311C083A225CD2U},
+	{0xAB70FE17C79AC6CAU, 0x6DBD630A48AAF406U},
+	{0xD64D3D9DB981787DU, 0x092CBBCCDAD5B108U},
+	{0x85F0468293F0EB4EU, 0x25BBF56008C58EA5U},
+	{0xA76C582338ED2621U, 0xAF2AF2B80AF6F24EU},
+	{0xD1476E2C07286FAAU, 0x1AF5AF660DB4AEE1U},
+	{0x82CCA4DB847945CAU, 0x50D98D9FC890ED4DU},
+	{0xA37FCE126597973CU, 0xE50FF107BAB528A0U},
+	{0xCC5FC196FEFD7D0CU, 0x1E53ED49A96272C8U},
+	{0xFF77B1FCBEBCDC4FU, 0x25E8E89C13BB0F7AU},
+	{0x9FAACF3DF73609B1U, 0x77B191618C54E9ACU},
+	{0xC795830D75038C1DU, 0xD59DF5B9EF6A2417U},
+	{0xF97AE3D0D2446F25U, 0x4B0573286B44AD1DU},
+	{0x9BECCE62836AC577U, 0x4EE367F9430AEC32U},
+	{0xC2E801FB244576D5U, 0x229C41F793CDA73FU},
+	{0xF3A20279ED56D48AU, 0x6B43527578C1110FU},
+	{0x9845418C345644D6U, 0x830A13896B78AAA9U},
+	{0xBE5691EF416BD60CU, 0x23CC986BC656D553U},
+	{0xEDEC366B11C6CB8FU, 0x2CBFBE86B7EC8AA8U},
+	{0x94B3A202EB1C3F39U, 0x7BF7D71432F3D6A9U},
+	{0xB9E08A83A5E34F07U, 0xDAF5CCD93FB0CC53U},
+	{0xE858AD248F5C22C9U, 0xD1B3400F8F9CFF68U},
+	{0x91376C36D99995BEU, 0x23100809B9C21FA1U},
+	{0xB58547448FFFFB2DU, 0xABD40A0C2832A78AU},
+	{0xE2E69915B3FFF9F9U, 0x16C90C8F323F516CU},
+	{0x8DD01FAD907FFC3BU, 0xAE3DA7D97F6792E3U},
+	{0xB1442798F49FFB4AU, 0x99CD11CFDF41779CU},
+	{0xDD95317F31C7FA1DU, 0x40405643D711D583U},
+	{0x8A7D3EEF7F1CFC52U, 0x482835EA666B2572U},
+	{0xAD1C8EAB5EE43B66U, 0xDA3243650005EECFU},
+	{0xD863B256369D4A40U, 0x90BED43E40076A82U},
+	{0x873E4F75E2224E68U, 0x5A7744A6E804A291U},
+	{0xA90DE3535AAAE202U, 0x711515D0A205CB36U},
+	{0xD3515C2831559A83U, 0x0D5A5B44CA873E03U},
+	{0x8412D9991ED58091U, 0xE858790AFE9486C2U},
+	{0xA5178FFF668AE0B6U, 0x626E974DBE39A872U},
+	{0xCE5D73FF402D98E3U, 0xFB0A3D212DC8128FU},
+	{0x80FA687F881C7F8EU, 0x7CE66634BC9D0B99U},
+	{0xA139029F6A239F72U, 0x1C1FFFC1EBC44E80U},
+	{0xC987434744AC874EU, 0xA327FFB266B56220U},
+	{0xFBE9141915D7A922U, 0x4BF1FF9F0062BAA8U},
+	{0x9D71AC8FADA6C9B5U, 0x6F773FC3603DB4A9U},
+	{0xC4CE17B399107C22U, 0xCB550FB4384D21D3U},
+	{0xF6019DA07F549B2BU, 0x7E2A53A146606A48U},
+	{0x99C102844F94E0FBU, 0x2EDA7444CBFC426DU},
+	{0xC0314325637A1939U, 0xFA911155FEFB5308U},
+	{0xF03D93EEBC589F88U, 0x793555AB7EBA27CAU},
+	{0x96267C7535B763B5U, 0x4BC1558B2F3458DEU},
+	{0xBBB01B9283253CA2U, 0x9EB1AAEDFB016F16U},
+	{0xEA9C227723EE8BCBU, 0x465E15A979C1CADCU},
+	{0x92A1958A7675175FU, 0x0BFACD89EC191EC9U},
+	{0xB749FAED14125D36U, 0xCEF980EC671F667BU},
+	{0xE51C79A85916F484U, 0x82B7E12780E7401AU},
+	{0x8F31CC0937AE58D2U, 0xD1B2ECB8B0908810U},
+	{0xB2FE3F0B8599EF07U, 0x861FA7E6DCB4AA15U},
+	{0xDFBDCECE67006AC9U, 0x67A791E093E1D49AU},
+	{0x8BD6A141006042BDU, 0xE0C8BB2C5C6D24E0U},
+	{0xAECC49914078536DU, 0x58FAE9F773886E18U},
+	{0xDA7F5BF590966848U, 0xAF39A475506A899EU},
+	{0x888F99797A5E012DU, 0x6D8406C952429603U},
+	{0xAAB37FD7D8F58178U, 0xC8E5087BA6D33B83U},
+	{0xD5605FCDCF32E1D6U, 0xFB1E4A9A90880A64U},
+	{0x855C3BE0A17FCD26U, 0x5CF2EEA09A55067FU},
+	{0xA6B34AD8C9DFC06FU, 0xF42FAA48C0EA481EU},
+	{0xD0601D8EFC57B08BU, 0xF13B94DAF124DA26U},
+	{0x823C12795DB6CE57U, 0x76C53D08D6B70858U},
+	{0xA2CB1717B52481EDU, 0x54768C4B0C64CA6EU},
+	{0xCB7DDCDDA26DA268U, 0xA9942F5DCF7DFD09U},
+	{0xFE5D54150B090B02U, 0xD3F93B35435D7C4CU},
+	{0x9EFA548D26E5A6E1U, 0xC47BC5014A1A6DAFU},
+	{0xC6B8E9B0709F109AU, 0x359AB6419CA1091BU},
+	{0xF867241C8CC6D4C0U, 0xC30163D203C94B62U},
+	{0x9B407691D7FC44F8U, 0x79E0DE63425DCF1DU},
+	{0xC21094364DFB5636U, 0x985915FC12F542E4U},
+	{0xF294B943E17A2BC4U, 0x3E6F5B7B17B2939DU},
+	{0x979CF3CA6CEC5B5AU, 0xA705992CEECF9C42U},
+	{0xBD8430BD08277231U, 0x50C6FF782A838353U},
+	{0xECE53CEC4A314EBDU, 0xA4F8BF5635246428U},
+	{0x940F4613AE5ED136U, 0x871B7795E136BE99U},
+	{0xB913179899F68584U, 0x28E2557B59846E3FU},
+	{0xE757DD7EC07426E5U, 0x331AEADA2FE589CFU},
+	{0x9096EA6F3848984FU, 0x3FF0D2C85DEF7621U},
+	{0xB4BCA50B065ABE63U, 0x0FED077A756B53A9U},
+	{0xE1EBCE4DC7F16DFBU, 0xD3E8495912C62894U},
+	{0x8D3360F09CF6E4BDU, 0x64712DD7ABBBD95CU},
+	{0xB080392CC4349DECU, 0xBD8D794D96AACFB3U},
+	{0xDCA04777F541C567U, 0xECF0D7A0FC5583A0U},
+	{0x89E42CAAF9491B60U, 0xF41686C49DB57244U},
+	{0xAC5D37D5B79B6239U, 0x311C2875C522CED5U},
+	{0xD77485CB25823AC7U, 0x7D633293366B828BU},
+	{0x86A8D39EF77164BCU, 0xAE5DFF9C02033197U},
+	{0xA8530886B54DBDEBU, 0xD9F57F830283FDFCU},
+	{0xD267CAA862A12D66U, 0xD072DF63C324FD7BU},
+	{0x8380DEA93DA4BC60U, 0x4247CB9E59F71E6DU},
+	{0xA46116538D0DEB78U, 0x52D9BE85F074E608U},
+	{0xCD795BE870516656U, 0x67902E276C921F8BU},
+	{0x806BD9714632DFF6U, 0x00BA1CD8A3DB53B6U},
+	{0xA086CFCD97BF97F3U, 0x80E8A40ECCD228A4U},
+	{0xC8A883C0FDAF7DF0U, 0x6122CD128006B2CDU},
+	{0xFAD2A4B13D1B5D6CU, 0x796B805720085F81U},
+	{0x9CC3A6EEC6311A63U, 0xCBE3303674053BB0U},
+	{0xC3F490AA77BD60FCU, 0xBEDBFC4411068A9CU},
+	{0xF4F1B4D515ACB93BU, 0xEE92FB5515482D44U},
+	{0x991711052D8BF3C5U, 0x751BDD152D4D1C4AU},
+	{0xBF5CD54678EEF0B6U, 0xD262D45A78A0635DU},
+	{0xEF340A98172AACE4U, 0x86FB897116C87C34U},
+	{0x9580869F0E7AAC0EU, 0xD45D35E6AE3D4DA0U},
+	{0xBAE0A846D2195712U, 0x8974836059CCA109U},
+	{0xE998D258869FACD7U, 0x2BD1A438703FC94BU},
+	{0x91FF83775423CC06U, 0x7B6306A34627DDCFU},
+	{0xB67F6455292CBF08U, 0x1A3BC84C17B1D542U},
+	{0xE41F3D6A7377EECAU, 0x20CABA5F1D9E4A93U},
+	{0x8E938662882AF53EU, 0x547EB47B7282EE9CU},
+	{0xB23867FB2A35B28DU, 0xE99E619A4F23AA43U},
+	{0xDEC681F9F4C31F31U, 0x6405FA00E2EC94D4U},
+	{0x8B3C113C38F9F37EU, 0xDE83BC408DD3DD04U},
+	{0xAE0B158B4738705EU, 0x9624AB50B148D445U},
+	{0xD98DDAEE19068C76U, 0x3BADD624DD9B0957U},
+	{0x87F8A8D4CFA417C9U, 0xE54CA5D70A80E5D6U},
+	{0xA9F6D30A038D1DBCU, 0x5E9FCF4CCD211F4CU},
+	{0xD47487CC8470652BU, 0x7647C3200069671FU},
+	{0x84C8D4DFD2C63F3BU, 0x29ECD9F40041E073U},
+	{0xA5FB0A17C777CF09U, 0xF468107100525890U},
+	{0xCF79CC9DB955C2CCU, 0x7182148D4066EEB4U},
+	{0x81AC1FE293D599BFU, 0xC6F14CD848405530U},
+	{0xA21727DB38CB002FU, 0xB8ADA00E5A506A7CU},
+	{0xCA9CF1D206FDC03BU, 0xA6D90811F0E4851CU},
+	{0xFD442E4688BD304AU, 0x908F4A166D1DA663U},
+	{0x9E4A9CEC15763E2EU, 0x9A598E4E043287FEU},
+	{0xC5DD44271AD3CDBAU, 0x40EFF1E1853F29FDU},
+	{0xF7549530E188C128U, 0xD12BEE59E68EF47CU},
+	{0x9A94DD3E8CF578B9U, 0x82BB74F8301958CEU},
+	{0xC13A148E3032D6E7U, 0xE36A52363C1FAF01U},
+	{0xF18899B1BC3F8CA1U, 0xDC44E6C3CB279AC1U},
+	{0x96F5600F15A7B7E5U, 0x29AB103A5EF8C0B9U},
+	{0xBCB2B812DB11A5DEU, 0x7415D448F6B6F0E7U},
+	{0xEBDF661791D60F56U, 0x111B495B3464AD21U},
+	{0x936B9FCEBB25C995U, 0xCAB10DD900BEEC34U},
+	{0xB84687C269EF3BFBU, 0x3D5D514F40EEA742U},
+	{0xE65829B3046B0AFAU, 0x0CB4A5A3112A5112U},
+	{0x8FF71A0FE2C2E6DCU, 0x47F0E785EABA72ABU},
+	{0xB3F4E093DB73A093U, 0x59ED216765690F56U},
+	{0xE0F218B8D25088B8U, 0x306869C13EC3532CU},
+	{0x8C974F7383725573U, 0x1E414218C73A13FBU},
+	{0xAFBD2350644EEACFU, 0xE5D1929EF90898FAU},
+	{0xDBAC6C247D62A583U, 0xDF45F746B74ABF39U},
+	{0x894BC396CE5DA772U, 0x6B8BBA8C328EB783U},
+	{0xAB9EB47C81F5114FU, 0x066EA92F3F326564U},
+	{0xD686619BA27255A2U, 0xC80A537B0EFEFEBDU},
+	{0x8613FD0145877585U, 0xBD06742CE95F5F36U},
+	{0xA798FC4196E952E7U, 0x2C48113823B73704U},
+	{0xD17F3B51FCA3A7A0U, 0xF75A15862CA504C5U},
+	{0x82EF85133DE648C4U, 0x9A984D73DBE722FBU},
+	{0xA3AB66580D5FDAF5U, 0xC13E60D0D2E0EBBAU},
+	{0xCC963FEE10B7D1B3U, 0x318DF905079926A8U},
+	{0xFFBBCFE994E5C61FU, 0xFDF17746497F7052U},
+	{0x9FD561F1FD0F9BD3U, 0xFEB6EA8BEDEFA633U},
+	{0xC7CABA6E7C5382C8U, 0xFE64A52EE96B8FC0U},
+	{0xF9BD690A1B68637BU, 0x3DFDCE7AA3C673B0U},
+	{0x9C1661A651213E2DU, 0x06BEA10CA65C084EU},
+	{0xC31BFA0FE5698DB8U, 0x486E494FCFF30A62U},
+	{0xF3E2F893DEC3F126U, 0x5A89DBA3C3EFCCFAU},
+	{0x986DDB5C6B3A76B7U, 0xF89629465A75E01CU},
+	{0xBE89523386091465U, 0xF6BBB397F1135823U},
+	{0xEE2BA6C0678B597FU, 0x746AA07DED582E2CU},
+	{0x94DB483840B717EFU, 0xA8C2A44EB4571CDCU},
+	{0xBA121A4650E4DDEBU, 0x92F34D62616CE413U},
+	{0xE896A0D7E51E1566U, 0x77B020BAF9C81D17U},
+	{0x915E2486EF32CD60U, 0x0ACE1474DC1D122EU},
+	{0xB5B5ADA8AAFF80B8U, 0x0D819992132456BAU},
+	{0xE3231912D5BF60E6U, 0x10E1FFF697ED6C69U},
+	{0x8DF5EFABC5979C8FU, 0xCA8D3FFA1EF463C1U},
+	{0xB1736B96B6FD83B3U, 0xBD308FF8A6B17CB2U},
+	{0xDDD0467C64BCE4A0U, 0xAC7CB3F6D05DDBDEU},
+	{0x8AA22C0DBEF60EE4U, 0x6BCDF07A423AA96BU},
+	{0xAD4AB7112EB3929DU, 0x86C16C98D2C953C6U},
+	{0xD89D64D57A607744U, 0xE871C7BF077BA8B7U},
+	{0x87625F056C7C4A8BU, 0x11471CD764AD4972U},
+	{0xA93AF6C6C79B5D2DU, 0xD598E40D3DD89BCFU},
+	{0xD389B47879823479U, 0x4AFF1D108D4EC2C3U},
+	{0x843610CB4BF160CBU, 0xCEDF722A585139BAU},
+	{0xA54394FE1EEDB8FEU, 0xC2974EB4EE658828U},
+	{0xCE947A3DA6A9273EU, 0x733D226229FEEA32U},
+	{0x811CCC668829B887U, 0x0806357D5A3F525FU},
+	{0xA163FF802A3426A8U, 0xCA07C2DCB0CF26F7U},
+	{0xC9BCFF6034C13052U, 0xFC89B393DD02F0B5U},
+	{0xFC2C3F3841F17C67U, 0xBBAC2078D443ACE2U},
+	{0x9D9BA7832936EDC0U, 0xD54B944B84AA4C0DU},
+	{0xC5029163F384A931U, 0x0A9E795E65D4DF11U},
+	{0xF64335BCF065D37DU, 0x4D4617B5FF4A16D5U},
+	{0x99EA0196163FA42EU, 0x504BCED1BF8E4E45U},
+	{0xC06481FB9BCF8D39U, 0xE45EC2862F71E1D6U},
+	{0xF07DA27A82C37088U, 0x5D767327BB4E5A4CU},
+	{0x964E858C91BA2655U, 0x3A6A07F8D510F86FU},
+	{0xBBE226EFB628AFEAU, 0x890489F70A55368BU},
+	{0xEADAB0ABA3B2DBE5U, 0x2B45AC74CCEA842EU},
+	{0x92C8AE6B464FC96FU, 0x3B0B8BC90012929DU},
+	{0xB77ADA0617E3BBCBU, 0x09CE6EBB40173744U},
+	{0xE55990879DDCAABDU, 0xCC420A6A101D0515U},
+	{0x8F57FA54C2A9EAB6U, 0x9FA946824A12232DU},
+	{0xB32DF8E9F3546564U, 0x47939822DC96ABF9U},
+	{0xDFF9772470297EBDU, 0x59787E2B93BC56F7U},
+	{0x8BFBEA76C619EF36U, 0x57EB4EDB3C55B65AU},
+	{0xAEFAE51477A06B03U, 0xEDE622920B6B23F1U},
+	{0xDAB99E59958885C4U, 0xE95FAB368E45ECEDU},
+	{0x88B402F7FD75539BU, 0x11DBCB0218EBB414U},
+	{0xAAE103B5FCD2A881U, 0xD652BDC29F26A119U},
+	{0xD59944A37C0752A2U, 0x4BE76D3346F0495FU},
+	{0x857FCAE62D8493A5U, 0x6F70A4400C562DDBU},
+	{0xA6DFBD9FB8E5B88EU, 0xCB4CCD500F6BB952U},
+	{0xD097AD07A71F26B2U, 0x7E2000A41346A7A7U},
+	{0x825ECC24C873782FU, 0x8ED400668C0C28C8U},
+	{0xA2F67F2DFA90563BU, 0x728900802F0F32FAU},
+	{0xCBB41EF979346BCAU, 0x4F2B40A03AD2FFB9U},
+	{0xFEA126B7D78186BCU, 0xE2F610C84987BFA8U},
+	{0x9F24B832E6B0F436U, 0x0DD9CA7D2DF4D7C9U},
+	{0xC6EDE63FA05D3143U, 0x91503D1C79720DBBU},
+	{0xF8A95FCF88747D94U, 0x75A44C6397CE912AU},
+	{0x9B69DBE1B548CE7CU, 0xC986AFBE3EE11ABAU},
+	{0xC24452DA229B021BU, 0xFBE85BADCE996168U},
+	{0xF2D56790AB41C2A2U, 0xFAE27299423FB9C3U},
+	{0x97C560BA6B0919A5U, 0xDCCD879FC967D41AU},
+	{0xBDB6B8E905CB600FU, 0x5400E987BBC1C920U},
+	{0xED246723473E3813U, 0x290123E9AAB23B68U},
+	{0x9436C0760C86E30BU, 0xF9A0B6720AAF6521U},
+	{0xB94470938FA89BCEU, 0xF808E40E8D5B3E69U},
+	{0xE7958CB87392C2C2U, 0xB60B1D1230B20E04U},
+	{0x90BD77F3483BB9B9U, 0xB1C6F22B5E6F48C2U},
+	{0xB4ECD5F01A4AA828U, 0x1E38AEB6360B1AF3U},
+	{0xE2280B6C20DD5232U, 0x25C6DA63C38DE1B0U},
+	{0x8D590723948A535FU, 0x579C487E5A38AD0EU},
+	{0xB0AF48EC79ACE837U, 0x2D835A9DF0C6D851U},
+	{0xDCDB1B2798182244U, 0xF8E431456CF88E65U},
+	{0x8A08F0F8BF0F156BU, 0x1B8E9ECB641B58FFU},
+	{0xAC8B2D36EED2DAC5U, 0xE272467E3D222F3FU},
+	{0xD7ADF884AA879177U, 0x5B0ED81DCC6ABB0FU},
+	{0x86CCBB52EA94BAEAU, 0x98E947129FC2B4E9U},
+	{0xA87FEA27A539E9A5U, 0x3F2398D747B36224U},
+	{0xD29FE4B18E88640EU, 0x8EEC7F0D19A03AADU},
+	{0x83A3EEEEF9153E89U, 0x1953CF68300424ACU},
+	{0xA48CEAAAB75A8E2BU, 0x5FA8C3423C052DD7U},
+	{0xCDB02555653131B6U, 0x3792F412CB06794DU},
+	{0x808E17555F3EBF11U, 0xE2BBD88BBEE40BD0U},
+	{0xA0B19D2AB70E6ED6U, 0x5B6ACEAEAE9D0EC4U},
+	{0xC8DE047564D20A8BU, 0xF245825A5A445275U},
+	{0xFB158592BE068D2EU, 0xEED6E2F0F0D56712U},
+	{0x9CED737BB6C4183DU, 0x55464DD69685606BU},
+	{0xC428D05AA4751E4CU, 0xAA97E14C3C26B886U},
+	{0xF53304714D9265DFU, 0xD53DD99F4B3066A8U},
+	{0x993FE2C6D07B7FABU, 0xE546A8038EFE4029U},
+	{0xBF8FDB78849A5F96U, 0xDE98520472BDD033U},
+	{0xEF73D256A5C0F77CU, 0x963E66858F6D4440U},
+	{0x95A8637627989AADU, 0xDDE7001379A44AA8U},
+	{0xBB127C53B17EC159U, 0x5560C018580D5D52U},
+	{0xE9D71B689DDE71AFU, 0xAAB8F01E6E10B4A6U},
+	{0x9226712162AB070DU, 0xCAB3961304CA70E8U},
+	{0xB6B00D69BB55C8D1U, 0x3D607B97C5FD0D22U},
+	{0xE45C10C42A2B3B05U, 0x8CB89A7DB77C506AU},
+	{0x8EB98A7A9A5B04E3U, 0x77F3608E92ADB242U},
+	{0xB267ED1940F1C61CU, 0x55F038B237591ED3U},
+	{0xDF01E85F912E37A3U, 0x6B6C46DEC52F6688U},
+	{0x8B61313BBABCE2C6U, 0x2323AC4B3B3DA015U},
+	{0xAE397D8AA96C1B77U, 0xABEC975E0A0D081AU},
+	{0xD9C7DCED53C72255U, 0x96E7BD358C904A21U},
+	{0x881CEA14545C7575U, 0x7E50D64177DA2E54U},
+	{0xAA242499697392D2U, 0xDDE50BD1D5D0B9E9U},
+	{0xD4AD2DBFC3D07787U, 0x955E4EC64B44E864U},
+	{0x84EC3C97DA624AB4U, 0xBD5AF13BEF0B113EU},
+	{0xA6274BBDD0FADD61U, 0xECB1AD8AEACDD58EU},
+	{0xCFB11EAD453994BAU, 0x67DE18EDA5814AF2U},
+	{0x81CEB32C4B43FCF4U, 0x80EACF948770CED7U},
+	{0xA2425FF75E14FC31U, 0xA1258379A94D028DU},
+	{0xCAD2F7F5359A3B3EU, 0x096EE45813A04330U},
+	{0xFD87B5F28300CA0DU, 0x8BCA9D6E188853FCU},
+	{0x9E74D1B791E07E48U, 0x775EA264CF55347EU},
+	{0xC612062576589DDAU, 0x95364AFE032A819EU},
+	{0xF79687AED3EEC551U, 0x3A83DDBD83F52205U},
+	{0x9ABE14CD44753B52U, 0xC4926A9672793543U},
+	{0xC16D9A0095928A27U, 0x75B7053C0F178294U},
+	{0xF1C90080BAF72CB1U, 0x5324C68B12DD6339U},
+	{0x971DA05074DA7BEEU, 0xD3F6FC16EBCA5E04U},
+	{0xBCE5086492111AEAU, 0x88F4BB1CA6BCF585U},
+	{0xEC1E4A7DB69561A5U, 0x2B31E9E3D06C32E6U},
+	{0x9392EE8E921D5D07U, 0x3AFF322E62439FD0U},
+	{0xB877AA3236A4B449U, 0x09BEFEB9FAD487C3U},
+	{0xE69594BEC44DE15BU, 0x4C2EBE687989A9B4U},
+	{0x901D7CF73AB0ACD9U, 0x0F9D37014BF60A11U},
+	{0xB424DC35095CD80FU, 0x538484C19EF38C95U},
+	{0xE12E13424BB40E13U, 0x2865A5F206B06FBAU},
+	{0x8CBCCC096F5088CBU, 0xF93F87B7442E45D4U},
+	{0xAFEBFF0BCB24AAFEU, 0xF78F69A51539D749U},
+	{0xDBE6FECEBDEDD5BEU, 0xB573440E5A884D1CU},
+	{0x89705F4136B4A597U, 0x31680A88F8953031U},
+	{0xABCC77118461CEFCU, 0xFDC20D2B36BA7C3EU},
+	{0xD6BF94D5E57A42BCU, 0x3D32907604691B4DU},
+	{0x8637BD05AF6C69B5U, 0xA63F9A49C2C1B110U},
+	{0xA7C5AC471B478423U, 0x0FCF80DC33721D54U},
+	{0xD1B71758E219652BU, 0xD3C36113404EA4A9U},
+	{0x83126E978D4FDF3BU, 0x645A1CAC083126EAU},
+	{0xA3D70A3D70A3D70AU, 0x3D70A3D70A3D70A4U},
+	{0xCCCCCCCCCCCCCCCCU, 0xCCCCCCCCCCCCCCCDU},
+	{0x8000000000000000U, 0x0000000000000000U},
+	{0xA000000000000000U, 0x0000000000000000U},
+	{0xC800000000000000U, 0x0000000000000000U},
+	{0xFA00000000000000U, 0x0000000000000000U},
+	{0x9C40000000000000U, 0x0000000000000000U},
+	{0xC350000000000000U, 0x0000000000000000U},
+	{0xF424000000000000U, 0x0000000000000000U},
+	{0x9896800000000000U, 0x0000000000000000U},
+	{0xBEBC200000000000U, 0x0000000000000000U},
+	{0xEE6B280000000000U, 0x0000000000000000U},
+	{0x9502F90000000000U, 0x0000000000000000U},
+	{0xBA43B74000000000U, 0x0000000000000000U},
+	{0xE8D4A51000000000U, 0x0000000000000000U},
+	{0x9184E72A00000000U, 0x0000000000000000U},
+	{0xB5E620F480000000U, 0x0000000000000000U},
+	{0xE35FA931A0000000U, 0x0000000000000000U},
+	{0x8E1BC9BF04000000U, 0x0000000000000000U},
+	{0xB1A2BC2EC5000000U, 0x0000000000000000U},
+	{0xDE0B6B3A76400000U, 0x0000000000000000U},
+	{0x8AC7230489E80000U, 0x0000000000000000U},
+	{0xAD78EBC5AC620000U, 0x0000000000000000U},
+	{0xD8D726B7177A8000U, 0x0000000000000000U},
+	{0x878678326EAC9000U, 0x0000000000000000U},
+	{0xA968163F0A57B400U, 0x0000000000000000U},
+	{0xD3C21BCECCEDA100U, 0x0000000000000000U},
+	{0x84595161401484A0U, 0x0000000000000000U},
+	{0xA56FA5B99019A5C8U, 0x0000000000000000U},
+	{0xCECB8F27F4200F3AU, 0x0000000000000000U},
+	{0x813F3978F8940984U, 0x4000000000000000U},
+	{0xA18F07D736B90BE5U, 0x5000000000000000U},
+	{0xC9F2C9CD04674EDEU, 0xA400000000000000U},
+	{0xFC6F7C4045812296U, 0x4D00000000000000U},
+	{0x9DC5ADA82B70B59DU, 0xF020000000000000U},
+	{0xC5371912364CE305U, 0x6C28000000000000U},
+	{0xF684DF56C3E01BC6U, 0xC732000000000000U},
+	{0x9A130B963A6C115CU, 0x3C7F400000000000U},
+	{0xC097CE7BC90715B3U, 0x4B9F100000000000U},
+	{0xF0BDC21ABB48DB20U, 0x1E86D40000000000U},
+	{0x96769950B50D88F4U, 0x1314448000000000U},
+	{0xBC143FA4E250EB31U, 0x17D955A000000000U},
+	{0xEB194F8E1AE525FDU, 0x5DCFAB0800000000U},
+	{0x92EFD1B8D0CF37BEU, 0x5AA1CAE500000000U},
+	{0xB7ABC627050305ADU, 0xF14A3D9E40000000U},
+	{0xE596B7B0C643C719U, 0x6D9CCD05D0000000U},
+	{0x8F7E32CE7BEA5C6FU, 0xE4820023A2000000U},
+	{0xB35DBF821AE4F38BU, 0xDDA2802C8A800000U},
+	{0xE0352F62A19E306EU, 0xD50B2037AD200000U},
+	{0x8C213D9DA502DE45U, 0x4526F422CC340000U},
+	{0xAF298D050E4395D6U, 0x9670B12B7F410000U},
+	{0xDAF3F04651D47B4CU, 0x3C0CDD765F114000U},
+	{0x88D8762BF324CD0FU, 0xA5880A69FB6AC800U},
+	{0xAB0E93B6EFEE0053U, 0x8EEA0D047A457A00U},
+	{0xD5D238A4ABE98068U, 0x72A4904598D6D880U},
+	{0x85A36366EB71F041U, 0x47A6DA2B7F864750U},
+	{0xA70C3C40A64E6C51U, 0x999090B65F67D924U},
+	{0xD0CF4B50CFE20765U, 0xFFF4B4E3F741CF6DU},
+	{0x82818F1281ED449FU, 0xBFF8F10E7A8921A4U},
+	{0xA321F2D7226895C7U, 0xAFF72D52192B6A0DU},
+	{0xCBEA6F8CEB02BB39U, 0x9BF4F8A69F764490U},
+	{0xFEE50B7025C36A08U, 0x02F236D04753D5B4U},
+	{0x9F4F2726179A2245U, 0x01D762422C946590U},
+	{0xC722F0EF9D80AAD6U, 0x424D3AD2B7B97EF5U},
+	{0xF8EBAD2B84E0D58BU, 0xD2E0898765A7DEB2U},
+	{0x9B934C3B330C8577U, 0x63CC55F49F88EB2FU},
+	{0xC2781F49FFCFA6D5U, 0x3CBF6B71C76B25FBU},
+	{0xF316271C7FC3908AU, 0x8BEF464E3945EF7AU},
+	{0x97EDD871CFDA3A56U, 0x97758BF0E3CBB5ACU},
+	{0xBDE94E8E43D0C8ECU, 0x3D52EEED1CBEA317U},
+	{0xED63A231D4C4FB27U, 0x4CA7AAA863EE4BDDU},
+	{0x945E455F24FB1CF8U, 0x8FE8CAA93E74EF6AU},
+	{0xB975D6B6EE39E436U, 0xB3E2FD538E122B44U},
+	{0xE7D34C64A9C85D44U, 0x60DBBCA87196B616U},
+	{0x90E40FBEEA1D3A4AU, 0xBC8955E946FE31CDU},
+	{0xB51D13AEA4A488DDU, 0x6BABAB6398BDBE41U},
+	{0xE264589A4DCDAB14U, 0xC696963C7EED2DD1U},
+	{0x8D7EB76070A08AECU, 0xFC1E1DE5CF543CA2U},
+	{0xB0DE65388CC8ADA8U, 0x3B25A55F43294BCBU},
+	{0xDD15FE86AFFAD912U, 0x49EF0EB713F39EBEU},
+	{0x8A2DBF142DFCC7ABU, 0x6E3569326C784337U},
+	{0xACB92ED9397BF996U, 0x49C2C37F07965404U},
+	{0xD7E77A8F87DAF7FBU, 0xDC33745EC97BE906U},
+	{0x86F0AC99B4E8DAFDU, 0x69A028BB3DED71A3U},
+	{0xA8ACD7C0222311BCU, 0xC40832EA0D68CE0CU},
+	{0xD2D80DB02AABD62BU, 0xF50A3FA490C30190U},
+	{0x83C7088E1AAB65DBU, 0x792667C6DA79E0FAU},
+	{0xA4B8CAB1A1563F52U, 0x577001B891185938U},
+	{0xCDE6FD5E09ABCF26U, 0xED4C0226B55E6F86U},
+	{0x80B05E5AC60B6178U, 0x544F8158315B05B4U},
+	{0xA0DC75F1778E39D6U, 0x696361AE3DB1C721U},
+	{0xC913936DD571C84CU, 0x03BC3A19CD1E38E9U},
+	{0xFB5878494ACE3A5FU, 0x04AB48A04065C723U},
+	{0x9D174B2DCEC0E47BU, 0x62EB0D64283F9C76U},
+	{0xC45D1DF942711D9AU, 0x3BA5D0BD324F8394U},
+	{0xF5746577930D6500U, 0xCA8F44EC7EE36479U},
+	{0x9968BF6ABBE85F20U, 0x7E998B13CF4E1ECBU},
+	{0xBFC2EF456AE276E8U, 0x9E3FEDD8C321A67EU},
+	{0xEFB3AB16C59B14A2U, 0xC5CFE94EF3EA101EU},
+	{0x95D04AEE3B80ECE5U, 0xBBA1F1D158724A12U},
+	{0xBB445DA9CA61281FU, 0x2A8A6E45AE8EDC97U},
+	{0xEA1575143CF97226U, 0xF52D09D71A3293BDU},
+	{0x924D692CA61BE758U, 0x593C2626705F9C56U},
+	{0xB6E0C377CFA2E12EU, 0x6F8B2FB00C77836CU},
+	{0xE498F455C38B997AU, 0x0B6DFB9C0F956447U},
+	{0x8EDF98B59A373FECU, 0x4724BD4189BD5EACU},
+	{0xB2977EE300C50FE7U, 0x58EDEC91EC2CB657U},
+	{0xDF3D5E9BC0F653E1U, 0x2F2967B66737E3EDU},
+	{0x8B865B215899F46CU, 0xBD79E0D20082EE74U},
+	{0xAE67F1E9AEC07187U, 0xECD8590680A3AA11U},
+	{0xDA01EE641A708DE9U, 0xE80E6F4820CC9495U},
+	{0x884134FE908658B2U, 0x3109058D147FDCDDU},
+	{0xAA51823E34A7EEDEU, 0xBD4B46F0599FD415U},
+	{0xD4E5E2CDC1D1EA96U, 0x6C9E18AC7007C91AU},
+	{0x850FADC09923329EU, 0x03E2CF6BC604DDB0U},
+	{0xA6539930BF6BFF45U, 0x84DB8346B786151CU},
+	{0xCFE87F7CEF46FF16U, 0xE612641865679A63U},
+	{0x81F14FAE158C5F6EU, 0x4FCB7E8F3F60C07EU},
+	{0xA26DA3999AEF7749U, 0xE3BE5E330F38F09DU},
+	{0xCB090C8001AB551CU, 0x5CADF5BFD3072CC5U},
+	{0xFDCB4FA002162A63U, 0x73D9732FC7C8F7F6U},
+	{0x9E9F11C4014DDA7EU, 0x2867E7FDDCDD9AFAU},
+	{0xC646D63501A1511DU, 0xB281E1FD541501B8U},
+	{0xF7D88BC24209A565U, 0x1F225A7CA91A4226U},
+	{0x9AE757596946075FU, 0x3375788DE9B06958U},
+	{0xC1A12D2FC3978937U, 0x0052D6B1641C83AEU},
+	{0xF209787BB47D6B84U, 0xC0678C5DBD23A49AU},
+	{0x9745EB4D50CE6332U, 0xF840B7BA963646E0U},
+	{0xBD176620A501FBFFU, 0xB650E5A93BC3D898U},
+	{0xEC5D3FA8CE427AFFU, 0xA3E51F138AB4CEBEU},
+	{0x93BA47C980E98CDFU, 0xC66F336C36B10137U},
+	{0xB8A8D9BBE123F017U, 0xB80B0047445D4184U},
+	{0xE6D3102AD96CEC1DU, 0xA60DC059157491E5U},
+	{0x9043EA1AC7E41392U, 0x87C89837AD68DB2FU},
+	{0xB454E4A179DD1877U, 0x29BABE4598C311FBU},
+	{0xE16A1DC9D8545E94U, 0xF4296DD6FEF3D67AU},
+	{0x8CE2529E2734BB1DU, 0x1899E4A65F58660CU},
+	{0xB01AE745B101E9E4U, 0x5EC05DCFF72E7F8FU},
+	{0xDC21A1171D42645DU, 0x76707543F4FA1F73U},
+	{0x899504AE72497EBAU, 0x6A06494A791C53A8U},
+	{0xABFA45DA0EDBDE69U, 0x0487DB9D17636892U},
+	{0xD6F8D7509292D603U, 0x45A9D2845D3C42B6U},
+	{0x865B86925B9BC5C2U, 0x0B8A2392BA45A9B2U},
+	{0xA7F26836F282B732U, 0x8E6CAC7768D7141EU},
+	{0xD1EF0244AF2364FFU, 0x3207D795430CD926U},
+	{0x8335616AED761F1FU, 0x7F44E6BD49E807B8U},
+	{0xA402B9C5A8D3A6E7U, 0x5F16206C9C6209A6U},
+	{0xCD036837130890A1U, 0x36DBA887C37A8C0FU},
+	{0x802221226BE55A64U, 0xC2494954DA2C9789U},
+	{0xA02AA96B06DEB0FDU, 0xF2DB9BAA10B7BD6CU},
+	{0xC83553C5C8965D3DU, 0x6F92829494E5ACC7U},
+	{0xFA42A8B73ABBF48CU, 0xCB772339BA1F17F9U},
+	{0x9C69A97284B578D7U, 0xFF2A760414536EFBU},
+	{0xC38413CF25E2D70DU, 0xFEF5138519684ABAU},
+	{0xF46518C2EF5B8CD1U, 0x7EB258665FC25D69U},
+	{0x98BF2F79D5993802U, 0xEF2F773FFBD97A61U},
+	{0xBEEEFB584AFF8603U, 0xAAFB550FFACFD8FAU},
+	{0xEEAABA2E5DBF6784U, 0x95BA2A53F983CF38U},
+	{0x952AB45CFA97A0B2U, 0xDD945A747BF26183U},
+	{0xBA756174393D88DFU, 0x94F971119AEEF9E4U},
+	{0xE912B9D1478CEB17U, 0x7A37CD5601AAB85DU},
+	{0x91ABB422CCB812EEU, 0xAC62E055C10AB33AU},
+	{0xB616A12B7FE617AAU, 0x577B986B314D6009U},
+	{0xE39C49765FDF9D94U, 0xED5A7E85FDA0B80BU},
+	{0x8E41ADE9FBEBC27DU, 0x14588F13BE847307U},
+	{0xB1D219647AE6B31CU, 0x596EB2D8AE258FC8U},
+	{0xDE469FBD99A05FE3U, 0x6FCA5F8ED9AEF3BBU},
+	{0x8AEC23D680043BEEU, 0x25DE7BB9480D5854U},
+	{0xADA72CCC20054AE9U, 0xAF561AA79A10AE6AU},
+	{0xD910F7FF28069DA4U, 0x1B2BA1518094DA04U},
+	{0x87AA9AFF79042286U, 0x90FB44D2F05D0842U},
+	{0xA99541BF57452B28U, 0x353A1607AC744A53U},
+	{0xD3FA922F2D1675F2U, 0x42889B8997915CE8U},
+	{0x847C9B5D7C2E09B7U, 0x69956135FEBADA11U},
+	{0xA59BC234DB398C25U, 0x43FAB9837E699095U},
+	{0xCF02B2C21207EF2EU, 0x94F967E45E03F4BBU},
+	{0x8161AFB94B44F57DU, 0x1D1BE0EEBAC278F5U},
+	{0xA1BA1BA79E1632DCU, 0x6462D92A69731732U},
+	{0xCA28A291859BBF93U, 0x7D7B8F7503CFDCFEU},
+	{0xFCB2CB35E702AF78U, 0x5CDA735244C3D43EU},
+	{0x9DEFBF01B061ADABU, 0x3A0888136AFA64A7U},
+	{0xC56BAEC21C7A1916U, 0x088AAA1845B8FDD0U},
+	{0xF6C69A72A3989F5BU, 0x8AAD549E57273D45U},
+	{0x9A3C2087A63F6399U, 0x36AC54E2F678864BU},
+	{0xC0CB28A98FCF3C7FU, 0x84576A1BB416A7DDU},
+	{0xF0FDF2D3F3C30B9FU, 0x656D44A2A11C51D5U},
+	{0x969EB7C47859E743U, 0x9F644AE5A4B1B325U},
+	{0xBC4665B596706114U, 0x873D5D9F0DDE1FEEU},
+	{0xEB57FF22FC0C7959U, 0xA90CB506D155A7EAU},
+	{0x9316FF75DD87CBD8U, 0x09A7F12442D588F2U},
+	{0xB7DCBF5354E9BECEU, 0x0C11ED6D538AEB2FU},
+	{0xE5D3EF282A242E81U, 0x8F1668C8A86DA5FAU},
+	{0x8FA475791A569D10U, 0xF96E017D694487BCU},
+	{0xB38D92D760EC4455U, 0x37C981DCC395A9ACU},
+	{0xE070F78D3927556AU, 0x85BBE253F47B1417U},
+	{0x8C469AB843B89562U, 0x93956D7478CCEC8EU},
+	{0xAF58416654A6BABBU, 0x387AC8D1970027B2U},
+	{0xDB2E51BFE9D0696AU, 0x06997B05FCC0319EU},
+	{0x88FCF317F22241E2U, 0x441FECE3BDF81F03U},
+	{0xAB3C2FDDEEAAD25AU, 0xD527E81CAD7626C3U},
+	{0xD60B3BD56A5586F1U, 0x8A71E223D8D3B074U},
+	{0x85C7056562757456U, 0xF6872D5667844E49U},
+	{0xA738C6BEBB12D16CU, 0xB428F8AC016561DBU},
+	{0xD106F86E69D785C7U, 0xE13336D701BEBA52U},
+	{0x82A45B450226B39CU, 0xECC0024661173473U},
+	{0xA34D721642B06084U, 0x27F002D7F95D0190U},
+	{0xCC20CE9BD35C78A5U, 0x31EC038DF7B441F4U},
+	{0xFF290242C83396CEU, 0x7E67047175A15271U},
+	{0x9F79A169BD203E41U, 0x0F0062C6E984D386U},
+	{0xC75809C42C684DD1U, 0x52C07B78A3E60868U},
+	{0xF92E0C3537826145U, 0xA7709A56CCDF8A82U},
+	{0x9BBCC7A142B17CCBU, 0x88A66076400BB691U},
+	{0xC2ABF989935DDBFEU, 0x6ACFF893D00EA435U},
+	{0xF356F7EBF83552FEU, 0x0583F6B8C4124D43U},
+	{0x98165AF37B2153DEU, 0xC3727A337A8B704AU},
+	{0xBE1BF1B059E9A8D6U, 0x744F18C0592E4C5CU},
+	{0xEDA2EE1C7064130CU, 0x1162DEF06F79DF73U},
+	{0x9485D4D1C63E8BE7U, 0x8ADDCB5645AC2BA8U},
+	{0xB9A74A0637CE2EE1U, 0x6D953E2BD7173692U},
+	{0xE8111C87C5C1BA99U, 0xC8FA8DB6CCDD0437U},
+	{0x910AB1D4DB9914A0U, 0x1D9C9892400A22A2U},
+	{0xB54D5E4A127F59C8U, 0x2503BEB6D00CAB4BU},
+	{0xE2A0B5DC971F303AU, 0x2E44AE64840FD61DU},
+	{0x8DA471A9DE737E24U, 0x5CEAECFED289E5D2U},
+	{0xB10D8E1456105DADU, 0x7425A83E872C5F47U},
+	{0xDD50F1996B947518U, 0xD12F124E28F77719U},
+	{0x8A5296FFE33CC92FU, 0x82BD6B70D99AAA6FU},
+	{0xACE73CBFDC0BFB7BU, 0x636CC64D1001550BU},
+	{0xD8210BEFD30EFA5AU, 0x3C47F7E05401AA4EU},
+	{0x8714A775E3E95C78U, 0x65ACFAEC34810A71U},
+	{0xA8D9D1535CE3B396U, 0x7F1839A741A14D0DU},
+	{0xD31045A8341CA07CU, 0x1EDE48111209A050U},
+	{0x83EA2B892091E44DU, 0x934AED0AAB460432U},
+	{0xA4E4B66B68B65D60U, 0xF81DA84D5617853FU},
+	{0xCE1DE40642E3F4B9U, 0x36251260AB9D668EU},
+	{0x80D2AE83E9CE78F3U, 0xC1D72B7C6B426019U},
+	{0xA1075A24E4421730U, 0xB24CF65B8612F81FU},
+	{0xC94930AE1D529CFCU, 0xDEE033F26797B627U},
+	{0xFB9B7CD9A4A7443CU, 0x169840EF017DA3B1U},
+	{0x9D412E0806E88AA5U, 0x8E1F289560EE864EU},
+	{0xC491798A08A2AD4EU, 0xF1A6F2BAB92A27E2U},
+	{0xF5B5D7EC8ACB58A2U, 0xAE10AF696774B1DBU},
+	{0x9991A6F3D6BF1765U, 0xACCA6DA1E0A8EF29U},
+	{0xBFF610B0CC6EDD3FU, 0x17FD090A58D32AF3U},
+	{0xEFF394DCFF8A948EU, 0xDDFC4B4CEF07F5B0U},
+	{0x95F83D0A1FB69CD9U, 0x4ABDAF101564F98EU},
+	{0xBB764C4CA7A4440FU, 0x9D6D1AD41ABE37F1U},
+	{0xEA53DF5FD18D5513U, 0x84C86189216DC5EDU},
+	{0x92746B9BE2F8552CU, 0x32FD3CF5B4E49BB4U},
+	{0xB7118682DBB66A77U, 0x3FBC8C33221DC2A1U},
+	{0xE4D5E82392A40515U, 0x0FABAF3FEAA5334AU},
+	{0x8F05B1163BA6832DU, 0x29CB4D87F2A7400EU},
+	{0xB2C71D5BCA9023F8U, 0x743E20E9EF511012U},
+	{0xDF78E4B2BD342CF6U, 0x914DA9246B255416U},
+	{0x8BAB8EEFB6409C1AU, 0x1AD089B6C2F7548EU},
+	{0xAE9672ABA3D0C320U, 0xA184AC2473B529B1U},
+	{0xDA3C0F568CC4F3E8U, 0xC9E5D72D90A2741EU},
+	{0x8865899617FB1871U, 0x7E2FA67C7A658892U},
+	{0xAA7EEBFB9DF9DE8DU, 0xDDBB901B98FEEAB7U},
+	{0xD51EA6FA85785631U, 0x552A74227F3EA565U},
+	{0x8533285C936B35DEU, 0xD53A88958F87275FU},
+	{0xA67FF273B8460356U, 0x8A892ABAF368F137U},
+	{0xD01FEF10A657842CU, 0x2D2B7569B0432D85U},
+	{0x8213F56A67F6B29BU, 0x9C3B29620E29FC73U},
+	{0xA298F2C501F45F42U, 0x8349F3BA91B47B8FU},
+	{0xCB3F2F7642717713U, 0x241C70A936219A73U},
+	{0xFE0EFB53D30DD4D7U, 0xED238CD383AA0110U},
+	{0x9EC95D1463E8A506U, 0xF4363804324A40AAU},
+	{0xC67BB4597CE2CE48U, 0xB143C6053EDCD0D5U},
+	{0xF81AA16FDC1B81DAU, 0xDD94B7868E94050AU},
+	{0x9B10A4E5E9913128U, 0xCA7CF2B4191C8326U},
+	{0xC1D4CE1F63F57D72U, 0xFD1C2F611F63A3F0U},
+	{0xF24A01A73CF2DCCFU, 0xBC633B39673C8CECU},
+	{0x976E41088617CA01U, 0xD5BE0503E085D813U},
+	{0xBD49D14AA79DBC82U, 0x4B2D8644D8A74E18U},
+	{0xEC9C459D51852BA2U, 0xDDF8E7D60ED1219EU},
+	{0x93E1AB8252F33B45U, 0xCABB90E5C942B503U},
+	{0xB8DA1662E7B00A17U, 0x3D6A751F3B936243U},
+	{0xE7109BFBA19C0C9DU, 0x0CC512670A783AD4U},
+	{0x906A617D450187E2U, 0x27FB2B80668B24C5U},
+	{0xB484F9DC9641E9DAU, 0xB1F9F660802DEDF6U},
+	{0xE1A63853BBD26451U, 0x5E7873F8A0396973U},
+	{0x8D07E33455637EB2U, 0xDB0B487B6423E1E8U},
+	{0xB049DC016ABC5E5FU, 0x91CE1A9A3D2CDA62U},
+	{0xDC5C5301C56B75F7U, 0x7641A140CC7810FBU},
+	{0x89B9B3E11B6329BAU, 0xA9E904C87FCB0A9DU},
+	{0xAC2820D9623BF429U, 0x546345FA9FBDCD44U},
+	{0xD732290FBACAF133U, 0xA97C177947AD4095U},
+	{0x867F59A9D4BED6C0U, 0x49ED8EABCCCC485DU},
+	{0xA81F301449EE8C70U, 0x5C68F256BFFF5A74U},
+	{0xD226FC195C6A2F8CU, 0x73832EEC6FFF3111U},
+	{0x83585D8FD9C25DB7U, 0xC831FD53C5FF7EABU},
+	{0xA42E74F3D032F525U, 0xBA3E7CA8B77F5E55U},
+	{0xCD3A1230C43FB26FU, 0x28CE1BD2E55F35EBU},
+	{0x80444B5E7AA7CF85U, 0x7980D163CF5B81B3U},
+	{0xA0555E361951C366U, 0xD7E105BCC332621FU},
+	{0xC86AB5C39FA63440U, 0x8DD9472BF3FEFAA7U},
+	{0xFA856334878FC150U, 0xB14F98F6F0FEB951U},
+	{0x9C935E00D4B9D8D2U, 0x6ED1BF9A569F33D3U},
+	{0xC3B8358109E84F07U, 0x0A862F80EC4700C8U},
+	{0xF4A642E14C6262C8U, 0xCD27BB612758C0FAU},
+	{0x98E7E9CCCFBD7DBDU, 0x8038D51CB897789CU},
+	{0xBF21E44003ACDD2CU, 0xE0470A63E6BD56C3U},
+	{0xEEEA5D5004981478U, 0x1858CCFCE06CAC74U},
+	{0x95527A5202DF0CCBU, 0x0F37801E0C43EBC8U},
+	{0xBAA718E68396CFFDU, 0xD30560258F54E6BAU},
+	{0xE950DF20247C83FDU, 0x47C6B82EF32A2069U},
+	{0x91D28B7416CDD27EU, 0x4CDC331D57FA5441U},
+	{0xB6472E511C81471DU, 0xE0133FE4ADF8E952U},
+	{0xE3D8F9E563A198E5U, 0x58180FDDD97723A6U},
+	{0x8E679C2F5E44FF8FU, 0x570F09EAA7EA7648U},
+};
+
+#if defined(__SIZEOF_INT128__)
+__extension__ typedef unsigned __int128 cast_uint128;
+#endif
+
+/* Multiply two 64-bit integers into 128-bit result */
+static inline void cast_mul_64(uint64_t a, uint64_t b, uint64_t *high,
+			       uint64_t *low)
+{
+#if defined(__SIZEOF_INT128__)
+	cast_uint128 r = (cast_uint128)a * b;
+	*high = (uint64_t)(r >> 64);
+	*low = (uint64_t)r;
+#else
+	uint64_t a_lo = a & 0xFFFFFFFFU, a_hi = a >> 32;
+	uint64_t b_lo = b & 0xFFFFFFFFU, b_hi = b >> 32;
+	uint64_t lo_lo = a_lo * b_lo;
+	uint64_t hi_lo = a_hi * b_lo;
+	uint64_t lo_hi = a_lo * b_hi;
+	uint64_t hi_hi = a_hi * b_hi;
+	uint64_t cross = (lo_lo >> 32) + (hi_lo & 0xFFFFFFFFU) + lo_hi;
+	*high = hi_hi + (hi_lo >> 32) + (cross >> 32);
+	*low = (cross << 32) | (lo_lo & 0xFFFFFFFFU);
+#endif
+}
+
+/* Count trailing zero bits of nonzero integer */
+static inline int cast_ctz_64(uint64_t x)
+{
+#if defined(__GNUC__) || defined(__clang__)
+	return __builtin_ctzll(x);
+#else
+	int n = 0;
+	while (!(x & 1U)) {
+		x >>= 1;
+		++n;
+	}
+	return n;
+#endif
+}
+
+/**
+ * Split decimal floating point number into mantissa and exponent.
+ *
+ * @param parts   Where to store the parts.
+ * @param ptr     Characters to parse, they don't have to be NULL-terminated.
+ * @param len     Number of characters to parse.
+ *
+ * @return 0 on success, -1 if string is not a decimal number.
+ */
+static int cast_parse_float_parts(struct cast_float_parts *parts,
+				  const char *ptr, size_t len)
+{
+	const char *p = ptr;
+	const char *end = ptr + len;
+
+	parts->negative = p != end && *p == '-';
+	if (p != end && (*p == '-' || *p == '+'))
+		++p;
+
+	const char *start_digits = p;
+	uint64_t i = 0U;
+	while (p != end && (unsigned)(*p - '0') <= 9U) {
+		i = 10U * i + (uint64_t)(*p - '0');
+		++p;
+	}
+	const char *end_of_integer = p;
+	int64_t digit_count = end_of_integer - start_digits;
+	int64_t exponent = 0;
+
+	const char *start_fraction = p;
+	if (p != end && *p == '.') {
+		++p;
+		start_fraction = p;
+#if defined(CAST_SWAR_DIGITS)
+		while (end - p >= 8) {
+			uint64_t chunk;
+			memcpy(&chunk, p, sizeof(chunk));
+			if (!cast_swar_is_digits(chunk))
+				break;
+			i = i * 100000000U + cast_swar_parse_digits(chunk);
+			p += 8;
+		}
+#endif
+		while (p != end && (unsigned)(*p - '0') <= 9U) {
+			i = 10U * i + (uint64_t)(*p - '0');
+			++p;
+		}
+		exponent = start_fraction - p;
+		digit_count -= exponent;
+	}
+	const char *end_of_fraction = p;
+	if (digit_count == 0)
+		return -1;
+
+	int64_t exp_number = 0;
+	if (p != end && (*p == 'e' || *p == 'E')) {
+		++p;
+		bool negative_exp = p != end && *p == '-';
+		if (p != end && (*p == '-' || *p == '+'))
+			++p;
+		if (p == end || (unsigned)(*p - '0') > 9U)
+			return -1;
+		while (p != end && (unsigned)(*p - '0') <= 9U) {
+			/* Larger exponents don't change the result */
+			if (exp_number < 0x10000000)
+				exp_number = 10 * exp_number + (*p - '0');
+			++p;
+		}
+		if (negative_exp)
+			exp_number = -exp_number;
+		exponent += exp_number;
+	}
+	if (p != end)
+		return -1;
+
+	parts->mantissa = i;
+	parts->exponent = exponent;
+	parts->many_digits = false;
+	if (digit_count <= 19)
+		return 0;
+
+	/* Leading zeros are not significant */
+	for (p = start_digits; p != end_of_fraction && (*p == '0' || *p == '.');
+	     ++p)
+		digit_count -= *p == '0';
+	if (digit_count <= 19)
+		return 0;
+
+	/* Keep only the first 19 significant digits */
+	const uint64_t min_19_digits = 1000000000000000000U;
+	parts->many_digits = true;
+	i = 0U;
+	for (p = start_digits; i < min_19_digits && p != end_of_integer; ++p)
+		i = 10U * i + (uint64_t)(*p - '0');
+	if (i >= min_19_digits) {
+		parts->exponent = end_of_integer - p + exp_number;
+	} else {
+		for (p = start_fraction;
+		     i < min_19_digits && p != end_of_fraction; ++p)
+			i = 10U * i + (uint64_t)(*p - '0');
+		parts->exponent = start_fraction - p + exp_number;
+	}
+	parts->mantissa = i;
+	return 0;
+}
+
+/**
+ * Compute binary floating point value of w * 10^q with Eisel-Lemire
+ * algorithm.
+ *
+ * @param fmt        Floating point format.
+ * @param q          Decimal exponent.
+ * @param w          Decimal mantissa.
+ * @param power2     Where to store biased binary exponent, it is 0 for
+ *                   subnormal values and infinity power for infinity.
+ *
+ * @return Binary mantissa without the implicit bit.
+ */
+static uint64_t cast_eisel_lemire(const struct cast_float_format *fmt,
+				  int64_t q, uint64_t w, int *power2)
+{
+	const int infinite_power = (1 << fmt->exponent_bits) - 1;
+
+	if (w == 0U || q < fmt->smallest_power_of_ten) {
+		*power2 = 0;
+		return 0U;
+	}
+	if (q > fmt->largest_power_of_ten) {
+		*power2 = infinite_power;
+		return 0U;
+	}
+
+	int lz = cast_clz_64(w);
+	w <<= lz;
+
+	/* Multiply by truncated 5^q, second half is needed only if the
+	 * product may be off in the bits used for the mantissa */
+	const uint64_t *pow5 =
+	    cast_power_of_five_128[q - cast_binary64.smallest_power_of_ten];
+	uint64_t high;
+	uint64_t low;
+	cast_mul_64(w, pow5[0], &high, &low);
+	const uint64_t precision_mask =
+	    UINT64_MAX >> (fmt->mantissa_bits + 3);
+	if ((high & precision_mask) == precision_mask) {
+		uint64_t second_high;
+		uint64_t second_low;
+		cast_mul_64(w, pow5[1], &second_high, &second_low);
+		low += second_high;
+		if (second_high > low)
+			++high;
+	}
+
+	int upperbit = (int)(high >> 63);
+	int shift = upperbit + 64 - fmt->mantissa_bits - 3;
+	uint64_t mantissa = high >> shift;
+	/* floor(q * log2(10)) + 63 is the binary exponent of 10^q */
+	int p = (int)(((152170 + 65536) * q) >> 16) + 63 + upperbit - lz -
+		fmt->min_exponent;
+
+	if (p <= 0) {
+		/* Subnormal value, mantissa is shifted and rounded */
+		if (-p + 1 >= 64) {
+			*power2 = 0;
+			return 0U;
+		}
+		mantissa >>= -p + 1;
+		mantissa += mantissa & 1U;
+		mantissa >>= 1;
+		*power2 = mantissa < (UINT64_C(1) << fmt->mantissa_bits) ? 0 : 1;
+		return mantissa & ((UINT64_C(1) << fmt->mantissa_bits) - 1U);
+	}
+
+	/* Exactly halfway between two values, round to even */
+	if (low <= 1U && q >= fmt->min_round_to_even &&
+	    q <= fmt->max_round_to_even && (mantissa & 3U) == 1U &&
+	    (mantissa << shift) == high)
+		mantissa &= ~(uint64_t)1U;
+
+	mantissa += mantissa & 1U;
+	mantissa >>= 1;
+	if (mantissa >= (UINT64_C(2) << fmt->mantissa_bits)) {
+		mantissa = UINT64_C(1) << fmt->mantissa_bits;
+		++p;
+	}
+	if (p >= infinite_power) {
+		*power2 = infinite_power;
+		return 0U;
+	}
+	*power2 = p;
+	return mantissa & ((UINT64_C(1) << fmt->mantissa_bits) - 1U);
+}
+
+/* Number of digits kept by cast_decimal */
+#define CAST_DECIMAL_DIGITS 800U
+
+/* Arbitrary precision decimal number 0.d[0]d[1]...d[nd - 1] * 10^dp */
+struct cast_decimal {
+	unsigned char d[CAST_DECIMAL_DIGITS];
+	size_t nd;
+	int dp;
+	/* Whether nonzero digits were dropped */
+	bool truncated;
+};
+
+/* Largest shift done at once, so digits don't overflow uint64_t */
+#define CAST_DECIMAL_MAX_SHIFT 60U
+
+/* Remove trailing zeros */
+static void cast_decimal_trim(struct cast_decimal *a)
+{
+	while (a->nd > 0U && a->d[a->nd - 1U] == 0U)
+		--a->nd;
+	if (a->nd == 0U)
+		a->dp = 0;
+}
+
+/* Multiply decimal by 2^k, k must not exceed CAST_DECIMAL_MAX_SHIFT */
+static void cast_decimal_left_shift(struct cast_decimal *a, unsigned k)
+{
+	unsigned char buf[CAST_DECIMAL_DIGITS + 20U];
+	size_t w = sizeof(buf);
+	uint64_t n = 0U;
+
+	for (size_t r = a->nd; r-- > 0U;) {
+		n += (uint64_t)a->d[r] << k;
+		uint64_t quo = n / 10U;
+		buf[--w] = (unsigned char)(n - 10U * quo);
+		n = quo;
+	}
+	while (n > 0U) {
+		uint64_t quo = n / 10U;
+		buf[--w] = (unsigned char)(n - 10U * quo);
+		n = quo;
+	}
+
+	size_t count = sizeof(buf) - w;
+	a->dp += (int)(count - a->nd);
+	if (count > CAST_DECIMAL_DIGITS) {
+		for (size_t i = CAST_DECIMAL_DIGITS; i < count; ++i)
+			a->truncated |= buf[w + i] != 0U;
+		count = CAST_DECIMAL_DIGITS;
+	}
+	memcpy(a->d, buf + w, count);
+	a->nd = count;
+	cast_decimal_trim(a);
+}
+
+/* Divide decimal by 2^k, k must not exceed CAST_DECIMAL_MAX_SHIFT */
+static void cast_decimal_right_shift(struct cast_decimal *a, unsigned k)
+{
+	size_t r = 0U;
+	size_t w = 0U;
+	uint64_t n = 0U;
+
+	/* Find the first digit of the result */
+	for (; (n >> k) == 0U; ++r) {
+		if (r >= a->nd) {
+			if (n == 0U) {
+				a->nd = 0U;
+				return;
+			}
+			while ((n >> k) == 0U) {
+				n *= 10U;
+				++r;
+			}
+			break;
+		}
+		n = n * 10U + a->d[r];
+	}
+	a->dp -= (int)r - 1;
+
+	const uint64_t mask = (UINT64_C(1) << k) - 1U;
+	for (; r < a->nd; ++r) {
+		uint64_t digit = n >> k;
+		n &= mask;
+		a->d[w++] = (unsigned char)digit;
+		n = n * 10U + a->d[r];
+	}
+	while (n > 0U) {
+		uint64_t digit = n >> k;
+		n &= mask;
+		if (w < CAST_DECIMAL_DIGITS)
+			a->d[w++] = (unsigned char)digit;
+		else if (digit > 0U)
+			a->truncated = true;
+		n *= 10U;
+	}
+	a->nd = w;
+	cast_decimal_trim(a);
+}
+
+/* Multiply decimal by 2^k, k can be negative */
+static void cast_decimal_shift(struct cast_decimal *a, int k)
+{
+	if (a->nd == 0U)
+		return;
+	for (; k > (int)CAST_DECIMAL_MAX_SHIFT; k -= (int)CAST_DECIMAL_MAX_SHIFT)
+		cast_decimal_left_shift(a, CAST_DECIMAL_MAX_SHIFT);
+	for (; k < -(int)CAST_DECIMAL_MAX_SHIFT;
+	     k += (int)CAST_DECIMAL_MAX_SHIFT)
+		cast_decimal_right_shift(a, CAST_DECIMAL_MAX_SHIFT);
+	if (k > 0)
+		cast_decimal_left_shift(a, (unsigned)k);
+	else if (k < 0)
+		cast_decimal_right_shift(a, (unsigned)-k);
+}
+
+/* Whether decimal truncated to nd digits should be rounded up */
+static bool cast_decimal_round_up(const struct cast_decimal *a, size_t nd)
+{
+	if (nd >= a->nd)
+		return false;
+	/* Exactly halfway, round to even */
+	if (a->d[nd] == 5U && nd + 1U == a->nd)
+		return a->truncated || (nd > 0U && a->d[nd - 1U] % 2U == 1U);
+	return a->d[nd] >= 5U;
+}
+
+/* Integer part of decimal, rounded to nearest, it must be below 2^64 */
+static uint64_t cast_decimal_rounded_integer(const struct cast_decimal *a)
+{
+	if (a->dp > 20)
+		return UINT64_MAX;
+
+	uint64_t n = 0U;
+	size_t i = 0U;
+	size_t dp = a->dp > 0 ? (size_t)a->dp : 0U;
+	for (; i < dp && i < a->nd; ++i)
+		n = n * 10U + a->d[i];
+	for (; i < dp; ++i)
+		n *= 10U;
+	if (a->dp >= 0 && cast_decimal_round_up(a, dp))
+		++n;
+	return n;
+}
+
+/**
+ * Compute binary floating point value of decimal number by repeatedly
+ * scaling it with powers of two. This is slow, but it is exact for any
+ * number of digits.
+ *
+ * @param fmt        Floating point format.
+ * @param ptr        Characters of valid decimal number.
+ * @param len        Number of characters.
+ * @param power2     Where to store biased binary exponent.
+ *
+ * @return Binary mantissa without the implicit bit.
+ */
+static uint64_t cast_decimal_to_binary(const struct cast_float_format *fmt,
+				       const char *ptr, size_t len,
+				       int *power2)
+{
+	static const int powtab[] = {1, 3, 6, 9, 13, 16, 19, 23, 26};
+	const int powtab_len = (int)(sizeof(powtab) / sizeof(powtab[0]));
+	const int bias = fmt->min_exponent;
+	const int infinite_power = (1 << fmt->exponent_bits) - 1;
+	struct cast_decimal a;
+	const char *p = ptr;
+	const char *end = ptr + len;
+
+	a.nd = 0U;
+	a.dp = 0;
+	a.truncated = false;
+	if (p != end && (*p == '-' || *p == '+'))
+		++p;
+
+	bool saw_dot = false;
+	for (; p != end; ++p) {
+		if (*p == '.') {
+			saw_dot = true;
+			a.dp = (int)a.nd;
+			continue;
+		}
+		if ((unsigned)(*p - '0') > 9U)
+			break;
+		if (*p == '0' && a.nd == 0U) {
+			--a.dp;
+			continue;
+		}
+		if (a.nd < CAST_DECIMAL_DIGITS)
+			a.d[a.nd++] = (unsigned char)(*p - '0');
+		else if (*p != '0')
+			a.truncated = true;
+	}
+	if (!saw_dot)
+		a.dp = (int)a.nd;
+	if (p != end) {
+		++p;
+		bool negative_exp = *p == '-';
+		if (*p == '-' || *p == '+')
+			++p;
+		int e = 0;
+		for (; p != end; ++p) {
+			if (e < 10000)
+				e = 10 * e + (*p - '0');
+		}
+		a.dp += negative_exp ? -e : e;
+	}
+	cast_decimal_trim(&a);
+
+	if (a.nd == 0U || a.dp < -330) {
+		*power2 = 0;
+		return 0U;
+	}
+	if (a.dp > 310) {
+		*power2 = infinite_power;
+		return 0U;
+	}
+
+	/* Scale to [0.5, 1) */
+	int exp = 0;
+	while (a.dp > 0) {
+		int n = a.dp >= powtab_len ? 27 : powtab[a.dp];
+		cast_decimal_shift(&a, -n);
+		exp += n;
+	}
+	while (a.dp < 0 || (a.dp == 0 && a.d[0] < 5U)) {
+		int n = -a.dp >= powtab_len ? 27 : powtab[-a.dp];
+		cast_decimal_shift(&a, n);
+		exp -= n;
+	}
+
+	/* Binary format has mantissa in [1, 2) */
+	--exp;
+	if (exp < bias + 1) {
+		int n = bias + 1 - exp;
+		cast_decimal_shift(&a, -n);
+		exp += n;
+	}
+	if (exp - bias >= infinite_power) {
+		*power2 = infinite_power;
+		return 0U;
+	}
+
+	cast_decimal_shift(&a, 1 + fmt->mantissa_bits);
+	uint64_t mantissa = cast_decimal_rounded_integer(&a);
+	if (mantissa == UINT64_C(2) << fmt->mantissa_bits) {
+		mantissa >>= 1;
+		++exp;
+		if (exp - bias >= infinite_power) {
+			*power2 = infinite_power;
+			return 0U;
+		}
+	}
+
+	/* Subnormal */
+	if (!(mantissa & (UINT64_C(1) << fmt->mantissa_bits)))
+		exp = bias;
+	*power2 = exp - bias;
+	return mantissa & ((UINT64_C(1) << fmt->mantissa_bits) - 1U);
+}
+
+/**
+ * Compute bits of binary floating point number from parts of decimal number,
+ * rounding it to nearest value.
+ *
+ * @param fmt     Floating point format.
+ * @param parts   Parts of the number.
+ * @param ptr     Characters of the number, they are parsed again only if it
+ *                has more than 19 significant digits.
+ * @param len     Number of characters.
+ * @param bits    Where to store the bits.
+ *
+ * @return 0 on success, 1 if the value overflows to infinity or is too small
+ *         to be represented as normal value (the bits are stored anyway).
+ */
+static int cast_float_from_parts(const struct cast_float_format *fmt,
+				 const struct cast_float_parts *parts,
+				 const char *ptr, size_t len, uint64_t *bits)
+{
+	int power2 = 0;
+	uint64_t mantissa =
+	    cast_eisel_lemire(fmt, parts->exponent, parts->mantissa, &power2);
+	if (parts->many_digits) {
+		/* Dropped digits may change rounding only if the result for
+		 * the next mantissa is different */
+		int next_power2 = 0;
+		uint64_t next_mantissa = cast_eisel_lemire(
+		    fmt, parts->exponent, parts->mantissa + 1U, &next_power2);
+		if (mantissa != next_mantissa || power2 != next_power2)
+			mantissa = cast_decimal_to_binary(fmt, ptr, len, &power2);
+	}
+
+	*bits = mantissa | (uint64_t)power2 << fmt->mantissa_bits |
+		(uint64_t)parts->negative
+		    << (fmt->mantissa_bits + fmt->exponent_bits);
+	if (power2 == (1 << fmt->exponent_bits) - 1)
+		return 1;
+	if (power2 == 0 && parts->mantissa != 0U)
+		return 1;
+	return 0;
+}
+
+/* Powers of ten, which are exactly representable as float or double */
+static const double cast_exact_powers_of_ten[] = {
+	1e0,  1e1,  1e2,  1e3,	1e4,  1e5,  1e6,  1e7,	1e8,  1e9,  1e10, 1e11,
+	1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22,
+};
+
+/**
+ * Parse decimal number as double.
+ *
+ * @param dst     Where to store the result.
+ * @param ptr     Characters to parse, they don't have to be NULL-terminated.
+ * @param len     Number of characters to parse.
+ *
+ * @return 0 on success, -1 if string is not a decimal number, 1 if the value
+ *         overflows or underflows (the result is stored anyway).
+ */
+static int cast_parse_double(double *dst, const char *ptr, size_t len)
+{
+	struct cast_float_parts parts;
+	if (cast_parse_float_parts(&parts, ptr, len))
+		return -1;
+
+#if FLT_EVAL_METHOD == 0
+	/* Both mantissa and power of ten are exact, so there is only one
+	 * rounding */
+	if (!parts.many_digits && parts.exponent >= -22 &&
+	    parts.exponent <= 22 && parts.mantissa <= UINT64_C(1) << 53) {
+		double val = (double)parts.mantissa;
+		if (parts.exponent < 0)
+			val /= cast_exact_powers_of_ten[-parts.exponent];
+		else
+			val *= cast_exact_powers_of_ten[parts.exponent];
+		*dst = parts.negative ? -val : val;
+		return 0;
+	}
+#endif
+
+	uint64_t bits = 0U;
+	int ret = cast_float_from_parts(&cast_binary64, &parts, ptr, len, &bits);
+	memcpy(dst, &bits, sizeof(*dst));
+	return ret;
+}
+
+/**
+ * Parse decimal number as float.
+ *
+ * @param dst     Where to store the result.
+ * @param ptr     Characters to parse, they don't have to be NULL-terminated.
+ * @param len     Number of characters to parse.
+ *
+ * @return 0 on success, -1 if string is not a decimal number, 1 if the value
+ *         overflows or underflows (the result is stored anyway).
+ */
+static int cast_parse_float(float *dst, const char *ptr, size_t len)
+{
+	struct cast_float_parts parts;
+	if (cast_parse_float_parts(&parts, ptr, len))
+		return -1;
+
+#if FLT_EVAL_METHOD == 0
+	if (!parts.many_digits && parts.exponent >= -10 &&
+	    parts.exponent <= 10 && parts.mantissa <= UINT64_C(1) << 24) {
+		float val = (float)parts.mantissa;
+		float pow10 = (float)cast_exact_powers_of_ten[parts.exponent < 0
+								  ? -parts.exponent
+								  : parts.exponent];
+		if (parts.exponent < 0)
+			val /= pow10;
+		else
+			val *= pow10;
+		*dst = parts.negative ? -val : val;
+		return 0;
+	}
+#endif
+
+	uint64_t bits = 0U;
+	int ret = cast_float_from_parts(&cast_binary32, &parts, ptr, len, &bits);
+	uint32_t bits32 = (uint32_t)bits;
+	memcpy(dst, &bits32, sizeof(*dst));
+	return ret;
+}
+
+int cast_try_float_from_strn(float *dst, const char *ptr, size_t len)
+{
+	if (!dst || !ptr)
+		return -1;
+
+	float val = 0.0f;
+	if (cast_parse_float(&val, ptr, len))
+		return -1;
+	*dst = val;
+	return 0;
+}
+
+int cast_try_double_from_strn(double *dst, const char *ptr, size_t len)
+{
+	if (!dst || !ptr)
+		return -1;
+
+	double val = 0.0;
+	if (cast_parse_double(&val, ptr, len))
+		return -1;
+	*dst = val;
+	return 0;
+}
+
+int cast_try_float_from_str(float *dst, const char *str)
+{
+	if (!dst)
+		return -1;
+	if (!str)
+		return -1;
+
+	/* Plain decimal numbers in range don't need strtof() */
+	float val = 0.0f;
+	if (cast_parse_float(&val, str, strlen(str)) == 0) {
+		*dst = val;
+		return 0;
+	}
+
+	errno = 0;
+
+	char *endptr = NULL;
+	val = strtof(str, &endptr);
+
+	/* If there is an error */
+	if (errno != 0) {
+		return -1;
+	}
+
+	/* If there are unparsed characters */
+	if (*endptr != '\0') {
+		return -1;
+	}
+
+	/* If there were no characters */
+	if (endptr == str || str[0] == '\0') {
+		return -1;
+	}
+
+	*dst = val;
+
+	return 0;
+}
+
+int cast_try_double_from_str(double *dst, const char *str)
+{
+	if (!dst)
+		return -1;
+	if (!str)
+		return -1;
+
+	/* Plain decimal numbers in range don't need strtod() */
+	double val = 0.0;
+	if (cast_parse_double(&val, str, strlen(str)) == 0) {
+		*dst = val;
+		return 0;
+	}
+
+	errno = 0;
+
+	char *endptr = NULL;
+	val = strtod(str, &endptr);
+
+	/* If there is an error */
+	if (errno != 0) {
+		return -1;
+	}
+
+	/* If there are unparsed characters */
+	if (*endptr != '\0') {
+		return -1;
+	}
+
+	/* If there were no characters */
+	if (endptr == str || str[0] == '\0') {
+		return -1;
+	}
+
+	*dst = val;
+
+	return 0;
+}
+
+/* 5^i normalized to 125 bits for i in [0, 326) */
+static const uint64_t cast_pow5_split[][2] = {
+	{0x1000000000000000U, 0x0000000000000000U},
+	{0x1400000000000000U, 0x0000000000000000U},
+	{0x1900000000000000U, 0x0000000000000000U},
+	{0x1F40000000000000U, 0x0000000000000000U},
+	{0x1388000000000000U, 0x0000000000000000U},
+	{0x186A000000000000U, 0x0000000000000000U},
+	{0x1E84800000000000U, 0x0000000000000000U},
+	{0x1312D00000000000U, 0x0000000000000000U},
+	{0x17D7840000000000U, 0x0000000000000000U},
+	{0x1DCD650000000000U, 0x0000000000000000U},
+	{0x12A05F2000000000U, 0x0000000000000000U},
+	{0x174876E800000000U, 0x0000000000000000U},
+	{0x1D1A94A200000000U, 0x0000000000000000U},
+	{0x12309CE540000000U, 0x0000000000000000U},
+	{0x16BCC41E90000000U, 0x0000000000000000U},
+	{0x1C6BF52634000000U, 0x0000000000000000U},
+	{0x11C37937E0800000U, 0x0000000000000000U},
+	{0x16345785D8A00000U, 0x0000000000000000U},
+	{0x1BC16D674EC80000U, 0x0000000000000000U},
+	{0x1158E460913D0000U, 0x0000000000000000U},
+	{0x15AF1D78B58C4000U, 0x0000000000000000U},
+	{0x1B1AE4D6E2EF5000U, 0x0000000000000000U},
+	{0x10F0CF064DD59200U, 0x0000000000000000U},
+	{0x152D02C7E14AF680U, 0x0000000000000000U},
+	{0x1A784379D99DB420U, 0x0000000000000000U},
+	{0x108B2A2C28029094U, 0x0000000000000000U},
+	{0x14ADF4B7320334B9U, 0x0000000000000000U},
+	{0x19D971E4FE8401E7U, 0x4000000000000000U},
+	{0x1027E72F1F128130U, 0x8800000000000000U},
+	{0x1431E0FAE6D7217CU, 0xAA00000000000000U},
+	{0x193E5939A08CE9DBU, 0xD480000000000000U},
+	{0x1F8DEF8808B02452U, 0xC9A0000000000000U},
+	{0x13B8B5B5056E16B3U, 0xBE04000000000000U},
+	{0x18A6E32246C99C60U, 0xAD85000000000000U},
+	{0x1ED09BEAD87C0378U, 0xD8E6400000000000U},
+	{0x13426172C74D822BU, 0x878FE80000000000U},
+	{0x1812F9CF7920E2B6U, 0x6973E20000000000U},
+	{0x1E17B84357691B64U, 0x03D0DA8000000000U},
+	{0x12CED32A16A1B11EU, 0x8262889000000000U},
+	{0x178287F49C4A1D66U, 0x22FB2AB400000000U},
+	{0x1D6329F1C35CA4BFU, 0xABB9F56100000000U},
+	{0x125DFA371A19E6F7U, 0xCB54395CA0000000U},
+	{0x16F578C4E0A060B5U, 0xBE2947B3C8000000U},
+	{0x1CB2D6F618C878E3U, 0x2DB399A0BA000000U},
+	{0x11EFC659CF7D4B8DU, 0xFC90400474400000U},
+	{0x166BB7F0435C9E71U, 0x7BB4500591500000U},
+	{0x1C06A5EC5433C60DU, 0xDAA16406F5A40000U},
+	{0x118427B3B4A05BC8U, 0xA8A4DE8459868000U},
+	{0x15E531A0A1C872BAU, 0xD2CE16256FE82000U},
+	{0x1B5E7E08CA3A8F69U, 0x87819BAECBE22800U},
+	{0x111B0EC57E6499A1U, 0xF4B1014D3F6D5900U},
+	{0x1561D276DDFDC00AU, 0x71DD41A08F48AF40U},
+	{0x1ABA4714957D300DU, 0x0E549208B31ADB10U},
+	{0x10B46C6CDD6E3E08U, 0x28F4DB456FF0C8EAU},
+	{0x14E1878814C9CD8AU, 0x33321216CBECFB24U},
+	{0x1A19E96A19FC40ECU, 0xBFFE969C7EE839EDU},
+	{0x105031E2503DA893U, 0xF7FF1E21CF512434U},
+	{0x14643E5AE44D12B8U, 0xF5FEE5AA43256D41U},
+	{0x197D4DF19D605767U, 0x337E9F14D3EEC892U},
+	{0x1FDCA16E04B86D41U, 0x005E46DA08EA7AB6U},
+	{0x13E9E4E4C2F34448U, 0xA03AEC4845928CB2U},
+	{0x18E45E1DF3B0155AU, 0xC849A75A56F72FDEU},
+	{0x1F1D75A5709C1AB1U, 0x7A5C1130ECB4FBD6U},
+	{0x13726987666190AEU, 0xEC798ABE93F11D65U},
+	{0x184F03E93FF9F4DAU, 0xA797ED6E38ED64BFU},
+	{0x1E62C4E38FF87211U, 0x517DE8C9C728BDEFU},
+	{0x12FDBB0E39FB474AU, 0xD2EEB17E1C7976B5U},
+	{0x17BD29D1C87A191DU, 0x87AA5DDDA397D462U},
+	{0x1DAC74463A989F64U, 0xE994F5550C7DC97BU},
+	{0x128BC8ABE49F639FU, 0x11FD195527CE9DEDU},
+	{0x172EBAD6DDC73C86U, 0xD67C5FAA71C24568U},
+	{0x1CFA698C95390BA8U, 0x8C1B77950E32D6C2U},
+	{0x121C81F7DD43A749U, 0x57912ABD28DFC639U},
+	{0x16A3A275D494911BU, 0xAD75756C7317B7C8U},
+	{0x1C4C8B1349B9B562U, 0x98D2D2C78FDDA5BAU},
+	{0x11AFD6EC0E14115DU, 0x9F83C3BCB9EA8794U},
+	{0x161BCCA7119915B5U, 0x0764B4ABE8652979U},
+	{0x1BA2BFD0D5FF5B22U, 0x493DE1D6E27E73D7U},
+	{0x1145B7E285BF98F5U, 0x6DC6AD264D8F0866U},
+	{0x159725DB272F7F32U, 0xC938586FE0F2CA80U},
+	{0x1AFCEF51F0FB5EFFU, 0x7B866E8BD92F7D20U},
+	{0x10DE1593369D1B5FU, 0xAD34051767BDAE34U},
+	{0x15159AF804446237U, 0x9881065D41AD19C1U},
+	{0x1A5B01B605557AC5U, 0x7EA147F492186032U},
+	{0x1078E111C3556CBBU, 0x6F24CCF8DB4F3C1FU},
+	{0x14971956342AC7EAU, 0x4AEE003712230B27U},
+	{0x19BCDFABC13579E4U, 0xDDA98044D6ABCDF0U},
+	{0x10160BCB58C16C2FU, 0x0A89F02B062B60B6U},
+	{0x141B8EBE2EF1C73AU, 0xCD2C6C35C7B638E4U},
+	{0x1922726DBAAE3909U, 0x8077874339A3C71DU},
+	{0x1F6B0F092959C74BU, 0xE0956914080CB8E4U},
+	{0x13A2E965B9D81C8FU, 0x6C5D61AC8507F38EU},
+	{0x188BA3BF284E23B3U, 0x4774BA17A649F072U},
+	{0x1EAE8CAEF261ACA0U, 0x1951E89D8FDC6C8FU},
+	{0x132D17ED577D0BE4U, 0x0FD3316279E9C3D9U},
+	{0x17F85DE8AD5C4EDDU, 0x13C7FDBB186434CFU},
+	{0x1DF67562D8B36294U, 0x58B9FD29DE7D4203U},
+	{0x12BA095DC7701D9CU, 0xB7743E3A2B0E4942U},
+	{0x17688BB5394C2503U, 0xE5514DC8B5D1DB92U},
+	{0x1D42AEA2879F2E44U, 0xDEA5A13AE3465277U},
+	{0x1249AD2594C37CEBU, 0x0B2784C4CE0BF38AU},
+	{0x16DC186EF9F45C25U, 0xCDF165F6018EF06DU},
+	{0x1C931E8AB871732FU, 0x416DBF7381F2AC88U},
+	{0x11DBF316B346E7FDU, 0x88E497A83137ABD5U},
+	{0x1652EFDC6018A1FCU, 0xEB1DBD923D8596CAU},
+	{0x1BE7ABD3781ECA7CU, 0x25E52CF6CCE6FC7DU},
+	{0x1170CB642B133E8DU, 0x97AF3C1A40105DCEU},
+	{0x15CCFE3D35D80E30U, 0xFD9B0B20D0147542U},
+	{0x1B403DCC834E11BDU, 0x3D01CDE904199292U},
+	{0x1108269FD210CB16U, 0x462120B1A28FFB9BU},
+	{0x154A3047C694FDDBU, 0xD7A968DE0B33FA82U},
+	{0x1A9CBC59B83A3D52U, 0xCD93C3158E00F923U},
+	{0x10A1F5B813246653U, 0xC07C59ED78C09BB6U},
+	{0x14CA732617ED7FE8U, 0xB09B7068D6F0C2A3U},
+	{0x19FD0FEF9DE8DFE2U, 0xDCC24C830CACF34CU},
+	{0x103E29F5C2B18BEDU, 0xC9F96FD1E7EC180FU},
+	{0x144DB473335DEEE9U, 0x3C77CBC661E71E13U},
+	{0x1961219000356AA3U, 0x8B95BEB7FA60E598U},
+	{0x1FB969F40042C54CU, 0x6E7B2E65F8F91EFEU},
+	{0x13D3E2388029BB4FU, 0xC50CFCFFBB9BB35FU},
+	{0x18C8DAC6A0342A23U, 0xB6503C3FAA82A037U},
+	{0x1EFB1178484134ACU, 0xA3E44B4F95234844U},
+	{0x135CEAEB2D28C0EBU, 0xE66EAF11BD360D2BU},
+	{0x183425A5F872F126U, 0xE00A5AD62C839075U},
+	{0x1E412F0F768FAD70U, 0x980CF18BB7A47493U},
+	{0x12E8BD69AA19CC66U, 0x5F0816F752C6C8DCU},
+	{0x17A2ECC414A03F7FU, 0xF6CA1CB527787B13U},
+	{0x1D8BA7F519C84F5FU, 0xF47CA3E2715699D7U},
+	{0x127748F9301D319BU, 0xF8CDE66D86D62026U},
+	{0x17151B377C247E02U, 0xF7016008E88BA830U},
+	{0x1CDA62055B2D9D83U, 0xB4C1B80B22AE923CU},
+	{0x12087D4358FC8272U, 0x50F91306F5AD1B65U},
+	{0x168A9C942F3BA30EU, 0xE53757C8B318623FU},
+	{0x1C2D43B93B0A8BD2U, 0x9E852DBADFDE7ACFU},
+	{0x119C4A53C4E69763U, 0xA3133C94CBEB0CC1U},
+	{0x16035CE8B6203D3CU, 0x8BD80BB9FEE5CFF1U},
+	{0x1B843422E3A84C8BU, 0xAECE0EA87E9F43EEU},
+	{0x1132A095CE492FD7U, 0x4D40C9294F238A75U},
+	{0x157F48BB41DB7BCDU, 0x2090FB73A2EC6D12U},
+	{0x1ADF1AEA12525AC0U, 0x68B53A508BA78856U},
+	{0x10CB70D24B7378B8U, 0x417144725748B536U},
+	{0x14FE4D06DE5056E6U, 0x51CD958EED1AE283U},
+	{0x1A3DE04895E46C9FU, 0xE640FAF2A8619B24U},
+	{0x1066AC2D5DAEC3E3U, 0xEFE89CD7A93D00F7U},
+	{0x14805738B51A74DCU, 0xEBE2C40D938C4134U},
+	{0x19A06D06E2611214U, 0x26DB7510F86F5181U},
+	{0x100444244D7CAB4CU, 0x9849292A9B4592F1U},
+	{0x1405552D60DBD61FU, 0xBE5B73754216F7ADU},
+	{0x1906AA78B912CBA7U, 0xADF25052929CB598U},
+	{0x1F485516E7577E91U, 0x996EE4673743E2FFU},
+	{0x138D352E5096AF1AU, 0xFFE54EC0828A6DDFU},
+	{0x18708279E4BC5AE1U, 0xBFDEA270A32D0957U},
+	{0x1E8CA3185DEB719AU, 0x2FD64B0CCBF84BADU},
+	{0x1317E5EF3AB32700U, 0x5DE5EEE7FF7B2F4CU},
+	{0x17DDDF6B095FF0C0U, 0x755F6AA1FF59FB1FU},
+	{0x1DD55745CBB7ECF0U, 0x92B7454A7F3079E7U},
+	{0x12A5568B9F52F416U, 0x5BB28B4E8F7E4C30U},
+	{0x174EAC2E8727B11BU, 0xF29F2E22335DDF3CU},
+	{0x1D22573A28F19D62U, 0xEF46F9AAC035570BU},
+	{0x123576845997025DU, 0xD58C5C0AB8215667U},
+	{0x16C2D4256FFCC2F5U, 0x4AEF730D6629AC01U},
+	{0x1C73892ECBFBF3B2U, 0x9DAB4FD0BFB41701U},
+	{0x11C835BD3F7D784FU, 0xA28B11E277D08E60U},
+	{0x163A432C8F5CD663U, 0x8B2DD65B15C4B1F9U},
+	{0x1BC8D3F7B3340BFCU, 0x6DF94BF1DB35DE77U},
+	{0x115D847AD000877DU, 0xC4BBCF772901AB0AU},
+	{0x15B4E5998400A95DU, 0x35EAC354F34215CDU},
+	{0x1B221EFFE500D3B4U, 0x8365742A30129B40U},
+	{0x10F5535FEF208450U, 0xD21F689A5E0BA108U},
+	{0x1532A837EAE8A565U, 0x06A742C0F58E894AU},
+	{0x1A7F5245E5A2CEBEU, 0x4851137132F22B9DU},
+	{0x108F936BAF85C136U, 0xED32AC26BFD75B42U},
+	{0x14B378469B673184U, 0xA87F57306FCD3212U},
+	{0x19E056584240FDE5U, 0xD29F2CFC8BC07E97U},
+	{0x102C35F729689EAFU, 0xA3A37C1DD7584F1EU},
+	{0x14374374F3C2C65BU, 0x8C8C5B254D2E62E6U},
+	{0x1945145230B377F2U, 0x6FAF71EEA079FB9FU},
+	{0x1F965966BCE055EFU, 0x0B9B4E6A48987A87U},
+	{0x13BDF7E0360C35B5U, 0x674111026D5F4C94U},
+	{0x18AD75D8438F4322U, 0xC111554308B71FBAU},
+	{0x1ED8D34E547313EBU, 0x7155AA93CAE4E7A8U},
+	{0x13478410F4C7EC73U, 0x26D58A9C5ECF10C9U},
+	{0x1819651531F9E78FU, 0xF08AED437682D4FBU},
+	{0x1E1FBE5A7E786173U, 0xECADA89454238A3AU},
+	{0x12D3D6F88F0B3CE8U, 0x73EC895CB4963664U},
+	{0x1788CCB6B2CE0C22U, 0x90E7ABB3E1BBC3FDU},
+	{0x1D6AFFE45F818F2BU, 0x352196A0DA2AB4FDU},
+	{0x1262DFEEBBB0F97BU, 0x0134FE24885AB11EU},
+	{0x16FB97EA6A9D37D9U, 0xC1823DADAA715D65U},
+	{0x1CBA7DE5054485D0U, 0x31E2CD19150DB4BFU},
+	{0x11F48EAF234AD3A2U, 0x1F2DC02FAD2890F7U},
+	{0x1671B25AEC1D888AU, 0xA6F9303B9872B535U},
+	{0x1C0E1EF1A724EAADU, 0x50B77C4A7E8F6282U},
+	{0x1188D357087712ACU, 0x5272ADAE8F199D91U},
+	{0x15EB082CCA94D757U, 0x670F591A32E004F6U},
+	{0x1B65CA37FD3A0D2DU, 0x40D32F60BF980633U},
+	{0x111F9E62FE44483CU, 0x4883FD9C77BF03E0U},
+	{0x156785FBBDD55A4BU, 0x5AA4FD0395AEC4D8U},
+	{0x1AC1677AAD4AB0DEU, 0x314E3C447B1A760EU},
+	{0x10B8E0ACAC4EAE8AU, 0xDED0E5AACCF089C9U},
+	{0x14E718D7D7625A2DU, 0x96851F15802CAC3BU},
+	{0x1A20DF0DCD3AF0B8U, 0xFC2666DAE037D74AU},
+	{0x10548B68A044D673U, 0x9D980048CC22E68EU},
+	{0x1469AE42C8560C10U, 0x84FE005AFF2BA032U},
+	{0x198419D37A6B8F14U, 0xA63D8071BEF6883EU},
+	{0x1FE52048590672D9U, 0xCFCCE08E2EB42A4EU},
+	{0x13EF342D37A407C8U, 0x21E00C58DD309A70U},
+	{0x18EB0138858D09BAU, 0x2A580F6F147CC10DU},
+	{0x1F25C186A6F04C28U, 0xB4EE134AD99BF150U},
+	{0x137798F428562F99U, 0x7114CC0EC80176D2U},
+	{0x18557F31326BBB7FU, 0xCD59FF127A01D486U},
+	{0x1E6ADEFD7F06AA5FU, 0xC0B07ED7188249A8U},
+	{0x1302CB5E6F642A7BU, 0xD86E4F466F516E09U},
+	{0x17C37E360B3D351AU, 0xCE89E3180B25C98BU},
+	{0x1DB45DC38E0C8261U, 0x822C5BDE0DEF3BEEU},
+	{0x1290BA9A38C7D17CU, 0xF15BB96AC8B58575U},
+	{0x1734E940C6F9C5DCU, 0x2DB2A7C57AE2E6D2U},
+	{0x1D022390F8B83753U, 0x391F51B6D99BA086U},
+	{0x1221563A9B732294U, 0x03B3931248014454U},
+	{0x16A9ABC9424FEB39U, 0x04A077D6DA019569U},
+	{0x1C5416BB92E3E607U, 0x45C895CC9081FAC3U},
+	{0x11B48E353BCE6FC4U, 0x8B9D5D9FDA513CBAU},
+	{0x1621B1C28AC20BB5U, 0xAE84B507D0E58BE8U},
+	{0x1BAA1E332D728EA3U, 0x1A25E249C51EEEE3U},
+	{0x114A52DFFC679925U, 0xF057AD6E1B33554DU},
+	{0x159CE797FB817F6FU, 0x6C6D98C9A2002AA1U},
+	{0x1B04217DFA61DF4BU, 0x4788FEFC0A803549U},
+	{0x10E294EEBC7D2B8FU, 0x0CB59F5D8690214EU},
+	{0x151B3A2A6B9C7672U, 0xCFE30734E83429A1U},
+	{0x1A6208B50683940FU, 0x83DBC9022241340AU},
+	{0x107D457124123C89U, 0xB2695DA15568C086U},
+	{0x149C96CD6D16CBACU, 0x1F03B509AAC2F0A7U},
+	{0x19C3BC80C85C7E97U, 0x26C4A24C1573ACD1U},
+	{0x101A55D07D39CF1EU, 0x783AE56F8D684C03U},
+	{0x1420EB449C8842E6U, 0x16499ECB70C25F03U},
+	{0x19292615C3AA539FU, 0x9BDC067E4CF2F6C4U},
+	{0x1F736F9B3494E887U, 0x82D3081DE02FB476U},
+	{0x13A825C100DD1154U, 0xB1C3E512AC1DD0C9U},
+	{0x18922F31411455A9U, 0xDE34DE57572544FCU},
+	{0x1EB6BAFD91596B14U, 0x55C215ED2CEE963BU},
+	{0x133234DE7AD7E2ECU, 0xB5994DB43C151DE5U},
+	{0x17FEC216198DDBA7U, 0xE2FFA1214B1A655EU},
+	{0x1DFE729B9FF15291U, 0xDBBF89699DE0FEB6U},
+	{0x12BF07A143F6D39BU, 0x2957B5E202AC9F31U},
+	{0x176EC98994F48881U, 0xF3ADA35A8357C6FEU},
+	{0x1D4A7BEBFA31AAA2U, 0x70990C31242DB8BDU},
+	{0x124E8D737C5F0AA5U, 0x865FA79EB69C9376U},
+	{0x16E230D05B76CD4EU, 0xE7F791866443B854U},
+	{0x1C9ABD04725480A2U, 0xA1F575E7FD54A669U},
+	{0x11E0B622C774D065U, 0xA53969B0FE54E801U},
+	{0x1658E3AB7952047FU, 0x0E87C41D3DEA2202U},
+	{0x1BEF1C9657A6859EU, 0xD229B5248D64AA82U},
+	{0x117571DDF6C81383U, 0x435A1136D85EEA91U},
+	{0x15D2CE55747A1864U, 0x143095848E76A536U},
+	{0x1B4781EAD1989E7DU, 0x193CBAE5B2144E83U},
+	{0x110CB132C2FF630EU, 0x2FC5F4CF8F4CB112U},
+	{0x154FDD7F73BF3BD1U, 0xBBB77203731FDD56U},
+	{0x1AA3D4DF50AF0AC6U, 0x2AA54E844FE7D4ACU},
+	{0x10A6650B926D66BBU, 0xDAA75112B1F0E4EBU},
+	{0x14CFFE4E7708C06AU, 0xD15125575E6D1E26U},
+	{0x1A03FDE214CAF085U, 0x85A56EAD360865B0U},
+	{0x10427EAD4CFED653U, 0x7387652C41C53F8EU},
+	{0x14531E58A03E8BE8U, 0x50693E7752368F71U},
+	{0x1967E5EEC84E2EE2U, 0x64838E1526C4334EU},
+	{0x1FC1DF6A7A61BA9AU, 0xFDA4719A70754022U},
+	{0x13D92BA28C7D14A0U, 0xDE86C70086494815U},
+	{0x18CF768B2F9C59C9U, 0x162878C0A7DB9A1AU},
+	{0x1F03542DFB83703BU, 0x5BB296F0D1D280A1U},
+	{0x1362149CBD322625U, 0x194F9E5683239064U},
+	{0x183A99C3EC7EAFAEU, 0x5FA385EC23EC747EU},
+	{0x1E494034E79E5B99U, 0xF78C67672CE7919DU},
+	{0x12EDC82110C2F940U, 0x3AB7C0A07C10BB02U},
+	{0x17A93A2954F3B790U, 0x4965B0C89B14E9C3U},
+	{0x1D9388B3AA30A574U, 0x5BBF1CFAC1DA2433U},
+	{0x127C35704A5E6768U, 0xB957721CB92856A0U},
+	{0x171B42CC5CF60142U, 0xE7AD4EA3E7726C48U},
+	{0x1CE2137F74338193U, 0xA198A24CE14F075AU},
+	{0x120D4C2FA8A030FCU, 0x44FF65700CD16498U},
+	{0x16909F3B92C83D3BU, 0x563F3ECC1005BDBEU},
+	{0x1C34C70A777A4C8AU, 0x2BCF0E7F14072D2EU},
+	{0x11A0FC668AAC6FD6U, 0x5B61690F6C847C3DU},
+	{0x16093B802D578BCBU, 0xF239C35347A59B4CU},
+	{0x1B8B8A6038AD6EBEU, 0xEEC83428198F021FU},
+	{0x1137367C236C6537U, 0x553D20990FF96153U},
+	{0x1585041B2C477E85U, 0x2A8C68BF53F7B9A8U},
+	{0x1AE64521F7595E26U, 0x752F82EF28F5A812U},
+	{0x10CFEB353A97DAD8U, 0x093DB1D57999890BU},
+	{0x1503E602893DD18EU, 0x0B8D1E4AD7FFEB4EU},
+	{0x1A44DF832B8D45F1U, 0x8E7065DD8DFFE622U},
+	{0x106B0BB1FB384BB6U, 0xF9063FAA78BFEFD5U},
+	{0x1485CE9E7A065EA4U, 0xB747CF9516EFEBCAU},
+	{0x19A742461887F64DU, 0xE519C37A5CABE6BDU},
+	{0x1008896BCF54F9F0U, 0xAF301A2C79EB7036U},
+	{0x140AABC6C32A386CU, 0xDAFC20B798664C43U},
+	{0x190D56B873F4C688U, 0x11BB28E57E7FDF54U},
+	{0x1F50AC6690F1F82AU, 0x1629F31EDE1FD72AU},
+	{0x13926BC01A973B1AU, 0x4DDA37F34AD3E67AU},
+	{0x187706B0213D09E0U, 0xE150C5F01D88E019U},
+	{0x1E94C85C298C4C59U, 0x19A4F76C24EB181FU},
+	{0x131CFD3999F7AFB7U, 0xB0071AA39712EF13U},
+	{0x17E43C8800759BA5U, 0x9C08E14C7CD7AAD8U},
+	{0x1DDD4BAA0093028FU, 0x030B199F9C0D958EU},
+	{0x12AA4F4A405BE199U, 0x61E6F003C1887D79U},
+	{0x1754E31CD072D9FFU, 0xBA60AC04B1EA9CD7U},
+	{0x1D2A1BE4048F907FU, 0xA8F8D705DE65440DU},
+	{0x123A516E82D9BA4FU, 0xC99B8663AAFF4A88U},
+	{0x16C8E5CA239028E3U, 0xBC0267FC95BF1D2AU},
+	{0x1C7B1F3CAC74331CU, 0xAB0301FBBB2EE474U},
+	{0x11CCF385EBC89FF1U, 0xEAE1E13D54FD4EC9U},
+	{0x1640306766BAC7EEU, 0x659A598CAA3CA27BU},
+	{0x1BD03C81406979E9U, 0xFF00EFEFD4CBCB1AU},
+	{0x116225D0C841EC32U, 0x3F6095F5E4FF5EF0U},
+	{0x15BAAF44FA52673EU, 0xCF38BB735E3F36ACU},
+	{0x1B295B1638E7010EU, 0x8306EA5035CF0457U},
+	{0x10F9D8EDE39060A9U, 0x11E4527221A162B6U},
+	{0x15384F295C7478D3U, 0x565D670EAA09BB64U},
+	{0x1A8662F3B3919708U, 0x2BF4C0D2548C2A3DU},
+	{0x1093FDD8503AFE65U, 0x1B78F88374D79A66U},
+	{0x14B8FD4E6449BDFEU, 0x625736A4520D8100U},
+	{0x19E73CA1FD5C2D7DU, 0xFAED044D6690E140U},
+	{0x103085E53E599C6EU, 0xBCD422B0601A8CC8U},
+	{0x143CA75E8DF0038AU, 0x6C092B5C78212FFAU},
+	{0x194BD136316C046DU, 0x070B763396297BF8U},
+	{0x1F9EC583BDC70588U, 0x48CE53C07BB3DAF6U},
+	{0x13C33B72569C6375U, 0x2D80F4584D5068DAU},
+	{0x18B40A4EEC437C52U, 0x78E1316E60A48310U},
+};
+
+/* 2^k / 5^i + 1 normalized to 125 bits for i in [0, 342) */
+static const uint64_t cast_pow5_inv_split[][2] = {
+	{0x2000000000000000U, 0x0000000000000001U},
+	{0x1999999999999999U, 0x999999999999999AU},
+	{0x147AE147AE147AE1U, 0x47AE147AE147AE15U},
+	{0x10624DD2F1A9FBE7U, 0x6C8B4395810624DEU},
+	{0x1A36E2EB1C432CA5U, 0x7A786C226809D496U},
+	{0x14F8B588E368F084U, 0x61F9F01B866E43ABU},
+	{0x10C6F7A0B5ED8D36U, 0xB4C7F34938583622U},
+	{0x1AD7F29ABCAF4857U, 0x87A6520EC08D236AU},
+	{0x15798EE2308C39DFU, 0x9FB841A566D74F88U},
+	{0x112E0BE826D694B2U, 0xE62D01511F12A607U},
+	{0x1B7CDFD9D7BDBAB7U, 0xD6AE6881CB5109A4U},
+	{0x15FD7FE17964955FU, 0xDEF1ED34A2A73AEAU},
+	{0x119799812DEA1119U, 0x7F27F0F6E885C8BBU},
+	{0x1C25C268497681C2U, 0x650CB4BE40D60DF8U},
+	{0x16849B86A12B9B01U, 0xEA70909833DE7193U},
+	{0x1203AF9EE756159BU, 0x21F3A6E0297EC143U},
+	{0x1CD2B297D889BC2BU, 0x6985D7CD0F313537U},
+	{0x170EF54646D49689U, 0x2137DFD73F5A90F9U},
+	{0x12725DD1D243ABA0U, 0xE75FE645CC4873FAU},
+	{0x1D83C94FB6D2AC34U, 0xA5663D3C7A0D865DU},
+	{0x179CA10C9242235DU, 0x511E976394D79EB1U},
+	{0x12E3B40A0E9B4F7DU, 0xDA7EDF82DD794BC1U},
+	{0x1E392010175EE596U, 0x2A6498D1625BAC68U},
+	{0x182DB34012B25144U, 0xEEB6E0A781E2F053U},
+	{0x1357C299A88EA76AU, 0x58924D52CE4F26A9U},
+	{0x1EF2D0F5DA7DD8AAU, 0x27507BB7B07EA441U},
+	{0x18C240C4AECB13BBU, 0x52A6C95FC0655034U},
+	{0x13CE9A36F23C0FC9U, 0x0EEBD44C99EAA690U},
+	{0x1FB0F6BE50601941U, 0xB17953ADC3110A80U},
+	{0x195A5EFEA6B34767U, 0xC12DDC8B02740867U},
+	{0x14484BFEEBC29F86U, 0x3424B06F3529A052U},
+	{0x1039D66589687F9EU, 0x901D59F290EE19DBU},
+	{0x19F623D5A8A73297U, 0x4CFBC31DB4B0295FU},
+	{0x14C4E977BA1F5BACU, 0x3D9635B15D59BAB2U},
+	{0x109D8792FB4C4956U, 0x97AB5E277DE16228U},
+	{0x1A95A5B7F87A0EF0U, 0xF2ABC9D8C9689D0DU},
+	{0x154484932D2E725AU, 0x5BBCA17A3ABA173EU},
+	{0x11039D428A8B8EAEU, 0xAFCA1AC82EFB45CBU},
+	{0x1B38FB9DAA78E44AU, 0xB2DCF7A6B1920945U},
+	{0x15C72FB1552D836EU, 0xF57D92EBC141A104U},
+	{0x116C262777579C58U, 0xC46475896767B403U},
+	{0x1BE03D0BF225C6F4U, 0x6D6D88DBD8A5ECD2U},
+	{0x164CFDA3281E38C3U, 0x8ABE071646EB23DBU},
+	{0x11D7314F534B609CU, 0x6EFE6C11D255B649U},
+	{0x1C8B821885456760U, 0xB197134FB6EF8A0EU},
+	{0x16D601AD376AB91AU, 0x27AC0F72F8BFA1A5U},
+	{0x1244CE242C5560E1U, 0xB95672C260994E1EU},
+	{0x1D3AE36D13BBCE35U, 0xF5571E03CDC21695U},
+	{0x17624F8A762FD82BU, 0x2AAC18030B01ABABU},
+	{0x12B50C6EC4F31355U, 0xBBBCE0026F348956U},
+	{0x1DEE7A4AD4B81EEFU, 0x92C7CCD0B1EDA889U},
+	{0x17F1FB6F10934BF2U, 0xDBD30A408E57BA07U},
+	{0x1327FC58DA0F6FF5U, 0x7CA8D50071DFC806U},
+	{0x1EA6608E29B24CBBU, 0xFAA7BB33E9660CD6U},
+	{0x18851A0B548EA3C9U, 0x9552FC298784D711U},
+	{0x139DAE6F76D88307U, 0xAAA8C9BAD2D0AC0EU},
+	{0x1F62B0B257C0D1A5U, 0xDDDADC5E1E1AACE3U},
+	{0x191BC08EAC9A4151U, 0x7E48B04B4B488A4FU},
+	{0x141633A556E1CDDAU, 0xCB6D59D5D5D3A1D9U},
+	{0x1011C2EAABE7D7E2U, 0x3C577B1177DC817BU},
+	{0x19B604AAACA62636U, 0xC6F25E825960CF2AU},
+	{0x14919D5556EB51C5U, 0x6BF518684780A5BBU},
+	{0x10747DDDDF22A7D1U, 0x232A79ED06008496U},
+	{0x1A53FC9631D10C81U, 0xD1DD8FE1A3340756U},
+	{0x150FFD44F4A73D34U, 0xA7E4731AE8F66C45U},
+	{0x10D9976A5D52975DU, 0x531D28E253F8569EU},
+	{0x1AF5BF109550F22EU, 0xEB61DB03B98D5762U},
+	{0x159165A6DDDA5B58U, 0xBC4E48CFC7A445E8U},
+	{0x11411E1F17E1E2ADU, 0x6371D3D96C836B20U},
+	{0x1B9B6364F3030448U, 0x9F1C8628AD9F11CDU},
+	{0x1615E91D8F359D06U, 0xE5B06B53BE18DB0BU},
+	{0x11AB20E472914A6BU, 0xEAF3890FCB4715A2U},
+	{0x1C45016D841BAA46U, 0x44B8DB4C7871BC37U},
+	{0x169D9ABE03495505U, 0x03C715D6C6C1635FU},
+	{0x1217AEFE69077737U, 0x3638DE456BCDE919U},
+	{0x1CF2B1970E725858U, 0x56C163A2461641C1U},
+	{0x17288E1271F51379U, 0xDF011C81D1AB67CEU},
+	{0x1286D80EC190DC61U, 0x7F3416CE4155ECA5U},
+	{0x1DA48CE468E7C702U, 0x6520247D3556476EU},
+	{0x17B6D71D20B96C01U, 0xEA801D30F7783925U},
+	{0x12F8AC174D612334U, 0xBB99B0F3F92CFA84U},
+	{0x1E5AACF215683854U, 0x5F5C4E532847F739U},
+	{0x18488A5B44536043U, 0x7F7D0B75B9D32C2EU},
+	{0x136D3B7C36A919CFU, 0x9930D5F7C7DC2358U},
+	{0x1F152BF9F10E8FB2U, 0x8EB4898C72F9D226U},
+	{0x18DDBCC7F40BA628U, 0x722A07A38F2E41B8U},
+	{0x13E497065CD61E86U, 0xC1BB394FA5BE9AFAU},
+	{0x1FD424D6FAF030D7U, 0x9C5EC2190930F7F6U},
+	{0x197683DF2F268D79U, 0x49E56814075A5FF8U},
+	{0x145ECFE5BF520AC7U, 0x6E51201005E1E660U},
+	{0x104BD984990E6F05U, 0xF1DA800CD181851AU},
+	{0x1A12F5A0F4E3E4D6U, 0x4FC400148268D4F5U},
+	{0x14DBF7B3F71CB711U, 0xD96999AA01ED772BU},
+	{0x10AFF95CC5B09274U, 0xADEE1488018AC5BCU},
+	{0x1AB328946F80EA54U, 0x497CEDA668DE092CU},
+	{0x155C2076BF9A5510U, 0x3ACA57B853E4D424U},
+	{0x1116805EFFAEAA73U, 0x623B7960431D7683U},
+	{0x1B5733CB32B110B8U, 0x9D2BF566D1C8BD9EU},
+	{0x15DF5CA28EF40D60U, 0x7DBCC452416D647FU},
+	{0x117F7D4ED8C33DE6U, 0xCAFD69DB678AB6CCU},
+	{0x1BFF2EE48E052FD7U, 0xAB2F0FC572778ADFU},
+	{0x1665BF1D3E6A8CACU, 0x88F273045B92D580U},
+	{0x11EAFF4A98553D56U, 0xD3F528D049424466U},
+	{0x1CAB3210F3BB9557U, 0xB988414D4203A0A3U},
+	{0x16EF5B40C2FC7779U, 0x6139CDD76802E6E9U},
+	{0x125915CD68C9F92DU, 0xE761717920025254U},
+	{0x1D5B561574765B7CU, 0xA568B58E999D5086U},
+	{0x177C44DDF6C515FDU, 0x5120913EE14AA6D2U},
+	{0x12C9D0B1923744CAU, 0xA74D40FF1AA21F0EU},
+	{0x1E0FB44F50586E11U, 0x0BAECE64F769CB4AU},
+	{0x180C903F7379F1A7U, 0x3C8BD850C5EE3C3BU},
+	{0x133D4032C2C7F485U, 0xCA0979DA37F1C9C9U},
+	{0x1EC866B79E0CBA6FU, 0xA9A8C2F6BFE942DBU},
+	{0x18A0522C7E709526U, 0x2153CF2BCCBA9BE3U},
+	{0x13B374F06526DDB8U, 0x1AA9728970954982U},
+	{0x1F8587E7083E2F8CU, 0xF775840F1A88759DU},
+	{0x19379FEC0698260AU, 0x5F9136727BA05E17U},
+	{0x142C7FF0054684D5U, 0x1940F85B9619E4DFU},
+	{0x1023998CD1053710U, 0xE100C6AFAB47EA4CU},
+	{0x19D28F47B4D524E7U, 0xCE67A44C453FDD47U},
+	{0x14A8729FC3DDB71FU, 0xD852E9D69DCCB106U},
+	{0x1086C219697E2C19U, 0x79DBEE454B0A2738U},
+	{0x1A71368F0F30468FU, 0x295FE3A211A9D859U},
+	{0x15275ED8D8F36BA5U, 0xBAB31C81A7BB137AU},
+	{0x10EC4BE0AD8F8951U, 0x6228E39AEC95A92FU},
+	{0x1B13AC9AAF4C0EE8U, 0x9D0E38F7E0EF7517U},
+	{0x15A956E225D67253U, 0xB0D82D931A592A79U},
+	{0x11544581B7DEC1DCU, 0x8D79BE0F4847552EU},
+	{0x1BBA08CF8C979C94U, 0x158F967EDA0BBB7CU},
+	{0x162E6D72D6DFB076U, 0x77A611FF14D62F97U},
+	{0x11BEBDF578B2F391U, 0xF951A7FF43DE8C79U},
+	{0x1C6463225AB7EC1CU, 0xC21C3FFED2FDAD8EU},
+	{0x16B6B5B5155FF017U, 0x01B0333242648AD8U},
+	{0x122BC490DDE659ACU, 0x0159C28E9B83A246U},
+	{0x1D12D41AFCA3C2ACU, 0xCEF604175F3903A3U},
+	{0x17424348CA1C9BBDU, 0x725E69AC4C2D9C83U},
+	{0x129B69070816E2FDU, 0xF5185489D68AE39CU},
+	{0x1DC574D80CF16B2FU, 0xEE8D540FBDAB05C6U},
+	{0x17D12A4670C1228CU, 0xBED77672FE226B05U},
+	{0x130DBB6B8D674ED6U, 0xFF12C528CB4EBC04U},
+	{0x1E7C5F127BD87E24U, 0xCB513B74787DF9A0U},
+	{0x18637F41FCAD31B7U, 0x090DC929F9FE614DU},
+	{0x1382CC34CA2427C5U, 0xA0D7D42194CB810AU},
+	{0x1F37AD21436D0C6FU, 0x67BFB9CF5478CE77U},
+	{0x18F9574DCF8A7059U, 0x1FCC94A5DD2D71F9U},
+	{0x13FAAC3E3FA1F37AU, 0x7FD6DD517DBDF4C7U},
+	{0x1FF779FD329CB8C3U, 0xFFBE2EE8C92FEE0BU},
+	{0x1992C7FDC216FA36U, 0x6631BF20A0F324D6U},
+	{0x14756CCB01ABFB5EU, 0xB827CC1A1A5C1D78U},
+	{0x105DF0A267BCC918U, 0x935309AE7B7CE460U},
+	{0x1A2FE76A3F9474F4U, 0x1EEB42B0C594A099U},
+	{0x14F31F8832DD2A5CU, 0xE58902270476E6E1U},
+	{0x10C27FA028B0EEB0U, 0xB7A0CE859D2BEBE7U},
+	{0x1AD0CC33744E4AB4U, 0x59014A6F61DFDFD8U},
+	{0x1573D68F903EA229U, 0xE0CDD525E7E64CADU},
+	{0x11297872D9CBB4EEU, 0x4D7177518651D6F1U},
+	{0x1B758D848FAC54B0U, 0x7BE8BEE8D6E957E8U},
+	{0x15F7A46A0C89DD59U, 0xFCBA3253DF211320U},
+	{0x1192E9EE706E4AAEU, 0x63C8284318E74280U},
+	{0x1C1E43171A4A1117U, 0x060D0D3827D86A66U},
+	{0x167E9C127B6E7412U, 0x6B3DA42CECAD21EBU},
+	{0x11FEE341FC585CDBU, 0x88FE1CF0BD574E56U},
+	{0x1CCB0536608D615FU, 0x419694B462254A23U},
+	{0x1708D0F84D3DE77FU, 0x67ABAA29E81DD4E9U},
+	{0x126D73F9D764B932U, 0xB95621BB2017DD87U},
+	{0x1D7BECC2F23AC1EAU, 0xC223692B668C95A5U},
+	{0x179657025B6234BBU, 0xCE82BA891ED6DE1DU},
+	{0x12DEAC01E2B4F6FCU, 0xA53562074BDF1818U},
+	{0x1E3113363787F194U, 0x3B889CD87964F359U},
+	{0x18274291C6065ADCU, 0xFC6D4A46C783F5E1U},
+	{0x13529BA7D19EAF17U, 0x30576E9F06032B1AU},
+	{0x1EEA92A61C311825U, 0x1A257DCB3CD1DE90U},
+	{0x18BBA884E35A79B7U, 0x481DFE3C30A7E540U},
+	{0x13C9539D82AEC7C5U, 0xD34B31C9C0865100U},
+	{0x1FA885C8D117A609U, 0x5211E942CDA3B4CDU},
+	{0x19539E3A40DFB807U, 0x74DB21023E1C90A4U},
+	{0x1442E4FB67196005U, 0xF715B401CB4A0D50U},
+	{0x103583FC527AB337U, 0xF8DE299B09080AA7U},
+	{0x19EF3993B72AB859U, 0x8E304291A80CDDD7U},
+	{0x14BF6142F8EEF9E1U, 0x3E8D020E200A4B13U},
+	{0x10991A9BFA58C7E7U, 0x653D9B3E80083C0FU},
+	{0x1A8E90F9908E0CA5U, 0x6EC8F864000D2CE4U},
+	{0x153EDA614071A3B7U, 0x8BD3F9E999A423EAU},
+	{0x10FF151A99F482F9U, 0x3CA994BAE1501CBBU},
+	{0x1B31BB5DC320D18EU, 0xC775BAC49BB3612BU},
+	{0x15C162B168E70E0BU, 0xD2C4956A16291A89U},
+	{0x11678227871F3E6FU, 0xDBD0778811BA7BA1U},
+	{0x1BD8D03F3E9863E6U, 0x2C80BF401C5D929BU},
+	{0x16470CFF6546B651U, 0xBD33CC3349E47549U},
+	{0x11D270CC51055EA7U, 0xCA8FD68F6E505DD4U},
+	{0x1C83E7AD4E6EFDD9U, 0x4419574BE3B3C953U},
+	{0x16CFEC8AA52597E1U, 0x0347790982F63AA9U},
+	{0x123FF06EEA847980U, 0xCF6C60D468C4FBBAU},
+	{0x1D331A4B10D3F59AU, 0xE57A34870E07F92AU},
+	{0x175C1508DA432AE2U, 0x512E906C0B399422U},
+	{0x12B010D3E1CF5581U, 0xDA8BA6BCD5C7A9B5U},
+	{0x1DE6815302E5559CU, 0x90DF712E22D90F87U},
+	{0x17EB9AA8CF1DDE16U, 0xDA4C5A8B4F140C6CU},
+	{0x1322E220A5B17E78U, 0xAEA37BA2A5A9A38AU},
+	{0x1E9E369AA2B59727U, 0x7DD25F6AA2A905A9U},
+	{0x187E92154EF7AC1FU, 0x97DB7F888220D154U},
+	{0x139874DDD8C6234CU, 0x797C6606CE80A777U},
+	{0x1F5A549627A36BADU, 0x8F2D700AE4010BF1U},
+	{0x191510781FB5EFBEU, 0x0C2459A25000D65AU},
+	{0x1410D9F9B2F7F2FEU, 0x701D1481D99A4515U},
+	{0x100D7B2E28C65BFEU, 0xC017439B147B6A77U},
+	{0x19AF2B7D0E0A2CCAU, 0xCCF205C4ED9243F2U},
+	{0x148C22CA71A1BD6FU, 0x0A5B37D0BE0E9CC2U},
+	{0x10701BD527B4978CU, 0x0848F973CB3EE3CEU},
+	{0x1A4CF9550C5425ACU, 0xDA0E5BEC78649FB0U},
+	{0x150A6110D6A9B7BDU, 0x7B3EAFF060507FC0U},
+	{0x10D51A73DEEE2C97U, 0x95CBBFF380406633U},
+	{0x1AEE90B964B04758U, 0xEFAC665266CD7052U},
+	{0x158BA6FAB6F36C47U, 0x2623850EB8A459DBU},
+	{0x113C85955F29236CU, 0x1E82D0D893B6AE49U},
+	{0x1B9408EEFEA838ACU, 0xFD9E1AF41F8AB075U},
+	{0x16100725988693BDU, 0x97B1AF29B2D559F7U},
+	{0x11A66C1E139EDC97U, 0xAC8E25BAF5777B2CU},
+	{0x1C3D79C9B8FE2DBFU, 0x7A7D092B2258C513U},
+	{0x169794A160CB57CCU, 0x61FDA0EF4EAD6A76U},
+	{0x1212DD4DE7091309U, 0xE7FE1A590BBDEEC5U},
+	{0x1CEAFBAFD80E84DCU, 0xA6635D5B45FCB13AU},
+	{0x172262F3133ED0B0U, 0x851C4AAF6B308DC8U},
+	{0x1281E8C275CBDA26U, 0xD0E36EF2BC26D7D4U},
+	{0x1D9CA79D894629D7U, 0xB49F17EAC6A48C86U},
+	{0x17B08617A104EE46U, 0x2A18DFEF0550706BU},
+	{0x12F39E794D9D8B6BU, 0x54E0B3259DD9F389U},
+	{0x1E5297287C2F4578U, 0x87CDEB6F62F65274U},
+	{0x18421286C9BF6AC6U, 0xD30B22BF825EA85DU},
+	{0x13680ED23AFF889FU, 0x0F3C1BCC684BB9E4U},
+	{0x1F0CE4839198DA98U, 0x18602C7A4079296DU},
+	{0x18D71D360E13E213U, 0x46B356C833942124U},
+	{0x13DF4A91A4DCB4DCU, 0x388F78A029434DB6U},
+	{0x1FCBAA82A1612160U, 0x5A7F2766A86BAF8AU},
+	{0x196FBB9BB44DB44DU, 0x153285EBB9EFBFA2U},
+	{0x145962E2F6A4903DU, 0xAA8ED189618C994EU},
+	{0x1047824F2BB6D9CAU, 0xEED8A7A11AD6E10CU},
+	{0x1A0C03B1DF8AF611U, 0x7E27729B5E249B45U},
+	{0x14D6695B193BF80DU, 0xFE85F549181D4904U},
+	{0x10AB877C142FF9A4U, 0xCB9E5DD4134AA0D0U},
+	{0x1AAC0BF9B9E65C3AU, 0xDF63C9535211014DU},
+	{0x15566FFAFB1EB02FU, 0x191CA10F74DA6771U},
+	{0x1111F32F2F4BC025U, 0xADB080D92A4852C1U},
+	{0x1B4FEB7EB212CD09U, 0x15E7348EAA0D5134U},
+	{0x15D98932280F0A6DU, 0xAB1F5D3EEE710DC4U},
+	{0x117AD428200C0857U, 0xBC1917658B8DA49DU},
+	{0x1BF7B9D9CCE00D59U, 0x2CF4F23C127C3A94U},
+	{0x165FC7E170B33DE0U, 0xF0C3F4FCDB969543U},
+	{0x11E6398126F5CB1AU, 0x5A365D9716121103U},
+	{0x1CA38F350B22DE90U, 0x9056FC24F01CE804U},
+	{0x16E93F5DA2824BA6U, 0xD9DF301D8CE3ECD0U},
+	{0x125432B14ECEA2EBU, 0xE17F59B13D8323DAU},
+	{0x1D53844EE47DD179U, 0x68CBC2B52F38395CU},
+	{0x177603725064A794U, 0x53D6355DBF602DE3U},
+	{0x12C4CF8EA6B6EC76U, 0xA9782AB165E68B1CU},
+	{0x1E07B27DD78B13F1U, 0x0F26AAB56FD744FAU},
+	{0x18062864AC6F4327U, 0x3F52222ABFDF6A62U},
+	{0x1338205089F29C1FU, 0x65DB4E88997F884EU},
+	{0x1EC033B40FEA9365U, 0x6FC54A7428CC0D4AU},
+	{0x1899C2F673220F84U, 0x596AA1F68709A43BU},
+	{0x13AE3591F5B4D936U, 0xADEEE7F86C07B696U},
+	{0x1F7D228322BAF524U, 0x497E3FF3E00C5756U},
+	{0x1930E868E89590E9U, 0xD464FFF64CD6AC45U},
+	{0x14272053ED4473EEU, 0x4383FFF83D7889D1U},
+	{0x101F4D0FF1038FF1U, 0xCF9CCCC69793A174U},
+	{0x19CBAE7FE805B31CU, 0x7F6147A425B90252U},
+	{0x14A2F1FFECD15C16U, 0xCC4DD2E9B7C7350FU},
+	{0x10825B3323DAB012U, 0x3D0B0F215FD290D9U},
+	{0x1A6A2B85062AB350U, 0x61AB4B689950E7C1U},
+	{0x1521BC6A6B555C40U, 0x4E22A2BA1440B967U},
+	{0x10E7C9EEBC4449CDU, 0x0B4EE894DD009453U},
+	{0x1B0C764AC6D3A948U, 0x1217DA87C800ED51U},
+	{0x15A391D56BDC876CU, 0xDB46486CA000BDDAU},
+	{0x114FA7DDEFE39F8AU, 0x490506BD4CCD64AFU},
+	{0x1BB2A62FE638FF43U, 0xA8080AC87AE23AB1U},
+	{0x162884F31E93FF69U, 0x5339A239FBE82EF4U},
+	{0x11BA03F5B20FFF87U, 0x75C7B4FB2FECF25DU},
+	{0x1C5CD322B67FFF3FU, 0x22D92191E647EA2EU},
+	{0x16B0A8E891FFFF65U, 0xB57A8141850654F2U},
+	{0x1226ED86DB3332B7U, 0xC4620101373843F5U},
+	{0x1D0B15A491EB8459U, 0x3A366801F1F39FEEU},
+	{0x173C115074BC69E0U, 0xFB5EB99B27F6198BU},
+	{0x129674405D6387E7U, 0x2F7EFAE2865E7AD6U},
+	{0x1DBD86CD6238D971U, 0xE597F7D0D6FD9156U},
+	{0x17CAD23DE82D7AC1U, 0x8479930D78CADAABU},
+	{0x1308A831868AC89AU, 0xD06142712D6F1556U},
+	{0x1E74404F3DAADA91U, 0x4D686A4EAF182222U},
+	{0x185D003F6488AEDAU, 0xA453883EF279B4E8U},
+	{0x137D99CC506D58AEU, 0xE9DC6CFF28615D87U},
+	{0x1F2F5C7A1A488DE4U, 0xA960AE650D6895A4U},
+	{0x18F2B061AEA07183U, 0xBAB3BEB73DED4483U},
+	{0x13F559E7BEE6C136U, 0x2EF6322C318A9D36U},
+	{0x1FEEF63F97D79B89U, 0xE4BD1D13827761F0U},
+	{0x198BF832DFDFAFA1U, 0x83CA7DA9352C4E5AU},
+	{0x146FF9C24CB2F2E7U, 0x9CA1FE20F756A515U},
+	{0x1059949B708F28B9U, 0x4A1B31B3F9121DAAU},
+	{0x1A28EDC580E50DF5U, 0x435EB5ECC1B695DDU},
+	{0x14ED8B04671DA4C4U, 0x35E55E57015EDE4AU},
+	{0x10BE08D0527E1D69U, 0xC4B77EAC0118B1D5U},
+	{0x1AC9A7B3B7302F0FU, 0xA12597799B5AB622U},
+	{0x156E1FC2F8F358D9U, 0x4DB7AC6149155E81U},
+	{0x1124E63593F5E0ADU, 0xD7C6238107444B9BU},
+	{0x1B6E3D2286563449U, 0x593D059B3ED3AC2BU},
+	{0x15F1CA820511C36DU, 0xE0FD9E15CBDC89BCU},
+	{0x118E3B9B37416924U, 0xB3FE18116FE3A163U},
+	{0x1C16C5C525357507U, 0x866359B57FD29BD1U},
+	{0x16789E3750F790D2U, 0xD1E91491330EE30EU},
+	{0x11FA182C40C60D75U, 0x74BA76DA8F3F1C0BU},
+	{0x1CC359E067A348BBU, 0xEDF72490E531C678U},
+	{0x1702AE4D1FB5D3C9U, 0x8B2C1D40B75B052DU},
+	{0x12688B70E62B0FD4U, 0x6F567DCD5F7C0424U},
+	{0x1D74124E3D11B2EDU, 0x7EF0C94898C66D06U},
+	{0x17900EA4FDA7C257U, 0x98C0A106E09EBD9FU},
+	{0x12D9A550CAEC9B79U, 0x470080D24D4BCAE6U},
+	{0x1E29088144ADC58EU, 0xD800CE1D487944A2U},
+	{0x1820D39A9D57D13FU, 0x1333D8176D2DD082U},
+	{0x134D76154AACA765U, 0xA8F646792424A6CEU},
+	{0x1EE25688777AA56FU, 0x74BD3D8EA03AA47DU},
+	{0x18B51206C5FBB78CU, 0x5D64313EE6955064U},
+	{0x13C40E6BD1962C70U, 0x4AB68DCBEBAAA6B7U},
+	{0x1FA01712E8F0471AU, 0x1124161312AAA457U},
+	{0x194CDF4253F36C14U, 0xDA8344DC0EEEE9DFU},
+	{0x143D7F6843292343U, 0xE2029D7CD8BF2180U},
+	{0x103132B9CF541C36U, 0x4E687DFD7A328133U},
+	{0x19E851294BB9C6BDU, 0x4A40C9959050CEB8U},
+	{0x14B9DA876FC7D231U, 0x0833D477A6A70BC6U},
+	{0x1094AED2BFD30E8DU, 0xA02976C61EEC096BU},
+	{0x1A877E1DFFB81749U, 0x004257A364ACDBDFU},
+	{0x153931B1996012A0U, 0xCD01DFB5EA23E319U},
+	{0x10FA8E27ADE6754DU, 0x70CE4C91881CB5AEU},
+	{0x1B2A7D0C4970BBAFU, 0x1AE3ADB5A69455E2U},
+	{0x15BB973D078D62F2U, 0x7BE957C4854377E8U},
+	{0x1162DF64060AB58EU, 0xC987796A0435F987U},
+	{0x1BD1656CD67788E4U, 0x75A58F1006BCC271U},
+	{0x16411DF0AB92D3E9U, 0xF7B7A5A66BCA3527U},
+	{0x11CDB18D560F0FEEU, 0x5FC61E1EBCA1C41FU},
+	{0x1C7C4F4889B1B316U, 0xFFA363646102D365U},
+	{0x16C9D906D48E28DFU, 0x32E91C504D9BDC51U},
+	{0x123B140576D820B2U, 0x8F20E37371497D0EU},
+	{0x1D2B533BF159CDEAU, 0x7E9B0585820F2E7CU},
+	{0x1755DC2FF447D7EEU, 0xCBAF379E01A5BECAU},
+	{0x12AB168CC36CACBFU, 0x0958F94B348498A1U},
+};
+
+/* Width of multipliers in cast_pow5_split and cast_pow5_inv_split */
+#define CAST_POW5_BITS 125
+#define CAST_POW5_INV_BITS 125
+
+/* floor(e * log10(2)) for e in [0, 1650] */
+static inline uint32_t cast_log10_pow2(int32_t e)
+{
+	return ((uint32_t)e * 78913U) >> 18;
+}
+
+/* floor(e * log10(5)) for e in [0, 2620] */
+static inline uint32_t cast_log10_pow5(int32_t e)
+{
+	return ((uint32_t)e * 732923U) >> 20;
+}
+
+/* Number of bits of 5^e for e in [0, 3528], or 1 for e = 0 */
+static inline int32_t cast_pow5_bits(int32_t e)
+{
+	return (int32_t)(((uint32_t)e * 1217359U) >> 19) + 1;
+}
+
+/* Check if value is divisible by 5^p */
+static inline bool cast_multiple_of_pow5(uint64_t value, uint32_t p)
+{
+	uint32_t count = 0U;
+	while (value % 5U == 0U) {
+		value /= 5U;
+		++count;
+	}
+	return count >= p;
+}
+
+/* Check if value is divisible by 2^p */
+static inline bool cast_multiple_of_pow2(uint64_t value, uint32_t p)
+{
+	return (value & ((UINT64_C(1) << p) - 1U)) == 0U;
+}
+
+/* Multiply m by 128-bit multiplier and shift the product right by j > 64 */
+static inline uint64_t cast_mul_shift_64(uint64_t m, const uint64_t *mul,
+					 int32_t j)
+{
+	uint64_t high0 = 0U, low0 = 0U, high1 = 0U, low1 = 0U;
+	cast_mul_64(m, mul[1], &high0, &low0);
+	cast_mul_64(m, mul[0], &high1, &low1);
+	uint64_t sum = high0 + low1;
+	if (sum < high0)
+		++high1;
+	uint32_t shift = (uint32_t)(j - 64);
+	return (high1 << (64U - shift)) | (sum >> shift);
+}
+
+/* Multiply 32-bit m by upper half of a multiplier and shift it right by
+ * j > 32 */
+static inline uint32_t cast_mul_shift_32(uint32_t m, uint64_t factor,
+					 int32_t j)
+{
+	uint64_t low = (uint64_t)m * (uint32_t)factor;
+	uint64_t high = (uint64_t)m * (uint32_t)(factor >> 32);
+	return (uint32_t)(((low >> 32) + high) >> (j - 32));
+}
+
+/**
+ * Find the shortest decimal number which rounds to a double.
+ *
+ * This is the Ryu algorithm by Ulf Adams.
+ *
+ * @param mantissa   Stored mantissa bits.
+ * @param exponent   Stored exponent bits, the value must be finite and
+ *                   nonzero.
+ * @param exp10      Where to store the decimal exponent.
+ *
+ * @return Decimal digits.
+ */
+static uint64_t cast_shortest_double(uint64_t mantissa, uint32_t exponent,
+				     int32_t *exp10)
+{
+	int32_t e2;
+	uint64_t m2;
+	if (exponent == 0U) {
+		e2 = 1 - 1023 - 52 - 2;
+		m2 = mantissa;
+	} else {
+		e2 = (int32_t)exponent - 1023 - 52 - 2;
+		m2 = (UINT64_C(1) << 52) | mantissa;
+	}
+	bool accept_bounds = (m2 & 1U) == 0U;
+
+	/* Interval of decimal numbers which round to the value is
+	 * [mv - 1 - mm_shift, mv + 2] * 2^e2 */
+	uint64_t mv = 4U * m2;
+	uint32_t mm_shift = mantissa != 0U || exponent <= 1U;
+
+	uint64_t vr, vp, vm;
+	int32_t e10;
+	bool vm_trailing_zeros = false;
+	bool vr_trailing_zeros = false;
+	if (e2 >= 0) {
+		uint32_t q = cast_log10_pow2(e2) - (e2 > 3);
+		e10 = (int32_t)q;
+		int32_t k = CAST_POW5_INV_BITS + cast_pow5_bits((int32_t)q) - 1;
+		int32_t i = -e2 + (int32_t)q + k;
+		const uint64_t *mul = cast_pow5_inv_split[q];
+		vr = cast_mul_shift_64(mv, mul, i);
+		vp = cast_mul_shift_64(mv + 2U, mul, i);
+		vm = cast_mul_shift_64(mv - 1U - mm_shift, mul, i);
+		if (q <= 21U) {
+			/* Only one of mp, mv and mm can be a multiple of 5 */
+			if (mv % 5U == 0U)
+				vr_trailing_zeros = cast_multiple_of_pow5(mv, q);
+			else if (accept_bounds)
+				vm_trailing_zeros = cast_multiple_of_pow5(
+				    mv - 1U - mm_shift, q);
+			else
+				vp -= cast_multiple_of_pow5(mv + 2U, q);
+		}
+	} else {
+		uint32_t q = cast_log10_pow5(-e2) - (-e2 > 1);
+		e10 = (int32_t)q + e2;
+		int32_t i = -e2 - (int32_t)q;
+		int32_t k = cast_pow5_bits(i) - CAST_POW5_BITS;
+		int32_t j = (int32_t)q - k;
+		const uint64_t *mul = cast_pow5_split[i];
+		vr = cast_mul_shift_64(mv, mul, j);
+		vp = cast_mul_shift_64(mv + 2U, mul, j);
+		vm = cast_mul_shift_64(mv - 1U - mm_shift, mul, j);
+		if (q <= 1U) {
+			/* mv has at least two trailing zero bits, mm has one
+			 * if mm_shift is 1 and mp always has one */
+			vr_trailing_zeros = true;
+			if (accept_bounds)
+				vm_trailing_zeros = mm_shift == 1U;
+			else
+				--vp;
+		} else if (q < 63U) {
+			vr_trailing_zeros = cast_multiple_of_pow2(mv, q);
+		}
+	}
+
+	/* Remove digits while the interval still contains a number */
+	int32_t removed = 0;
+	uint64_t last_removed = 0U;
+	uint64_t output;
+	if (vm_trailing_zeros || vr_trailing_zeros) {
+		while (vp / 10U > vm / 10U) {
+			vm_trailing_zeros &= vm % 10U == 0U;
+			vr_trailing_zeros &= last_removed == 0U;
+			last_removed = vr % 10U;
+			vr /= 10U;
+			vp /= 10U;
+			vm /= 10U;
+			++removed;
+		}
+		if (vm_trailing_zeros) {
+			while (vm % 10U == 0U) {
+				vr_trailing_zeros &= last_removed == 0U;
+				last_removed = vr % 10U;
+				vr /= 10U;
+				vp /= 10U;
+				vm /= 10U;
+				++removed;
+			}
+		}
+		/* Round half to even if the exact value is ...50...0 */
+		if (vr_trailing_zeros && last_removed == 5U && vr % 2U == 0U)
+			last_removed = 4U;
+		output = vr + ((vr == vm && (!accept_bounds ||
+					     !vm_trailing_zeros)) ||
+			       last_removed >= 5U);
+	} else {
+		bool round_up = false;
+		if (vp / 100U > vm / 100U) {
+			round_up = vr % 100U >= 50U;
+			vr /= 100U;
+			vp /= 100U;
+			vm /= 100U;
+			removed += 2;
+		}
+		while (vp / 10U > vm / 10U) {
+			round_up = vr % 10U >= 5U;
+			vr /= 10U;
+			vp /= 10U;
+			vm /= 10U;
+			++removed;
+		}
+		output = vr + (vr == vm || round_up);
+	}
+
+	*exp10 = e10 + removed;
+	return output;
+}
+
+/**
+ * Find the shortest decimal number which rounds to a float.
+ *
+ * Same as cast_shortest_double(), but uses 32-bit arithmetic and upper
+ * halves of the same tables.
+ *
+ * @param mantissa   Stored mantissa bits.
+ * @param exponent   Stored exponent bits, the value must be finite and
+ *                   nonzero.
+ * @param exp10      Where to store the decimal exponent.
+ *
+ * @return Decimal digits.
+ */
+static uint32_t cast_shortest_float(uint32_t mantissa, uint32_t exponent,
+				    int32_t *exp10)
+{
+	int32_t e2;
+	uint32_t m2;
+	if (exponent == 0U) {
+		e2 = 1 - 127 - 23 - 2;
+		m2 = mantissa;
+	} else {
+		e2 = (int32_t)exponent - 127 - 23 - 2;
+		m2 = (UINT32_C(1) << 23) | mantissa;
+	}
+	bool accept_bounds = (m2 & 1U) == 0U;
+
+	uint32_t mv = 4U * m2;
+	uint32_t mp = 4U * m2 + 2U;
+	uint32_t mm_shift = mantissa != 0U || exponent <= 1U;
+	uint32_t mm = 4U * m2 - 1U - mm_shift;
+
+	uint32_t vr, vp, vm;
+	int32_t e10;
+	bool vm_trailing_zeros = false;
+	bool vr_trailing_zeros = false;
+	uint32_t last_removed = 0U;
+	if (e2 >= 0) {
+		uint32_t q = cast_log10_pow2(e2);
+		e10 = (int32_t)q;
+		int32_t k =
+		    CAST_POW5_INV_BITS - 64 + cast_pow5_bits((int32_t)q) - 1;
+		int32_t i = -e2 + (int32_t)q + k;
+		/* Upper halves are 2^k / 5^q rounded down, so add 1 back */
+		uint64_t mul = cast_pow5_inv_split[q][0] + 1U;
+		vr = cast_mul_shift_32(mv, mul, i);
+		vp = cast_mul_shift_32(mp, mul, i);
+		vm = cast_mul_shift_32(mm, mul, i);
+		if (q != 0U && (vp - 1U) / 10U <= vm / 10U) {
+			/* One removed digit is needed even if the loop
+			 * below won't remove any */
+			int32_t l = CAST_POW5_INV_BITS - 64 +
+				    cast_pow5_bits((int32_t)q - 1) - 1;
+			last_removed =
+			    cast_mul_shift_32(mv,
+					      cast_pow5_inv_split[q - 1U][0] +
+						  1U,
+					      -e2 + (int32_t)q - 1 + l) %
+			    10U;
+		}
+		if (q <= 9U) {
+			if (mv % 5U == 0U)
+				vr_trailing_zeros = cast_multiple_of_pow5(mv, q);
+			else if (accept_bounds)
+				vm_trailing_zeros = cast_multiple_of_pow5(mm, q);
+			else
+				vp -= cast_multiple_of_pow5(mp, q);
+		}
+	} else {
+		uint32_t q = cast_log10_pow5(-e2);
+		e10 = (int32_t)q + e2;
+		int32_t i = -e2 - (int32_t)q;
+		int32_t k = cast_pow5_bits(i) - (CAST_POW5_BITS - 64);
+		int32_t j = (int32_t)q - k;
+		uint64_t mul = cast_pow5_split[i][0];
+		vr = cast_mul_shift_32(mv, mul, j);
+		vp = cast_mul_shift_32(mp, mul, j);
+		vm = cast_mul_shift_32(mm, mul, j);
+		if (q != 0U && (vp - 1U) / 10U <= vm / 10U) {
+			j = (int32_t)q - 1 -
+			    (cast_pow5_bits(i + 1) - (CAST_POW5_BITS - 64));
+			last_removed =
+			    cast_mul_shift_32(mv, cast_pow5_split[i + 1][0], j) %
+			    10U;
+		}
+		if (q <= 1U) {
+			vr_trailing_zeros = true;
+			if (accept_bounds)
+				vm_trailing_zeros = mm_shift == 1U;
+			else
+				--vp;
+		} else if (q < 31U) {
+			vr_trailing_zeros = cast_multiple_of_pow2(mv, q - 1U);
+		}
+	}
+
+	int32_t removed = 0;
+	uint32_t output;
+	if (vm_trailing_zeros || vr_trailing_zeros) {
+		while (vp / 10U > vm / 10U) {
+			vm_trailing_zeros &= vm % 10U == 0U;
+			vr_trailing_zeros &= last_removed == 0U;
+			last_removed = vr % 10U;
+			vr /= 10U;
+			vp /= 10U;
+			vm /= 10U;
+			++removed;
+		}
+		if (vm_trailing_zeros) {
+			while (vm % 10U == 0U) {
+				vr_trailing_zeros &= last_removed == 0U;
+				last_removed = vr % 10U;
+				vr /= 10U;
+				vp /= 10U;
+				vm /= 10U;
+				++removed;
+			}
+		}
+		if (vr_trailing_zeros && last_removed == 5U && vr % 2U == 0U)
+			last_removed = 4U;
+		output = vr + ((vr == vm && (!accept_bounds ||
+					     !vm_trailing_zeros)) ||
+			       last_removed >= 5U);
+	} else {
+		while (vp / 10U > vm / 10U) {
+			last_removed = vr % 10U;
+			vr /= 10U;
+			vp /= 10U;
+			vm /= 10U;
+			++removed;
+		}
+		output = vr + (vr == vm || last_removed >= 5U);
+	}
+
+	*exp10 = e10 + removed;
+	return output;
+}
+
+/**
+ * Write decimal number `digits * 10^exp10` in fixed or scientific notation,
+ * whichever is used by Python for floats.
+ *
+ * @param buf        Where to write characters.
+ * @param cap        Size of buffer.
+ * @param negative   Whether to write minus sign.
+ * @param digits     Decimal digits.
+ * @param exp10      Decimal exponent.
+ *
+ * @return Number of characters or 0 if they don't fit the buffer, in which
+ *         case nothing is written.
+ */
+static size_t cast_fmt_shortest(char *buf, size_t cap, bool negative,
+				uint64_t digits, int32_t exp10)
+{
+	char tmp[CAST_FMT_FLOAT_SIZE];
+	char *out = buf != NULL && cap >= CAST_FMT_FLOAT_SIZE ? buf : tmp;
+	char *p = out;
+	if (negative)
+		*p++ = '-';
+
+	size_t count = cast_count_digits(digits);
+	/* Number of digits before decimal point */
+	int32_t point = (int32_t)count + exp10;
+	if (point > 16 || point < -3) {
+		/* d.ddde-x, first digit is moved before the point */
+		cast_fmt_digits(p + 1 + count, digits);
+		p[0] = p[1];
+		if (count > 1U) {
+			p[1] = '.';
+			p += count + 1U;
+		} else {
+			p += 1;
+		}
+		*p++ = 'e';
+		int32_t exp = point - 1;
+		if (exp < 0)
+			*p++ = '-';
+		uint32_t abs_exp = exp < 0 ? (uint32_t)-exp : (uint32_t)exp;
+		size_t exp_len = cast_count_digits(abs_exp);
+		cast_fmt_digits(p + exp_len, abs_exp);
+		p += exp_len;
+	} else if (point <= 0) {
+		/* 0.000ddd */
+		*p++ = '0';
+		*p++ = '.';
+		for (int32_t i = point; i < 0; ++i)
+			*p++ = '0';
+		cast_fmt_digits(p + count, digits);
+		p += count;
+	} else if ((size_t)point < count) {
+		/* ddd.ddd */
+		cast_fmt_digits(p + 1 + count, digits);
+		memmove(p, p + 1, (size_t)point);
+		p[point] = '.';
+		p += count + 1U;
+	} else {
+		/* ddd000 */
+		cast_fmt_digits(p + count, digits);
+		p += count;
+		for (int32_t i = (int32_t)count; i < point; ++i)
+			*p++ = '0';
+	}
+
+	size_t len = (size_t)(p - out);
+	if (out == tmp) {
+		if (buf == NULL || len > cap)
+			return 0U;
+		memcpy(buf, tmp, len);
+	}
+	return len;
+}
+
+/**
+ * Write name of special floating point value.
+ *
+ * @param buf    Where to write characters.
+ * @param cap    Size of buffer.
+ * @param name   Name of value.
+ *
+ * @return Number of characters or 0 if they don't fit the buffer.
+ */
+static size_t cast_fmt_special(char *buf, size_t cap, const char *name)
+{
+	size_t len = strlen(name);
+	if (buf == NULL || len > cap)
+		return 0U;
+	memcpy(buf, name, len);
+	return len;
+}
+
+size_t cast_fmt_double(char *buf, size_t cap, double value)
+{
+	uint64_t bits = 0U;
+	memcpy(&bits, &value, sizeof(bits));
+	bool negative = bits >> 63;
+	uint64_t mantissa = bits & ((UINT64_C(1) << 52) - 1U);
+	uint32_t exponent = (uint32_t)(bits >> 52) & 0x7FFU;
+
+	if (exponent == 0x7FFU) {
+		if (mantissa != 0U)
+			return cast_fmt_special(buf, cap, "nan");
+		return cast_fmt_special(buf, cap, negative ? "-inf" : "inf");
+	}
+	if (exponent == 0U && mantissa == 0U)
+		return cast_fmt_special(buf, cap, negative ? "-0" : "0");
+
+	/* Integers below 2^53 are printed as they are */
+	int32_t e2 = (int32_t)exponent - 1023 - 52;
+	uint64_t m2 = (UINT64_C(1) << 52) | mantissa;
+	if (e2 <= 0 && e2 >= -52 &&
+	    (m2 & ((UINT64_C(1) << -e2) - 1U)) == 0U)
+		return cast_fmt_shortest(buf, cap, negative, m2 >> -e2, 0);
+
+	int32_t exp10 = 0;
+	uint64_t digits = cast_shortest_double(mantissa, exponent, &exp10);
+	return cast_fmt_shortest(buf, cap, negative, digits, exp10);
+}
 
-/* List of all types supported by cast library */
-#define CAST_TYPES                                                             \
-	F(uint8_t, u8)                                                         \
-	F(uint16_t, u16)                                                       \
-	F(uint32_t, u32)                                                       \
-	F(uint64_t, u64)                                                       \
-	F(unsigned char, uchar)                                                \
-	F(unsigned, uint)                                                      \
-	F(unsigned short, ushort)                                              \
-	F(unsigned long, ulong)                                                \
-	F(unsigned long long, ullong)                                          \
-	F(size_t, size)                                                        \
-	F(uintptr_t, uptr)                                                     \
-	F(int8_t, i8)                                                          \
-	F(int16_t, i16)                                                        \
-	F(int32_t, i32)                                                        \
-	F(int64_t, i64)                                                        \
-	F(signed char, schar)                                                  \
-	F(int, int)                                                            \
-	F(short, short)                                                        \
-	F(long, long)                                                          \
-	F(long long, llong)                                                    \
-	F(ptrdiff_t, ptrdiff)                                                  \
-	F(float, float)                                                        \
-	F(double, double)                                                      \
-	F(bool, bool)                                                          \
-	/* END */
+size_t cast_fmt_float(char *buf, size_t cap, float value)
+{
+	uint32_t bits = 0U;
+	memcpy(&bits, &value, sizeof(bits));
+	bool negative = bits >> 31;
+	uint32_t mantissa = bits & ((UINT32_C(1) << 23) - 1U);
+	uint32_t exponent = (bits >> 23) & 0xFFU;
+
+	if (exponent == 0xFFU) {
+		if (mantissa != 0U)
+			return cast_fmt_special(buf, cap, "nan");
+		return cast_fmt_special(buf, cap, negative ? "-inf" : "inf");
+	}
+	if (exponent == 0U && mantissa == 0U)
+		return cast_fmt_special(buf, cap, negative ? "-0" : "0");
+
+	int32_t exp10 = 0;
+	uint32_t digits = cast_shortest_float(mantissa, exponent, &exp10);
+	return cast_fmt_shortest(buf, cap, negative, digits, exp10);
+}
+
+#if defined(CAST_WITH_SSE2)
+/**
+ * Find separators in 64 bytes of text.
+ *
+ * @param p       Text, 64 bytes are read.
+ * @param delim   Delimiter, newline is always a separator.
+ *
+ * @return Mask with bit set for each byte which is a separator.
+ */
+CAST_TARGET_SSE2 static inline uint64_t cast_sse2_separators(const char *p,
+							     char delim)
+{
+	const __m128i vdelim = _mm_set1_epi8(delim);
+	const __m128i newline = _mm_set1_epi8('\n');
+	uint64_t mask = 0U;
+
+	for (unsigned k = 0U; k < 4U; ++k) {
+		__m128i v = _mm_loadu_si128((const __m128i *)(p + 16U * k));
+		__m128i sep = _mm_or_si128(_mm_cmpeq_epi8(v, vdelim),
+					   _mm_cmpeq_epi8(v, newline));
+		mask |= (uint64_t)(unsigned)_mm_movemask_epi8(sep) << (16U * k);
+	}
+	return mask;
+}
+#endif
 
-static inline int try_bool_from_str(bool *val, const char *str)
+#if defined(CAST_WITH_AVX2)
+/**
+ * AVX2 version of cast_sse2_separators().
+ */
+CAST_TARGET_AVX2 static inline uint64_t cast_avx2_separators(const char *p,
+							     char delim)
 {
-	if (!val)
+	const __m256i vdelim = _mm256_set1_epi8(delim);
+	const __m256i newline = _mm256_set1_epi8('\n');
+	__m256i lo = _mm256_loadu_si256((const __m256i *)p);
+	__m256i hi = _mm256_loadu_si256((const __m256i *)(p + 32));
+	lo = _mm256_or_si256(_mm256_cmpeq_epi8(lo, vdelim),
+			     _mm256_cmpeq_epi8(lo, newline));
+	hi = _mm256_or_si256(_mm256_cmpeq_epi8(hi, vdelim),
+			     _mm256_cmpeq_epi8(hi, newline));
+	return (uint64_t)(uint32_t)_mm256_movemask_epi8(lo) |
+	       (uint64_t)(uint32_t)_mm256_movemask_epi8(hi) << 32;
+}
+
+/* Shuffles moving first n bytes to the end of 16 byte vector, zeroing the
+ * remaining ones */
+static const uint8_t cast_digit_shuffle[17][16] = {
+#define CAST_SHUFFLE_BYTE(n, j) (uint8_t)((j) >= 16 - (n) ? (j) - (16 - (n)) : 0x80)
+#define CAST_SHUFFLE(n)                                                        \
+	{CAST_SHUFFLE_BYTE(n, 0),  CAST_SHUFFLE_BYTE(n, 1),                    \
+	 CAST_SHUFFLE_BYTE(n, 2),  CAST_SHUFFLE_BYTE(n, 3),                    \
+	 CAST_SHUFFLE_BYTE(n, 4),  CAST_SHUFFLE_BYTE(n, 5),                    \
+	 CAST_SHUFFLE_BYTE(n, 6),  CAST_SHUFFLE_BYTE(n, 7),                    \
+	 CAST_SHUFFLE_BYTE(n, 8),  CAST_SHUFFLE_BYTE(n, 9),                    \
+	 CAST_SHUFFLE_BYTE(n, 10), CAST_SHUFFLE_BYTE(n, 11),                   \
+	 CAST_SHUFFLE_BYTE(n, 12), CAST_SHUFFLE_BYTE(n, 13),                   \
+	 CAST_SHUFFLE_BYTE(n, 14), CAST_SHUFFLE_BYTE(n, 15)}
+    CAST_SHUFFLE(0),  CAST_SHUFFLE(1),	CAST_SHUFFLE(2),  CAST_SHUFFLE(3),
+    CAST_SHUFFLE(4),  CAST_SHUFFLE(5),	CAST_SHUFFLE(6),  CAST_SHUFFLE(7),
+    CAST_SHUFFLE(8),  CAST_SHUFFLE(9),	CAST_SHUFFLE(10), CAST_SHUFFLE(11),
+    CAST_SHUFFLE(12), CAST_SHUFFLE(13), CAST_SHUFFLE(14), CAST_SHUFFLE(15),
+    CAST_SHUFFLE(16),
+#undef CAST_SHUFFLE
+#undef CAST_SHUFFLE_BYTE
+};
+
+/**
+ * Validate and convert up to 16 decimal digits at once.
+ *
+ * @param p       Digits, 16 bytes are read.
+ * @param n       Number of digits, from 1 to 16.
+ * @param val     Where to store the value.
+ *
+ * @return 0 on success, -1 if any of n bytes is not a digit.
+ */
+CAST_TARGET_AVX2 static inline int cast_avx2_parse_digits(const char *p,
+							  size_t n,
+							  uint64_t *val)
+{
+	__m128i digits = _mm_sub_epi8(_mm_loadu_si128((const __m128i *)p),
+				      _mm_set1_epi8('0'));
+	__m128i valid = _mm_cmpeq_epi8(
+	    _mm_min_epu8(digits, _mm_set1_epi8(9)), digits);
+	unsigned expected = (1U << n) - 1U;
+	if (((unsigned)_mm_movemask_epi8(valid) & expected) != expected)
 		return -1;
 
-	long long tmp = 0;
-	int err = try_llong_from_str(&tmp, str);
-	if (err)
+	/* Right align digits, so that leading zeros don't change value */
+	digits = _mm_shuffle_epi8(
+	    digits, _mm_loadu_si128((const __m128i *)cast_digit_shuffle[n]));
+	/* Combine pairs, quads and octets of digits */
+	__m128i pairs = _mm_maddubs_epi16(
+	    digits, _mm_setr_epi8(10, 1, 10, 1, 10, 1, 10, 1, 10, 1, 10, 1, 10,
+				  1, 10, 1));
+	__m128i quads = _mm_madd_epi16(
+	    pairs, _mm_setr_epi16(100, 1, 100, 1, 100, 1, 100, 1));
+	quads = _mm_packus_epi32(quads, quads);
+	__m128i octets = _mm_madd_epi16(
+	    quads, _mm_setr_epi16(10000, 1, 10000, 1, 10000, 1, 10000, 1));
+	*val = (uint64_t)(uint32_t)_mm_cvtsi128_si32(octets) * 100000000U +
+	       (uint32_t)_mm_extract_epi32(octets, 1);
+	return 0;
+}
+#endif
+
+/**
+ * Find separators in up to 64 bytes of text.
+ *
+ * @param isa     Instruction set level to use.
+ * @param p       Text.
+ * @param n       Number of bytes, SIMD is used only for 64 bytes.
+ * @param delim   Delimiter, newline is always a separator.
+ *
+ * @return Mask with bit set for each byte which is a separator.
+ */
+static inline uint64_t cast_column_separators(enum cast_isa isa,
+					      const char *p, size_t n,
+					      char delim)
+{
+#if defined(CAST_WITH_AVX2)
+	if (isa >= CAST_ISA_AVX2 && n == 64U)
+		return cast_avx2_separators(p, delim);
+#endif
+#if defined(CAST_WITH_SSE2)
+	if (isa >= CAST_ISA_SSE2 && n == 64U)
+		return cast_sse2_separators(p, delim);
+#endif
+	(void)isa;
+	uint64_t mask = 0U;
+	for (size_t i = 0U; i < n; ++i)
+		mask |= (uint64_t)(p[i] == delim || p[i] == '\n') << i;
+	return mask;
+}
+
+/**
+ * Parse token of a text column and store it in `out[index]`.
+ *
+ * @param isa     Instruction set level to use.
+ * @param p       Token.
+ * @param n       Length of the token.
+ * @param avail   Number of bytes which can be read starting at `p`.
+ * @param out     Array of values.
+ * @param index   Index of the value.
+ * @param size    Size of value.
+ * @param kind    Kind of value.
+ *
+ * @return 0 on success, -1 if the token is not a valid value.
+ */
+static inline int cast_column_token(enum cast_isa isa, const char *p, size_t n,
+				    size_t avail, void *out, size_t index,
+				    size_t size, enum cast_column_kind kind)
+{
+	unsigned char *dst = (unsigned char *)out + index * size;
+
+	/* Accept CRLF line endings */
+	if (n > 0U && p[n - 1U] == '\r')
+		--n;
+
+	if (kind == CAST_COLUMN_FLOAT) {
+		if (size == sizeof(float)) {
+			float val = 0.0f;
+			if (cast_parse_float(&val, p, n))
+				return -1;
+			memcpy(dst, &val, sizeof(val));
+			return 0;
+		}
+		double val = 0.0;
+		if (cast_parse_double(&val, p, n))
+			return -1;
+		memcpy(dst, &val, sizeof(val));
+		return 0;
+	}
+
+	bool negative = false;
+	if (n > 0U && (*p == '+' || (*p == '-' && kind == CAST_COLUMN_SIGNED))) {
+		negative = *p == '-';
+		++p;
+		--n;
+		--avail;
+	}
+
+	uint64_t val = 0U;
+#if defined(CAST_WITH_AVX2)
+	if (isa >= CAST_ISA_AVX2 && n > 0U && n <= 16U && avail >= 16U) {
+		if (cast_avx2_parse_digits(p, n, &val))
+			return -1;
+	} else
+#endif
+	    if (cast_parse_decimal(&val, p, n))
 		return -1;
+	(void)isa;
+	(void)avail;
 
-	*val = tmp != 0U;
+	/* Range of the type */
+	uint64_t max = size == 8U ? UINT64_MAX : (UINT64_C(1) << (8U * size)) - 1U;
+	if (kind == CAST_COLUMN_SIGNED)
+		max >>= 1;
+	if (val > max + (negative ? 1U : 0U))
+		return -1;
+	if (negative)
+		val = 0U - val;
+
+	switch (size) {
+	case 1U: {
+		uint8_t v = (uint8_t)val;
+		memcpy(dst, &v, sizeof(v));
+		break;
+	}
+	case 2U: {
+		uint16_t v = (uint16_t)val;
+		memcpy(dst, &v, sizeof(v));
+		break;
+	}
+	case 4U: {
+		uint32_t v = (uint32_t)val;
+		memcpy(dst, &v, sizeof(v));
+		break;
+	}
+	default:
+		memcpy(dst, &val, sizeof(val));
+		break;
+	}
+	return 0;
+}
+
+/**
+ * Parse column of delimited numbers using SIMD instructions of the given
+ * level. See cast_parse_column() for description of parameters.
+ */
+static inline int cast_column_parse(enum cast_isa isa, const char *buf,
+				    size_t len, char delim, void *out,
+				    size_t size, enum cast_column_kind kind,
+				    size_t cap, size_t *count,
+				    size_t *err_offset)
+{
+	size_t n = 0U;
+	size_t start = 0U;
+	size_t end = 0U;
+
+	for (size_t block = 0U; block < len; block += 64U) {
+		size_t block_len = len - block < 64U ? len - block : 64U;
+		uint64_t mask =
+		    cast_column_separators(isa, buf + block, block_len, delim);
+		while (mask) {
+			end = block + (size_t)cast_ctz_64(mask);
+			mask &= mask - 1U;
+			if (n == cap ||
+			    cast_column_token(isa, buf + start, end - start,
+					      len - start, out, n, size, kind))
+				goto fail;
+			++n;
+			start = end + 1U;
+		}
+	}
+
+	/* Last token doesn't need to be followed by a separator */
+	if (start < len) {
+		end = len;
+		if (n == cap || cast_column_token(isa, buf + start, end - start,
+						  len - start, out, n, size,
+						  kind))
+			goto fail;
+		++n;
+	}
+
+	if (count)
+		*count = n;
 	return 0;
+
+fail:
+	if (count)
+		*count = n;
+	if (err_offset)
+		*err_offset = start;
+	return -1;
+}
+
+static const char *const cast_isa_names[] = {
+    [CAST_ISA_SCALAR] = "scalar",
+    [CAST_ISA_SSE2] = "sse2",
+    [CAST_ISA_AVX2] = "avx2",
+    [CAST_ISA_AVX512] = "avx512",
+};
+
+const char *cast_isa_name(enum cast_isa isa)
+{
+	if ((size_t)isa >= sizeof(cast_isa_names) / sizeof(cast_isa_names[0]))
+		return "unknown";
+	return cast_isa_names[isa];
+}
+
+#if defined(CAST_DISPATCH)
+#include <stdatomic.h>
+#include <string.h>
+
+/**
+ * Define array conversion kernels specialized for one instruction set level.
+ *
+ * Element sizes are passed as constants, so that the compiler can specialize
+ * generic kernels for each of them.
+ *
+ * @param level     Suffix of defined functions.
+ * @param target    Target attribute of defined functions.
+ * @param isa       Instruction set level.
+ */
+#define CAST_DEFINE_KERNELS(level, target, isa)                                \
+	target static size_t cast_kernel_narrow_##level(                       \
+	    void *dst, size_t dst_size, const void *src, size_t src_size,      \
+	    size_t n, uint64_t lo, uint64_t hi)                                \
+	{                                                                      \
+		CAST_KERNEL_NARROW(isa, 1U, 1U)                                \
+		CAST_KERNEL_NARROW(isa, 1U, 2U)                                \
+		CAST_KERNEL_NARROW(isa, 1U, 4U)                                \
+		CAST_KERNEL_NARROW(isa, 2U, 2U)                                \
+		CAST_KERNEL_NARROW(isa, 2U, 4U)                                \
+		CAST_KERNEL_NARROW(isa, 4U, 4U)                                \
+		CAST_KERNEL_NARROW(isa, 4U, 8U)                                \
+		CAST_KERNEL_NARROW(isa, 8U, 8U)                                \
+		return 0U;                                                     \
+	}                                                                      \
+	target static size_t cast_kernel_from_float_##level(                   \
+	    void *dst, size_t dst_size, const float *src, size_t n, float lo,  \
+	    float hi)                                                          \
+	{                                                                      \
+		CAST_KERNEL_FROM_F(isa, float, 1U)                             \
+		CAST_KERNEL_FROM_F(isa, float, 2U)                             \
+		CAST_KERNEL_FROM_F(isa, float, 4U)                             \
+		CAST_KERNEL_FROM_F(isa, float, 8U)                             \
+		return 0U;                                                     \
+	}                                                                      \
+	target static size_t cast_kernel_from_double_##level(                  \
+	    void *dst, size_t dst_size, const double *src, size_t n,           \
+	    double lo, double hi)                                              \
+	{                                                                      \
+		CAST_KERNEL_FROM_F(isa, double, 1U)                            \
+		CAST_KERNEL_FROM_F(isa, double, 2U)                            \
+		CAST_KERNEL_FROM_F(isa, double, 4U)                            \
+		CAST_KERNEL_FROM_F(isa, double, 8U)                            \
+		return 0U;                                                     \
+	}                                                                      \
+	target static size_t cast_kernel_to_f_##level(                         \
+	    void *dst, bool to_float, const void *src, size_t src_size,        \
+	    bool src_signed, size_t n)                                         \
+	{                                                                      \
+		CAST_KERNEL_TO_F(isa, true, 4U, true)                          \
+		CAST_KERNEL_TO_F(isa, true, 4U, false)                         \
+		CAST_KERNEL_TO_F(isa, true, 8U, true)                          \
+		CAST_KERNEL_TO_F(isa, true, 8U, false)                         \
+		CAST_KERNEL_TO_F(isa, false, 8U, true)                         \
+		CAST_KERNEL_TO_F(isa, false, 8U, false)                        \
+		return 0U;                                                     \
+	}                                                                      \
+	target static size_t cast_kernel_fits_##level(                         \
+	    const void *src, size_t src_size, size_t n, uint64_t lo,           \
+	    uint64_t hi, bool full)                                            \
+	{                                                                      \
+		CAST_KERNEL_FITS(isa, 1U)                                      \
+		CAST_KERNEL_FITS(isa, 2U)                                      \
+		CAST_KERNEL_FITS(isa, 4U)                                      \
+		CAST_KERNEL_FITS(isa, 8U)                                      \
+		return 0U;                                                     \
+	}                                                                      \
+	target static int cast_kernel_parse_column_##level(                    \
+	    const char *buf, size_t len, char delim, void *out, size_t size,   \
+	    enum cast_column_kind kind, size_t cap, size_t *count,             \
+	    size_t *err_offset)                                                \
+	{                                                                      \
+		return cast_column_parse(isa, buf, len, delim, out, size,      \
+					 kind, cap, count, err_offset);        \
+	}                                                                      \
+	target static void cast_kernel_minmax_##level(                         \
+	    const void *src, size_t size, bool is_signed, size_t n, void *min, \
+	    void *max)                                                         \
+	{                                                                      \
+		CAST_KERNEL_MINMAX(1U, true, cast_i8_alias)                    \
+		CAST_KERNEL_MINMAX(2U, true, cast_i16_alias)                   \
+		CAST_KERNEL_MINMAX(4U, true, cast_i32_alias)                   \
+		CAST_KERNEL_MINMAX(8U, true, cast_i64_alias)                   \
+		CAST_KERNEL_MINMAX(1U, false, cast_u8_alias)                   \
+		CAST_KERNEL_MINMAX(2U, false, cast_u16_alias)                  \
+		CAST_KERNEL_MINMAX(4U, false, cast_u32_alias)                  \
+		CAST_KERNEL_MINMAX(8U, false, cast_u64_alias)                  \
+	}
+
+#define CAST_KERNEL_NARROW(isa, d, s)                                          \
+	if (dst_size == (d) && src_size == (s))                                \
+		return cast_array_simd_narrow(isa, dst, d, src, s, n, lo, hi);
+#define CAST_KERNEL_FROM_F(isa, type, d)                                       \
+	if (dst_size == (d))                                                   \
+		return cast_array_simd_from_##type(isa, dst, d, src, n, lo, hi);
+#define CAST_KERNEL_TO_F(isa, f, s, sign)                                      \
+	if (to_float == (f) && src_size == (s) && src_signed == (sign))        \
+		return cast_array_simd_to_f(isa, dst, f, src, s, sign, n);
+#define CAST_KERNEL_FITS(isa, s)                                               \
+	if (src_size == (s))                                                   \
+		return cast_array_simd_fits(isa, src, s, n, lo, hi, full);
+#define CAST_KERNEL_MINMAX(s, sign, type)                                      \
+	if (size == (s) && is_signed == (sign)) {                              \
+		type lo = *(type *)min;                                        \
+		type hi = *(type *)max;                                        \
+		CAST_MINMAX_LOOP(type, (const type *)src, n, lo, hi);          \
+		*(type *)min = lo;                                             \
+		*(type *)max = hi;                                             \
+		return;                                                        \
+	}
+
+/* Integer types which can be used to access integers of any type */
+typedef int8_t cast_i8_alias __attribute__((may_alias));
+typedef int16_t cast_i16_alias __attribute__((may_alias));
+typedef int32_t cast_i32_alias __attribute__((may_alias));
+typedef int64_t cast_i64_alias __attribute__((may_alias));
+typedef uint8_t cast_u8_alias __attribute__((may_alias));
+typedef uint16_t cast_u16_alias __attribute__((may_alias));
+typedef uint32_t cast_u32_alias __attribute__((may_alias));
+typedef uint64_t cast_u64_alias __attribute__((may_alias));
+
+CAST_DEFINE_KERNELS(scalar, , CAST_ISA_SCALAR)
+CAST_DEFINE_KERNELS(sse2, CAST_TARGET_SSE2, CAST_ISA_SSE2)
+CAST_DEFINE_KERNELS(avx2, CAST_TARGET_AVX2, CAST_ISA_AVX2)
+CAST_DEFINE_KERNELS(avx512, CAST_TARGET_AVX512, CAST_ISA_AVX512)
+
+#undef CAST_KERNEL_NARROW
+#undef CAST_KERNEL_FROM_F
+#undef CAST_KERNEL_TO_F
+#undef CAST_KERNEL_FITS
+#undef CAST_KERNEL_MINMAX
+
+#define CAST_KERNELS(level)                                                    \
+	{                                                                      \
+		cast_kernel_narrow_##level, cast_kernel_from_float_##level,    \
+		    cast_kernel_from_double_##level, cast_kernel_to_f_##level, \
+		    cast_kernel_fits_##level, cast_kernel_minmax_##level,      \
+		    cast_kernel_parse_column_##level                           \
+	}
+
+static const struct {
+	size_t (*narrow)(void *, size_t, const void *, size_t, size_t,
+			 uint64_t, uint64_t);
+	size_t (*from_float)(void *, size_t, const float *, size_t, float,
+			     float);
+	size_t (*from_double)(void *, size_t, const double *, size_t, double,
+			      double);
+	size_t (*to_f)(void *, bool, const void *, size_t, bool, size_t);
+	size_t (*fits)(const void *, size_t, size_t, uint64_t, uint64_t, bool);
+	void (*minmax)(const void *, size_t, bool, size_t, void *, void *);
+	int (*parse_column)(const char *, size_t, char, void *, size_t,
+			    enum cast_column_kind, size_t, size_t *, size_t *);
+} cast_kernels[] = {
+    [CAST_ISA_SCALAR] = CAST_KERNELS(scalar),
+    [CAST_ISA_SSE2] = CAST_KERNELS(sse2),
+    [CAST_ISA_AVX2] = CAST_KERNELS(avx2),
+    [CAST_ISA_AVX512] = CAST_KERNELS(avx512),
+};
+
+#undef CAST_KERNELS
+
+/* Selected instruction set level, negative until first use */
+static atomic_int cast_isa_selected = -1;
+
+static enum cast_isa cast_isa_supported(void)
+{
+	__builtin_cpu_init();
+	if (__builtin_cpu_supports("avx512f") &&
+	    __builtin_cpu_supports("avx512dq"))
+		return CAST_ISA_AVX512;
+	if (__builtin_cpu_supports("avx2"))
+		return CAST_ISA_AVX2;
+	if (__builtin_cpu_supports("sse2"))
+		return CAST_ISA_SSE2;
+	return CAST_ISA_SCALAR;
+}
+
+enum cast_isa cast_set_isa(enum cast_isa isa)
+{
+	const enum cast_isa supported = cast_isa_supported();
+
+	if (isa > supported)
+		isa = supported;
+	atomic_store_explicit(&cast_isa_selected, (int)isa,
+			      memory_order_relaxed);
+	return isa;
+}
+
+enum cast_isa cast_isa(void)
+{
+	int isa = atomic_load_explicit(&cast_isa_selected,
+				       memory_order_relaxed);
+	if (isa >= 0)
+		return (enum cast_isa)isa;
+
+	enum cast_isa requested = CAST_ISA_AVX512;
+	const char *force = getenv("CAST_FORCE_ISA");
+	for (size_t i = 0U; force && i < sizeof(cast_isa_names) /
+						sizeof(cast_isa_names[0]);
+	     ++i) {
+		if (strcmp(force, cast_isa_names[i]) == 0)
+			requested = (enum cast_isa)i;
+	}
+	return cast_set_isa(requested);
+}
+
+size_t cast_kernel_narrow(void *dst, size_t dst_size, const void *src,
+			  size_t src_size, size_t n, uint64_t lo, uint64_t hi)
+{
+	return cast_kernels[cast_isa()].narrow(dst, dst_size, src, src_size, n,
+					       lo, hi);
+}
+
+size_t cast_kernel_from_float(void *dst, size_t dst_size, const float *src,
+			      size_t n, float lo, float hi)
+{
+	return cast_kernels[cast_isa()].from_float(dst, dst_size, src, n, lo,
+						   hi);
+}
+
+size_t cast_kernel_from_double(void *dst, size_t dst_size, const double *src,
+			       size_t n, double lo, double hi)
+{
+	return cast_kernels[cast_isa()].from_double(dst, dst_size, src, n, lo,
+						    hi);
+}
+
+size_t cast_kernel_to_f(void *dst, bool to_float, const void *src,
+			size_t src_size, bool src_signed, size_t n)
+{
+	return cast_kernels[cast_isa()].to_f(dst, to_float, src, src_size,
+					     src_signed, n);
+}
+
+size_t cast_kernel_fits(const void *src, size_t src_size, size_t n,
+			uint64_t lo, uint64_t hi, bool full)
+{
+	return cast_kernels[cast_isa()].fits(src, src_size, n, lo, hi, full);
+}
+
+void cast_kernel_minmax(const void *src, size_t size, bool is_signed, size_t n,
+			void *min, void *max)
+{
+	cast_kernels[cast_isa()].minmax(src, size, is_signed, n, min, max);
+}
+
+int cast_parse_column(const char *buf, size_t len, char delim, void *out,
+		      size_t size, enum cast_column_kind kind, size_t cap,
+		      size_t *count, size_t *err_offset)
+{
+	return cast_kernels[cast_isa()].parse_column(
+	    buf, len, delim, out, size, kind, cap, count, err_offset);
+}
+#else
+enum cast_isa cast_isa(void)
+{
+	return CAST_ISA_BUILTIN;
+}
+
+enum cast_isa cast_set_isa(enum cast_isa isa)
+{
+	(void)isa;
+	return CAST_ISA_BUILTIN;
+}
+
+int cast_parse_column(const char *buf, size_t len, char delim, void *out,
+		      size_t size, enum cast_column_kind kind, size_t cap,
+		      size_t *count, size_t *err_offset)
+{
+	return cast_column_parse(CAST_ISA_BUILTIN, buf, len, delim, out, size,
+				 kind, cap, count, err_offset);
+}
+#endif
+
+#if defined(CAST_PARALLEL)
+#include <pthread.h>
+#include <stdatomic.h>
+#include <unistd.h>
+
+/* Largest number of threads used by parallel array conversions */
+#define CAST_MAX_THREADS 256U
+
+/* Conversion shared by threads of the pool */
+struct cast_parallel_job {
+	cast_array_fn fn;
+	unsigned char *dst;
+	const unsigned char *src;
+	size_t dst_size;
+	size_t src_size;
+	size_t n;
+	/* Elements in front of the first cache aligned chunk */
+	size_t head;
+	/* Elements in a single chunk */
+	size_t chunk;
+	size_t chunks;
+	/* Next chunk to claim */
+	atomic_size_t next;
+	/* Smallest index of element which does not fit */
+	atomic_size_t bad;
+};
+
+static struct {
+	/* Held by the thread which is using the pool */
+	pthread_mutex_t run;
+	/* Protects the fields below */
+	pthread_mutex_t lock;
+	pthread_cond_t start;
+	pthread_cond_t done;
+	pthread_t workers[CAST_MAX_THREADS];
+	unsigned spawned;
+	unsigned threads;
+	unsigned long generation;
+	unsigned pending;
+	bool stop;
+	struct cast_parallel_job *job;
+} cast_pool = {
+	.run = PTHREAD_MUTEX_INITIALIZER,
+	.lock = PTHREAD_MUTEX_INITIALIZER,
+	.start = PTHREAD_COND_INITIALIZER,
+	.done = PTHREAD_COND_INITIALIZER,
+};
+
+static void cast_parallel_work(struct cast_parallel_job *job)
+{
+	for (;;) {
+		size_t c = atomic_fetch_add(&job->next, 1U);
+		if (c >= job->chunks)
+			return;
+
+		size_t begin = c == 0U ? 0U : job->head + c * job->chunk;
+		size_t end = job->head + (c + 1U) * job->chunk;
+		if (end > job->n)
+			end = job->n;
+
+		/* Chunks are claimed in order, so the remaining ones start
+		 * after the failed element too */
+		if (begin >= atomic_load(&job->bad))
+			return;
+
+		size_t bad = 0U;
+		if (job->fn(job->dst + begin * job->dst_size,
+			    job->src + begin * job->src_size, end - begin,
+			    &bad) == 0)
+			continue;
+
+		bad += begin;
+		size_t prev = atomic_load(&job->bad);
+		while (bad < prev &&
+		       !atomic_compare_exchange_weak(&job->bad, &prev, bad))
+			;
+	}
+}
+
+static void *cast_parallel_worker(void *arg)
+{
+	unsigned long seen = (unsigned long)(uintptr_t)arg;
+
+	pthread_mutex_lock(&cast_pool.lock);
+	for (;;) {
+		while (!cast_pool.stop && cast_pool.generation == seen)
+			pthread_cond_wait(&cast_pool.start, &cast_pool.lock);
+		if (cast_pool.stop)
+			break;
+
+		seen = cast_pool.generation;
+		struct cast_parallel_job *job = cast_pool.job;
+		pthread_mutex_unlock(&cast_pool.lock);
+
+		cast_parallel_work(job);
+
+		pthread_mutex_lock(&cast_pool.lock);
+		if (--cast_pool.pending == 0U)
+			pthread_cond_signal(&cast_pool.done);
+	}
+	pthread_mutex_unlock(&cast_pool.lock);
+	return NULL;
+}
+
+/* Must be called with cast_pool.run held */
+static unsigned cast_pool_threads(void)
+{
+	if (cast_pool.threads != 0U)
+		return cast_pool.threads;
+
+	long threads = 0L;
+	const char *env = getenv("CAST_THREADS");
+	if (env)
+		threads = strtol(env, NULL, 10);
+	if (threads <= 0L)
+		threads = sysconf(_SC_NPROCESSORS_ONLN);
+	if (threads <= 0L)
+		threads = 1L;
+	if (threads > (long)CAST_MAX_THREADS)
+		threads = (long)CAST_MAX_THREADS;
+	cast_pool.threads = (unsigned)threads;
+	return cast_pool.threads;
+}
+
+unsigned cast_set_threads(unsigned threads)
+{
+	pthread_mutex_lock(&cast_pool.run);
+
+	pthread_mutex_lock(&cast_pool.lock);
+	cast_pool.stop = true;
+	pthread_cond_broadcast(&cast_pool.start);
+	pthread_mutex_unlock(&cast_pool.lock);
+
+	for (unsigned i = 0U; i < cast_pool.spawned; ++i)
+		pthread_join(cast_pool.workers[i], NULL);
+	cast_pool.spawned = 0U;
+	cast_pool.stop = false;
+
+	cast_pool.threads =
+	    threads > CAST_MAX_THREADS ? CAST_MAX_THREADS : threads;
+	threads = cast_pool_threads();
+
+	pthread_mutex_unlock(&cast_pool.run);
+	return threads;
+}
+
+unsigned cast_threads(void)
+{
+	pthread_mutex_lock(&cast_pool.run);
+	unsigned threads = cast_pool_threads();
+	pthread_mutex_unlock(&cast_pool.run);
+	return threads;
+}
+
+int cast_parallel_array(cast_array_fn fn, void *dst, size_t dst_size,
+			const void *src, size_t src_size, size_t n,
+			size_t *first_bad)
+{
+	if (dst == NULL || src == NULL ||
+	    n < CAST_PARALLEL_MIN_BYTES / src_size ||
+	    pthread_mutex_trylock(&cast_pool.run) != 0)
+		return fn(dst, src, n, first_bad);
+
+	unsigned threads = cast_pool_threads();
+	if (threads <= 1U) {
+		pthread_mutex_unlock(&cast_pool.run);
+		return fn(dst, src, n, first_bad);
+	}
+	while (cast_pool.spawned + 1U < threads &&
+	       pthread_create(&cast_pool.workers[cast_pool.spawned], NULL,
+			      cast_parallel_worker,
+			      (void *)(uintptr_t)cast_pool.generation) == 0)
+		++cast_pool.spawned;
+
+	/* Align chunks of source to cache lines */
+	size_t misaligned = (uintptr_t)src % 64U;
+	size_t head = 0U;
+	if (misaligned % src_size == 0U)
+		head = (64U - misaligned) % 64U / src_size;
+
+	struct cast_parallel_job job = {
+		.fn = fn,
+		.dst = (unsigned char *)dst,
+		.src = (const unsigned char *)src,
+		.dst_size = dst_size,
+		.src_size = src_size,
+		.n = n,
+		.head = head,
+		.chunk = CAST_PARALLEL_CHUNK / src_size,
+	};
+	job.chunks = (n - head + job.chunk - 1U) / job.chunk;
+	atomic_init(&job.next, 0U);
+	atomic_init(&job.bad, SIZE_MAX);
+
+	pthread_mutex_lock(&cast_pool.lock);
+	cast_pool.job = &job;
+	cast_pool.pending = cast_pool.spawned;
+	++cast_pool.generation;
+	pthread_cond_broadcast(&cast_pool.start);
+	pthread_mutex_unlock(&cast_pool.lock);
+
+	cast_parallel_work(&job);
+
+	pthread_mutex_lock(&cast_pool.lock);
+	while (cast_pool.pending != 0U)
+		pthread_cond_wait(&cast_pool.done, &cast_pool.lock);
+	pthread_mutex_unlock(&cast_pool.lock);
+
+	pthread_mutex_unlock(&cast_pool.run);
+
+	size_t bad = atomic_load(&job.bad);
+	if (bad == SIZE_MAX)
+		return 0;
+	if (first_bad)
+		*first_bad = bad;
+	return -1;
+}
+#else
+unsigned cast_set_threads(unsigned threads)
+{
+	(void)threads;
+	return 1U;
+}
+
+unsigned cast_threads(void)
+{
+	return 1U;
 }
-CAST_DEFINE_FROM(bool, bool, const char *, str)
+#endif
 
-#define CAST_ACCEPTABLE(x)                                                     \
-	_Generic((x),                                                          \
-	    char: (x),                                                         \
-	    signed char: (x),                                                  \
-	    signed short: (x),                                                 \
-	    signed int: (x),                                                   \
-	    signed long: (x),                                                  \
-	    signed long long: (x),                                             \
-	    unsigned char: (x),                                                \
-	    unsigned short: (x),                                               \
-	    unsigned int: (x),                                                 \
-	    unsigned long: (x),                                                \
-	    unsigned long long: (x))
+/* Alignment of blocks of threads, so they do not share cache lines */
+#define CAST_STATS_ALIGN 64U
 
-#define CAST_BIT_CAST(To, From, x)                                             \
-	(((union {                                                             \
-		 To to;                                                        \
-		 From from;                                                    \
-	 }){.from = (x)})                                                      \
-	     .to)
+_Static_assert((CAST_TRACE_SIZE & (CAST_TRACE_SIZE - 1U)) == 0U,
+	       "CAST_TRACE_SIZE has to be a power of two");
 
-/**
- * Cast integer value to integer type T
- *
- * @param x    value to cast
- *
- * @return Value converted to a different integer type
- */
-#define integer_cast(T, x)                                                     \
-	_Generic((T)(0),                                                       \
-	    char: CAST_BIT_CAST(T, unsigned char,                              \
-				(unsigned char)CAST_ACCEPTABLE(x)),            \
-	    signed char: CAST_BIT_CAST(T, unsigned char,                       \
-				       (unsigned char)CAST_ACCEPTABLE(x)),     \
-	    signed short: CAST_BIT_CAST(T, unsigned short,                     \
-					(unsigned short)CAST_ACCEPTABLE(x)),   \
-	    signed int: CAST_BIT_CAST(T, unsigned int,                         \
-				      (unsigned int)CAST_ACCEPTABLE(x)),       \
-	    signed long: CAST_BIT_CAST(T, unsigned long,                       \
-				       (unsigned long)CAST_ACCEPTABLE(x)),     \
-	    signed long long: CAST_BIT_CAST(                                   \
-		     T, unsigned long long,                                    \
-		     (unsigned long long)CAST_ACCEPTABLE(x)),                  \
-	    unsigned char: (unsigned char)CAST_ACCEPTABLE(x),                  \
-	    unsigned short: (unsigned short)CAST_ACCEPTABLE(x),                \
-	    unsigned int: (unsigned int)CAST_ACCEPTABLE(x),                    \
-	    unsigned long: (unsigned long)CAST_ACCEPTABLE(x),                  \
-	    unsigned long long: (unsigned long long)CAST_ACCEPTABLE(x))
+/* Failure remembered by flight recorder */
+struct cast_trace_entry {
+	/* Index of failure in the block plus one, 0 while it is written */
+	_Atomic uint64_t seq;
+	/* Source and destination types packed by CAST_TYPE_PAIR() */
+	_Atomic uint64_t pair;
+	/* Bits of source value */
+	_Atomic uint64_t value;
+	/* Address of code, which called the conversion */
+	_Atomic uint64_t address;
+};
 
-#ifdef CAST_IMPLEMENTATION
-#include <stdio.h>
-#include <inttypes.h>
-#include <errno.h>
-#include <stdlib.h>
-#include <stdarg.h>
+/* Counters and flight recorder of one thread */
+struct cast_stats_block {
+	/* First, so cast_stats_thread also points to the block */
+	struct cast_stats_counter counters[CAST_TYPE_COUNT * CAST_TYPE_COUNT];
+	struct cast_trace_entry trace[CAST_TRACE_SIZE];
+	/* Number of failures written to trace */
+	_Atomic uint64_t trace_count;
+	/* Next block of all allocated blocks */
+	struct cast_stats_block *next;
+	/* Next block released by an exited thread */
+	struct cast_stats_block *next_free;
+};
 
-#ifndef CAST_CUSTOM_PANIC
-void cast_panic_impl(const char *format, ...)
+/* Size of allocated block, aligned_alloc() needs a multiple of alignment */
+#define CAST_STATS_BLOCK_SIZE                                                  \
+	((sizeof(struct cast_stats_block) + CAST_STATS_ALIGN - 1U) /           \
+	 CAST_STATS_ALIGN * CAST_STATS_ALIGN)
+
+_Thread_local struct cast_stats_counter *cast_stats_thread;
+/* All allocated blocks, they are never freed, so readers need no lock */
+static _Atomic(struct cast_stats_block *) cast_stats_blocks;
+/* Counters shared by threads, which could not allocate their own */
+static _Alignas(CAST_STATS_ALIGN) struct cast_stats_block cast_stats_fallback;
+
+#if defined(CAST_PARALLEL)
+static pthread_once_t cast_stats_once = PTHREAD_ONCE_INIT;
+static pthread_key_t cast_stats_key;
+static bool cast_stats_key_ok;
+static pthread_mutex_t cast_stats_lock = PTHREAD_MUTEX_INITIALIZER;
+/* Blocks of exited threads, which are reused by new threads */
+static struct cast_stats_block *cast_stats_free;
+
+/* Release block of an exiting thread, its counts are kept */
+static void cast_stats_release(void *ptr)
 {
-	va_list args;
+	struct cast_stats_block *block = ptr;
 
-	va_start(args, format);
-	vfprintf(stderr, format, args);
-	va_end(args);
-	exit(1);
+	cast_stats_thread = NULL;
+	pthread_mutex_lock(&cast_stats_lock);
+	block->next_free = cast_stats_free;
+	cast_stats_free = block;
+	pthread_mutex_unlock(&cast_stats_lock);
+}
+
+static void cast_stats_init(void)
+{
+	cast_stats_key_ok =
+	    pthread_key_create(&cast_stats_key, cast_stats_release) == 0;
 }
 #endif
 
-int cast_try_ullong_from_str(unsigned long long *dst, const char *str)
+struct cast_stats_counter *cast_stats_attach(void)
 {
-	if (!dst)
-		return -1;
-	if (!str)
-		return -1;
+	struct cast_stats_block *block = NULL;
 
-	errno = 0;
+#if defined(CAST_PARALLEL)
+	pthread_once(&cast_stats_once, cast_stats_init);
+	pthread_mutex_lock(&cast_stats_lock);
+	block = cast_stats_free;
+	if (block)
+		cast_stats_free = block->next_free;
+	pthread_mutex_unlock(&cast_stats_lock);
+#endif
+	if (!block) {
+		block = aligned_alloc(CAST_STATS_ALIGN, CAST_STATS_BLOCK_SIZE);
+		if (!block) {
+			cast_stats_thread = cast_stats_fallback.counters;
+			return cast_stats_thread;
+		}
+		memset(block, 0, sizeof(*block));
+		block->next = atomic_load_explicit(&cast_stats_blocks,
+						   memory_order_relaxed);
+		while (!atomic_compare_exchange_weak_explicit(
+		    &cast_stats_blocks, &block->next, block,
+		    memory_order_release, memory_order_relaxed))
+			;
+	}
+#if defined(CAST_PARALLEL)
+	if (cast_stats_key_ok)
+		pthread_setspecific(cast_stats_key, block);
+#endif
+	cast_stats_thread = block->counters;
+	return cast_stats_thread;
+}
 
-	char *endptr;
-	unsigned long long val = strtoull(str, &endptr, 0);
+uint64_t cast_stats_get(enum cast_type src, enum cast_type dst,
+			uint64_t *failures)
+{
+	uint64_t calls = 0U;
+	uint64_t fails = 0U;
 
-	/* If there is an error */
-	if (errno != 0) {
-		return -1;
+	if ((size_t)src < CAST_TYPE_COUNT && (size_t)dst < CAST_TYPE_COUNT) {
+		size_t index = (size_t)src * CAST_TYPE_COUNT + (size_t)dst;
+		const struct cast_stats_block *block = atomic_load_explicit(
+		    &cast_stats_blocks, memory_order_acquire);
+		const struct cast_stats_counter *counter =
+		    &cast_stats_fallback.counters[index];
+		calls += atomic_load_explicit(&counter->calls,
+					      memory_order_relaxed);
+		fails += atomic_load_explicit(&counter->failures,
+					      memory_order_relaxed);
+		for (; block; block = block->next) {
+			counter = &block->counters[index];
+			calls += atomic_load_explicit(&counter->calls,
+						      memory_order_relaxed);
+			fails += atomic_load_explicit(&counter->failures,
+						      memory_order_relaxed);
+		}
 	}
+	if (failures)
+		*failures = fails;
+	return calls;
+}
 
-	/* If there are unparsed characters */
-	if (*endptr != '\0') {
-		return -1;
-	}
+int cast_stats_dump(FILE *file)
+{
+	static const char *const families[][2] = {
+	    {"cast_conversions", "Checked conversions done."},
+	    {"cast_conversion_failures", "Checked conversions, which failed."},
+	};
+	int err = 0;
 
-	/* If there were not characters */
-	if (endptr == str || str[0] == '\0') {
-		return -1;
+	for (size_t f = 0U; f < sizeof(families) / sizeof(families[0]); ++f) {
+		if (fprintf(file, "# TYPE %s counter\n# HELP %s %s\n",
+			    families[f][0], families[f][0],
+			    families[f][1]) < 0)
+			err = -1;
+		for (size_t src = 0U; src < CAST_TYPE_COUNT; ++src) {
+			for (size_t dst = 0U; dst < CAST_TYPE_COUNT; ++dst) {
+				uint64_t failures = 0U;
+				uint64_t calls =
+				    cast_stats_get((enum cast_type)src,
+						   (enum cast_type)dst,
+						   &failures);
+				if (calls == 0U)
+					continue;
+				if (fprintf(file,
+					    "%s_total{src=\"%s\",dst=\"%s\"} "
+					    "%" PRIu64 "\n",
+					    families[f][0], cast_type_names[src],
+					    cast_type_names[dst],
+					    f == 0U ? calls : failures) < 0)
+					err = -1;
+			}
+		}
 	}
+	if (fprintf(file, "# EOF\n") < 0)
+		err = -1;
+	return err;
+}
 
-	*dst = val;
+void cast_trace_failure(unsigned pair, uint64_t value)
+{
+	uintptr_t address = CAST_RETURN_ADDRESS();
+	CAST_PROBE4(failure, pair >> 8, pair & 0xFFU, value, address);
 
-	return 0;
+	struct cast_stats_counter *counters = cast_stats_thread;
+	if (!counters)
+		counters = cast_stats_attach();
+	struct cast_stats_block *block = (struct cast_stats_block *)counters;
+	uint64_t index =
+	    atomic_load_explicit(&block->trace_count, memory_order_relaxed);
+	struct cast_trace_entry *entry =
+	    &block->trace[index & (CAST_TRACE_SIZE - 1U)];
+
+	/* Readers skip entry, which changes while they read it */
+	atomic_store_explicit(&entry->seq, 0U, memory_order_relaxed);
+	atomic_thread_fence(memory_order_release);
+	atomic_store_explicit(&entry->pair, pair, memory_order_relaxed);
+	atomic_store_explicit(&entry->value, value, memory_order_relaxed);
+	atomic_store_explicit(&entry->address, address, memory_order_relaxed);
+	atomic_store_explicit(&entry->seq, index + 1U, memory_order_release);
+	atomic_store_explicit(&block->trace_count, index + 1U,
+			      memory_order_release);
 }
 
-int cast_try_llong_from_str(long long *dst, const char *str)
+/* Write failures remembered by one block */
+static int cast_trace_dump_block(FILE *file, size_t thread,
+				 const struct cast_stats_block *block)
 {
-	if (!dst)
-		return -1;
-	if (!str)
-		return -1;
+	uint64_t count =
+	    atomic_load_explicit(&block->trace_count, memory_order_acquire);
+	uint64_t index = count > CAST_TRACE_SIZE ? count - CAST_TRACE_SIZE : 0U;
+	int err = 0;
 
-	errno = 0;
+	for (; index < count; ++index) {
+		const struct cast_trace_entry *entry =
+		    &block->trace[index & (CAST_TRACE_SIZE - 1U)];
+		uint64_t seq =
+		    atomic_load_explicit(&entry->seq, memory_order_acquire);
+		uint64_t pair =
+		    atomic_load_explicit(&entry->pair, memory_order_relaxed);
+		uint64_t value =
+		    atomic_load_explicit(&entry->value, memory_order_relaxed);
+		uint64_t address =
+		    atomic_load_explicit(&entry->address, memory_order_relaxed);
+		atomic_thread_fence(memory_order_acquire);
+		if (seq != index + 1U ||
+		    atomic_load_explicit(&entry->seq, memory_order_relaxed) !=
+			seq)
+			continue;
+		if (fprintf(file,
+			    "thread %zu failure %" PRIu64 ": %s to %s, value "
+			    "0x%" PRIx64 ", at 0x%" PRIx64 "\n",
+			    thread, index,
+			    cast_type_name((enum cast_type)(pair >> 8)),
+			    cast_type_name((enum cast_type)(pair & 0xFFU)),
+			    value, address) < 0)
+			err = -1;
+	}
+	return err;
+}
 
-	char *endptr;
-	long long val = strtoll(str, &endptr, 0);
+int cast_trace_dump(FILE *file)
+{
+	const struct cast_stats_block *block =
+	    atomic_load_explicit(&cast_stats_blocks, memory_order_acquire);
+	size_t thread = 0U;
+	int err = 0;
 
-	/* If there is an error */
-	if (errno != 0) {
-		return -1;
+	for (; block; block = block->next) {
+		if (cast_trace_dump_block(file, thread++, block))
+			err = -1;
 	}
+	/* Threads, which could not allocate their own block */
+	if (cast_trace_dump_block(file, thread, &cast_stats_fallback))
+		err = -1;
+	return err;
+}
 
-	/* If there are unparsed characters */
-	if (*endptr != '\0') {
-		return -1;
-	}
+#define F(type, type_name) [CAST_TYPE_##type_name] = sizeof(type),
+/* Sizes of types indexed by enum cast_type, 0 for strings */
+static const unsigned char cast_type_sizes[CAST_TYPE_COUNT] = {CAST_TYPES};
+#undef F
 
-	/* If there were not characters */
-	if (endptr == str || str[0] == '\0') {
-		return -1;
-	}
+/* Types, which call sites can be narrowed to, by increasing size */
+static const enum cast_type cast_profile_narrow_types[] = {
+    CAST_TYPE_u8,  CAST_TYPE_i8,  CAST_TYPE_u16, CAST_TYPE_i16,
+    CAST_TYPE_u32, CAST_TYPE_i32, CAST_TYPE_u64, CAST_TYPE_i64,
+};
 
-	*dst = val;
+/* Return whether results between min and max keys of destination type dst
+ * fit type */
+static bool cast_profile_fits(enum cast_type dst, enum cast_type type,
+			      uint64_t min, uint64_t max)
+{
+	unsigned bits = cast_type_sizes[type] * 8U;
+	/* Largest value of type */
+	uint64_t type_max = UINT64_MAX >> (64U - bits + (type >= CAST_TYPE_i8));
+	if (dst < CAST_TYPE_i8)
+		return max <= type_max;
 
-	return 0;
+	/* Keys of results of signed destination types are offset by 2^63 */
+	int64_t lo = (int64_t)(min ^ (UINT64_C(1) << 63));
+	int64_t hi = (int64_t)(max ^ (UINT64_C(1) << 63));
+	if (lo < 0 && (type < CAST_TYPE_i8 || lo < -(int64_t)type_max - 1))
+		return false;
+	return hi < 0 || (uint64_t)hi <= type_max;
 }
 
-int cast_try_float_from_str(float *dst, const char *str)
+#if defined(CAST_PROFILE_SITES)
+/* Bounds of cast_profile_sites provided by linker, NULL without sites */
+extern struct cast_profile_site __start_cast_profile_sites[]
+    __attribute__((weak));
+extern struct cast_profile_site __stop_cast_profile_sites[]
+    __attribute__((weak));
+/* ELF header of the executable or shared object, so offsets of sites can be
+ * passed to addr2line */
+extern const char __ehdr_start[] __attribute__((weak));
+#endif
+
+int cast_profile_dump(FILE *file)
 {
-	if (!dst)
-		return -1;
-	if (!str)
-		return -1;
+	int err = 0;
+	bool first = true;
 
-	errno = 0;
+	if (fprintf(file, "{\n  \"sites\": [") < 0)
+		err = -1;
+#if defined(CAST_PROFILE_SITES)
+	uintptr_t base = (uintptr_t)__ehdr_start;
+	struct cast_profile_site *site = __start_cast_profile_sites;
+	for (; site && site < __stop_cast_profile_sites; ++site) {
+		enum cast_type src = (enum cast_type)(site->pair >> 8);
+		enum cast_type dst = (enum cast_type)(site->pair & 0xFFU);
+		uint64_t count =
+		    atomic_load_explicit(&site->count, memory_order_relaxed);
+		uint64_t min =
+		    atomic_load_explicit(&site->min, memory_order_relaxed);
+		uint64_t max =
+		    atomic_load_explicit(&site->max, memory_order_relaxed);
+		if (count == 0U || dst >= CAST_TYPE_float)
+			continue;
 
-	char *endptr = NULL;
-	float val = strtof(str, &endptr);
+		/* Prefer signedness of destination type among equal sizes */
+		enum cast_type narrow = dst;
+		for (size_t i = 0U; i < sizeof(cast_profile_narrow_types) /
+					    sizeof(cast_profile_narrow_types[0]);
+		     ++i) {
+			enum cast_type type = cast_profile_narrow_types[i];
+			if (cast_type_sizes[type] >= cast_type_sizes[dst])
+				break;
+			if (!cast_profile_fits(dst, type, min, max))
+				continue;
+			if (narrow == dst ||
+			    (cast_type_sizes[type] == cast_type_sizes[narrow] &&
+			     (type >= CAST_TYPE_i8) == (dst >= CAST_TYPE_i8)))
+				narrow = type;
+		}
+		if (narrow == dst)
+			continue;
 
-	/* If there is an error */
-	if (errno != 0) {
-		return -1;
+		char range[64];
+		if (dst >= CAST_TYPE_i8)
+			snprintf(range, sizeof(range),
+				 "\"min\": %" PRId64 ", \"max\": %" PRId64,
+				 (int64_t)(min ^ (UINT64_C(1) << 63)),
+				 (int64_t)(max ^ (UINT64_C(1) << 63)));
+		else
+			snprintf(range, sizeof(range),
+				 "\"min\": %" PRIu64 ", \"max\": %" PRIu64, min,
+				 max);
+		if (fprintf(file,
+			    "%s\n    {\"address\": \"0x%" PRIx64
+			    "\", \"offset\": \"0x%" PRIx64 "\", "
+			    "\"src\": \"%s\", \"dst\": \"%s\", "
+			    "\"count\": %" PRIu64 ", %s, \"narrow\": \"%s\"}",
+			    first ? "" : ",", site->address,
+			    site->address - (uint64_t)base,
+			    cast_type_names[src], cast_type_names[dst], count,
+			    range, cast_type_names[narrow]) < 0)
+			err = -1;
+		first = false;
 	}
+#endif
+	if (fprintf(file, "%s]\n}\n", first ? "" : "\n  ") < 0)
+		err = -1;
+	return err;
+}
 
-	/* If there are unparsed characters */
-	if (*endptr != '\0') {
-		return -1;
-	}
+#if defined(CAST_PROFILE_SITES)
+/* Write report of call sites at exit */
+static void cast_profile_exit(void)
+{
+	const char *path = getenv("CAST_PROFILE_OUTPUT");
+	FILE *file = fopen(path ? path : "cast-profile.json", "w");
+	if (!file)
+		return;
+	cast_profile_dump(file);
+	fclose(file);
+}
 
-	/* If there were no characters */
-	if (endptr == str || str[0] == '\0') {
+void cast_profile_report_at_exit(void)
+{
+	static atomic_flag registered = ATOMIC_FLAG_INIT;
+	if (!atomic_flag_test_and_set(&registered))
+		atexit(cast_profile_exit);
+}
+#else
+void cast_profile_report_at_exit(void)
+{
+}
+#endif
+
+_Atomic bool cast_hook_flags[CAST_HOOK_COUNT];
+/* Serializes toggling of hooks */
+static atomic_flag cast_hook_lock = ATOMIC_FLAG_INIT;
+
+#if defined(CAST_JUMP_LABELS)
+#include <sys/mman.h>
+#include <unistd.h>
+
+/* Entry of cast_jump_table section emitted by CAST_DEFINE_HOOK() */
+struct cast_jump_entry {
+	uintptr_t code;
+	uintptr_t target;
+	uintptr_t hook;
+};
+
+/* Bounds of cast_jump_table provided by linker, NULL without hooks */
+extern const struct cast_jump_entry __start_cast_jump_table[]
+    __attribute__((weak));
+extern const struct cast_jump_entry __stop_cast_jump_table[]
+    __attribute__((weak));
+
+/* Make pages with code of entry writable or restore them */
+static int cast_jump_protect(const struct cast_jump_entry *entry, int prot)
+{
+	uintptr_t page = (uintptr_t)sysconf(_SC_PAGESIZE);
+	uintptr_t start = entry->code & ~(page - 1U);
+	uintptr_t end = (entry->code + 5U + page - 1U) & ~(page - 1U);
+	return mprotect((void *)start, end - start, prot);
+}
+
+/* Patch site into a jump to its true branch or back into a NOP */
+static int cast_jump_patch(const struct cast_jump_entry *entry, bool enable)
+{
+	static const unsigned char nop[5] = {0x0f, 0x1f, 0x44, 0x00, 0x00};
+	unsigned char insn[5];
+	intptr_t offset =
+	    (intptr_t)entry->target - (intptr_t)(entry->code + 5U);
+
+	if (offset < INT32_MIN || offset > INT32_MAX)
 		return -1;
+	if (enable) {
+		int32_t rel = (int32_t)offset;
+		insn[0] = 0xe9;
+		memcpy(&insn[1], &rel, sizeof(rel));
+	} else {
+		memcpy(insn, nop, sizeof(insn));
 	}
+	if (cast_jump_protect(entry, PROT_READ | PROT_WRITE | PROT_EXEC))
+		return -1;
+	/* Site does not cross 8 byte boundary, so other threads see old or
+	 * new code */
+	uint64_t *word = (uint64_t *)(entry->code & ~(uintptr_t)7U);
+	uint64_t code = __atomic_load_n(word, __ATOMIC_RELAXED);
+	memcpy((unsigned char *)&code + (entry->code & 7U), insn, sizeof(insn));
+	__atomic_store_n(word, code, __ATOMIC_SEQ_CST);
+	return cast_jump_protect(entry, PROT_READ | PROT_EXEC);
+}
 
-	*dst = val;
+/* Patch all sites of hook, undo patched ones on failure */
+static int cast_hook_patch(enum cast_hook hook, bool enable)
+{
+	const struct cast_jump_entry *entry = __start_cast_jump_table;
 
+	for (; entry && entry < __stop_cast_jump_table; ++entry) {
+		if (entry->hook != (uintptr_t)hook)
+			continue;
+		if (cast_jump_patch(entry, enable) == 0)
+			continue;
+		while (entry-- != __start_cast_jump_table) {
+			if (entry->hook == (uintptr_t)hook)
+				cast_jump_patch(entry, !enable);
+		}
+		return -1;
+	}
+	return 0;
+}
+#else
+static int cast_hook_patch(enum cast_hook hook, bool enable)
+{
+	(void)hook;
+	(void)enable;
 	return 0;
 }
+#endif
 
-int cast_try_double_from_str(double *dst, const char *str)
+/* Toggle hook, caller holds cast_hook_lock */
+static int cast_hook_set(enum cast_hook hook, bool enable)
 {
-	if (!dst)
+	if (atomic_load_explicit(&cast_hook_flags[hook],
+				 memory_order_relaxed) == enable)
+		return 0;
+	if (cast_hook_patch(hook, enable))
 		return -1;
-	if (!str)
+	atomic_store_explicit(&cast_hook_flags[hook], enable,
+			      memory_order_release);
+	return 0;
+}
+
+int cast_hook_enable(enum cast_hook hook, bool enable)
+{
+	if ((size_t)hook >= CAST_HOOK_COUNT)
 		return -1;
+	while (atomic_flag_test_and_set_explicit(&cast_hook_lock,
+						 memory_order_acquire))
+		;
+	int err = cast_hook_set(hook, enable);
+	atomic_flag_clear_explicit(&cast_hook_lock, memory_order_release);
+	return err;
+}
 
-	errno = 0;
+bool cast_hook_enabled(enum cast_hook hook)
+{
+	if ((size_t)hook >= CAST_HOOK_COUNT)
+		return false;
+	return atomic_load_explicit(&cast_hook_flags[hook],
+				    memory_order_acquire);
+}
 
-	char *endptr = NULL;
-	double val = strtod(str, &endptr);
+#if defined(CAST_JUMP_LABELS)
+#include <pthread.h>
+#include <semaphore.h>
+#endif
+#include <signal.h>
 
-	/* If there is an error */
-	if (errno != 0) {
-		return -1;
-	}
+/* sigaction() is hidden by strict ISO C modes without _POSIX_C_SOURCE */
+#if defined(SA_RESTART) &&                                                     \
+    (defined(CAST_JUMP_LABELS) || ATOMIC_BOOL_LOCK_FREE == 2)
+#define CAST_HOOK_SIGNALS
+/* Signals toggling hooks, indexed by enum cast_hook, 0 for none */
+static volatile sig_atomic_t cast_hook_signals[CAST_HOOK_COUNT];
+#endif
 
-	/* If there are unparsed characters */
-	if (*endptr != '\0') {
-		return -1;
+#if defined(CAST_HOOK_SIGNALS) && defined(CAST_JUMP_LABELS)
+/* Number of signals received for each hook and not handled yet */
+static _Atomic unsigned cast_hook_toggles[CAST_HOOK_COUNT];
+/* Posted by signal handler to wake up cast_hook_watcher() */
+static sem_t cast_hook_wakeup;
+static pthread_once_t cast_hook_watcher_once = PTHREAD_ONCE_INIT;
+static bool cast_hook_watcher_ok;
+
+/* Only async-signal-safe operations, patching is left to the watcher */
+static void cast_hook_signal_handler(int signum)
+{
+	bool received = false;
+
+	for (size_t hook = 0U; hook < CAST_HOOK_COUNT; ++hook) {
+		if (cast_hook_signals[hook] != signum)
+			continue;
+		atomic_fetch_add_explicit(&cast_hook_toggles[hook], 1U,
+					  memory_order_relaxed);
+		received = true;
 	}
+	if (received)
+		sem_post(&cast_hook_wakeup);
+}
 
-	/* If there were no characters */
-	if (endptr == str || str[0] == '\0') {
-		return -1;
+/* Toggle hooks, whose signals were received, an odd number of times */
+static void *cast_hook_watcher(void *arg)
+{
+	(void)arg;
+	for (;;) {
+		if (sem_wait(&cast_hook_wakeup))
+			continue;
+		for (size_t hook = 0U; hook < CAST_HOOK_COUNT; ++hook) {
+			unsigned toggles = atomic_exchange_explicit(
+			    &cast_hook_toggles[hook], 0U, memory_order_relaxed);
+			if (toggles % 2U == 0U)
+				continue;
+			cast_hook_enable((enum cast_hook)hook,
+					 !cast_hook_enabled((enum cast_hook)hook));
+		}
 	}
+	return NULL;
+}
 
-	*dst = val;
+static void cast_hook_watcher_start(void)
+{
+	pthread_t thread;
+	pthread_attr_t attr;
+	sigset_t all;
+	sigset_t old;
+
+	if (sem_init(&cast_hook_wakeup, 0, 0U))
+		return;
+	if (pthread_attr_init(&attr))
+		return;
+	pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_DETACHED);
+	/* Watcher inherits mask blocking signals, which are left to threads
+	 * of the program */
+	sigfillset(&all);
+	pthread_sigmask(SIG_SETMASK, &all, &old);
+	cast_hook_watcher_ok =
+	    pthread_create(&thread, &attr, cast_hook_watcher, NULL) == 0;
+	pthread_sigmask(SIG_SETMASK, &old, NULL);
+	pthread_attr_destroy(&attr);
+}
 
+/* Start watcher thread once, return 0 if it runs */
+static int cast_hook_signal_init(void)
+{
+	pthread_once(&cast_hook_watcher_once, cast_hook_watcher_start);
+	return cast_hook_watcher_ok ? 0 : -1;
+}
+#elif defined(CAST_HOOK_SIGNALS)
+/* Hooks are flags, whose stores are lock-free and so async-signal-safe */
+static void cast_hook_signal_handler(int signum)
+{
+	for (size_t hook = 0U; hook < CAST_HOOK_COUNT; ++hook) {
+		if (cast_hook_signals[hook] != signum)
+			continue;
+		bool on = atomic_load_explicit(&cast_hook_flags[hook],
+					       memory_order_relaxed);
+		while (!atomic_compare_exchange_weak_explicit(
+		    &cast_hook_flags[hook], &on, !on, memory_order_release,
+		    memory_order_relaxed))
+			;
+	}
+}
+
+static int cast_hook_signal_init(void)
+{
 	return 0;
 }
+#endif
+
+#if defined(CAST_HOOK_SIGNALS)
+int cast_hook_toggle_on_signal(enum cast_hook hook, int signum)
+{
+	struct sigaction action;
+
+	if ((size_t)hook >= CAST_HOOK_COUNT)
+		return -1;
+	if (cast_hook_signal_init())
+		return -1;
+	memset(&action, 0, sizeof(action));
+	action.sa_handler = cast_hook_signal_handler;
+	action.sa_flags = SA_RESTART;
+	sigemptyset(&action.sa_mask);
+	cast_hook_signals[hook] = signum;
+	return sigaction(signum, &action, NULL) ? -1 : 0;
+}
+#else
+int cast_hook_toggle_on_signal(enum cast_hook hook, int signum)
+{
+	(void)hook;
+	(void)signum;
+	return -1;
+}
+#endif
 
 #ifdef CAST_TESTS
 
-static inline int try_float_from_float(float *dst, float src)
+static inline int cast_raw_float_from_float(float *dst, float src)
 {
 	if (!dst)
 		return -1;
@@ -1136,7 +8927,7 @@ static inline int try_float_from_float(float *dst, float src)
 }
 CAST_DEFINE_FROM(float, float, float, float)
 
-static inline int try_double_from_float(double *dst, float src)
+static inline int cast_raw_double_from_float(double *dst, float src)
 {
 	if (!dst)
 		return -1;
@@ -1145,7 +8936,7 @@ static inline int try_double_from_float(double *dst, float src)
 }
 CAST_DEFINE_FROM(double, double, float, float)
 
-static inline int try_float_from_double(float *dst, double src)
+static inline int cast_raw_float_from_double(float *dst, double src)
 {
 	if (!dst)
 		return -1;
@@ -1154,7 +8945,7 @@ static inline int try_float_from_double(float *dst, double src)
 }
 CAST_DEFINE_FROM(float, float, double, double)
 
-static inline int try_double_from_double(double *dst, double src)
+static inline int cast_raw_double_from_double(double *dst, double src)
 {
 	if (!dst)
 		return -1;
@@ -1375,16 +9166,115 @@ CAST_DEFINE_FROM(double, double, double, double)
 
 #define cast_dump(fmt, x) printf(#x " = "fmt"\n", x)
 
+/* Number of failures seen by cast_test_panic_handler() */
+static unsigned cast_test_panics;
+
+static void cast_test_panic_handler(enum cast_type src, enum cast_type dst)
+{
+	++cast_test_panics;
+	printf("panic handler: %s to %s\n", cast_type_name(src),
+	       cast_type_name(dst));
+}
+
+#if defined(CAST_HOOK_SIGNALS)
+/* Wait at most a second for hook to be toggled by signal, return whether
+ * hook is enabled */
+static bool cast_test_wait_hook(enum cast_hook hook, bool enabled)
+{
+	for (int i = 0; i < 1000 && cast_hook_enabled(hook) != enabled; ++i)
+		nanosleep(&(struct timespec){0, 1000000}, NULL);
+	return cast_hook_enabled(hook);
+}
+#endif
+
 static void cast_tests(void)
 {
-	int64_t i64;
+	int64_t i64 = 0;
 	cast_dump("%d", try_i64_from_str(&i64, "1"));
 	cast_dump("%d", try_i64_from_str(&i64, "0"));
 
-	bool b;
+	bool b = false;
 	cast_dump("%d", try_bool_from_str(&b, "1"));
 	cast_dump("%d", try_bool_from_str(&b, "0"));
 
+	uint64_t u64 = 0U;
+	uint8_t u8 = 0U;
+	int8_t i8 = 0;
+	const char *line = "GET 0404 18446744073709551615 -128";
+	cast_dump("%d", try_i64_from_strn(&i64, line + 4, 4));
+	cast_dump("%" PRId64, i64);
+	cast_dump("%d", try_i64_from_strn(&i64, line + 4, 2));
+	cast_dump("%" PRId64, i64);
+	cast_dump("%d", try_u64_from_strn(&u64, line + 9, 20));
+	cast_dump("%d", u64 == UINT64_MAX);
+	cast_dump("%d", try_u64_from_strn(&u64, "18446744073709551616", 20));
+	cast_dump("%d", try_u64_from_strn(&u64, "000000000000000000000001", 24));
+	cast_dump("%" PRIu64, u64);
+	cast_dump("%d", try_i8_from_strn(&i8, line + 30, 4));
+	cast_dump("%d", i8);
+	cast_dump("%d", try_u8_from_strn(&u8, line + 30, 4));
+	cast_dump("%d", try_u8_from_strn(&u8, "-0", 2));
+	cast_dump("%d", try_u8_from_strn(&u8, "256", 3));
+	cast_dump("%d", try_u8_from_strn(&u8, "+255", 4));
+	cast_dump("%d", try_u8_from_strn(&u8, " 1", 2));
+	cast_dump("%d", try_u8_from_strn(&u8, "0x1", 3));
+	cast_dump("%d", try_u8_from_strn(&u8, "", 0));
+	cast_dump("%d", try_u8_from_strn(&u8, "-", 1));
+	cast_dump("%d", try_i64_from_strn(&i64, "-9223372036854775808", 20));
+	cast_dump("%d", i64 == INT64_MIN);
+	cast_dump("%d", try_i64_from_strn(&i64, "9223372036854775808", 19));
+	cast_dump("%d", try_i64_from_strn(&i64, "12345678a", 9));
+	cast_dump("%d", try_i64_from_strn(&i64, "1234567:12345678", 16));
+	cast_dump("%d", try_bool_from_strn(&b, "0", 1));
+	cast_dump("%d", b);
+
+	uint16_t u16 = 0U;
+	int32_t i32 = 0;
+	cast_dump("%d", try_u16_from_str(&u16, "65535"));
+	cast_dump("%d", try_u16_from_str(&u16, "65536"));
+	cast_dump("%d", try_u16_from_str(&u16, "99999999999999999999999"));
+	cast_dump("%d", try_u16_from_str(&u16, "0x10"));
+	cast_dump("%u", u16);
+	cast_dump("%d", try_i8_from_str(&i8, "-128"));
+	cast_dump("%d", try_i8_from_str(&i8, "-129"));
+	cast_dump("%d", try_i32_from_str(&i32, "-2147483648"));
+	cast_dump("%d", i32 == INT32_MIN);
+	cast_dump("%d", try_i32_from_str(&i32, "2147483648"));
+	cast_dump("%d", try_i32_from_str(&i32, " 010"));
+	cast_dump("%d", i32);
+
+	double d = 0.0;
+	float f32 = 0.0f;
+	const char *numbers = "0.1,-2.5e-3,1e400,9007199254740993";
+	cast_dump("%d", try_double_from_strn(&d, numbers, 3));
+	cast_dump("%a", d);
+	cast_dump("%d", try_double_from_strn(&d, numbers + 4, 7));
+	cast_dump("%a", d);
+	cast_dump("%d", try_double_from_strn(&d, numbers + 12, 5));
+	cast_dump("%d", try_double_from_strn(&d, numbers + 18, 16));
+	cast_dump("%a", d);
+	cast_dump("%d", try_float_from_strn(&f32, numbers, 3));
+	cast_dump("%a", (double)f32);
+	cast_dump("%d", try_double_from_strn(&d, "1e-400", 6));
+	cast_dump("%d", try_double_from_strn(&d, "1.", 2));
+	cast_dump("%d", try_double_from_strn(&d, ".", 1));
+	cast_dump("%d", try_double_from_strn(&d, "1e", 2));
+	cast_dump("%d", try_double_from_strn(&d, " 1", 2));
+	cast_dump("%d", try_double_from_str(&d, " 1"));
+	cast_dump("%d", try_double_from_str(&d, "0x1p-2"));
+	cast_dump("%a", d);
+	cast_dump("%d", try_double_from_str(&d,
+					    "2.47032822920623272088284396434110"
+					    "68618521e-324"));
+	cast_dump("%d", try_double_from_str(
+			    &d, "1.00000000000000011102230246251565404236316680"
+				"908203125"));
+	cast_dump("%a", d);
+	cast_dump("%d", try_double_from_str(
+			    &d, "1.00000000000000011102230246251565404236316680"
+				"908203125000000000000000000000000000000001"));
+	cast_dump("%a", d);
+
 	cast_dump("%d", cast_shift_zeros_right(0U) == 0U);
 	cast_dump("%d", cast_shift_zeros_right(1U) == 1U);
 	cast_dump("%d", cast_shift_zeros_right(2U) == 1U);
@@ -1401,6 +9291,308 @@ static void cast_tests(void)
 
 	cast_dump("%"PRIu64, integer_cast(uint64_t, -1));
 
+	int32_t i32_array[300];
+	uint8_t u8_array[300];
+	size_t first_bad = 0U;
+	for (size_t i = 0; i < 300U; ++i)
+		i32_array[i] = (int32_t)(i % 256U);
+	cast_dump("%d", try_u8_from_i32_array(u8_array, i32_array, 300U,
+					      &first_bad));
+	cast_dump("%d", u8_array[299] == 43U);
+	i32_array[137] = -1;
+	cast_dump("%d", try_u8_from_i32_array(u8_array, i32_array, 300U,
+					      &first_bad));
+	cast_dump("%zu", first_bad);
+	i32_array[137] = 256;
+	cast_dump("%d", try_i8_from_i32_array((int8_t *)u8_array, i32_array,
+					      300U, &first_bad));
+	cast_dump("%zu", first_bad);
+	cast_dump("%d", try_i64_from_i32_array(NULL, i32_array, 0U, NULL));
+
+	float float_array[100];
+	int16_t i16_array[100];
+	for (size_t i = 0; i < 100U; ++i)
+		float_array[i] = (float)i - 50.0f;
+	cast_dump("%d", try_i32_from_float_array(i32_array, float_array, 100U,
+						 &first_bad));
+	cast_dump("%d", i32_array[99] == 49);
+	cast_dump("%d", try_u8_from_float_array(u8_array, float_array, 100U,
+						&first_bad));
+	cast_dump("%zu", first_bad);
+	float_array[75] = 25.5f;
+	cast_dump("%d", try_i16_from_float_array(i16_array, float_array, 100U,
+						 &first_bad));
+	cast_dump("%zu", first_bad);
+
+	int64_t i64_array[100];
+	double double_array[100];
+	for (size_t i = 0; i < 100U; ++i)
+		i64_array[i] = ((int64_t)1 << 53) - (int64_t)i;
+	cast_dump("%d", try_double_from_i64_array(double_array, i64_array, 100U,
+						  &first_bad));
+	cast_dump("%d", double_array[99] == 0x1p53 - 99.0);
+	i64_array[43] += (int64_t)1 << 53;
+	cast_dump("%d", try_double_from_i64_array(double_array, i64_array, 100U,
+						  &first_bad));
+	cast_dump("%zu", first_bad);
+	cast_dump("%d", try_float_from_i32_array(float_array, i32_array, 100U,
+						 &first_bad));
+	cast_dump("%d", try_double_from_u64(&double_array[0], (1ULL << 54) - 1U));
+
+	for (int isa = CAST_ISA_SCALAR; isa <= CAST_ISA_AVX512; ++isa) {
+		cast_set_isa((enum cast_isa)isa);
+		for (size_t i = 0; i < 300U; ++i)
+			i32_array[i] = (int32_t)(i % 256U);
+		i32_array[259] = 256;
+		first_bad = 0U;
+		cast_dump("%d", try_u8_from_i32_array(u8_array, i32_array, 300U,
+						      &first_bad) != 0 &&
+				    first_bad == 259U && u8_array[258] == 2U);
+		cast_dump("%d", try_double_from_i64_array(double_array,
+							  i64_array, 100U,
+							  &first_bad) != 0 &&
+				    first_bad == 43U);
+	}
+	cast_set_isa(CAST_ISA_AVX512);
+
+	cast_dump("%d", cast_all_fit_u8_from_i32(i32_array, 259U));
+	cast_dump("%d", cast_all_fit_u8_from_i32(i32_array, 300U));
+	cast_dump("%d", cast_all_fit_u8_from_i32_full(i32_array, 300U));
+	cast_dump("%d", cast_all_fit_i8_from_i32_full(i32_array, 128U));
+	cast_dump("%d", cast_all_fit_i8_from_i32(i32_array, 129U));
+	cast_dump("%d", cast_all_fit_u32_from_i64(i64_array, 0U));
+	int32_t i32_min = 0;
+	int32_t i32_max = 0;
+	cast_dump("%d", cast_minmax_i32(i32_array, 300U, &i32_min, &i32_max));
+	cast_dump("%d", i32_min);
+	cast_dump("%d", i32_max);
+	cast_dump("%d", cast_minmax_i32(i32_array, 0U, &i32_min, &i32_max));
+
+	size_t big_n = (size_t)1 << 20;
+	int32_t *big_src = malloc(big_n * sizeof(*big_src));
+	uint8_t *big_dst = malloc(big_n * sizeof(*big_dst));
+	if (big_src && big_dst) {
+		for (size_t i = 0; i < big_n; ++i)
+			big_src[i] = (int32_t)(i % 256U);
+		cast_dump("%u", cast_set_threads(4U));
+		cast_dump("%d", try_u8_from_i32_array_mt(big_dst, big_src,
+							 big_n, &first_bad));
+		cast_dump("%d", big_dst[big_n - 1U] == 255U);
+		big_src[900000] = -1;
+		big_src[300001] = 256;
+		cast_dump("%d", try_u8_from_i32_array_mt(big_dst, big_src,
+							 big_n, &first_bad));
+		cast_dump("%zu", first_bad);
+		cast_dump("%d", big_dst[300000] == 224U);
+		cast_set_threads(0U);
+	}
+	free(big_src);
+	free(big_dst);
+
+	const char *column = "1,22\n-3\r\n4\n";
+	int32_t i32_column[4] = {0};
+	size_t column_count = 0U;
+	size_t column_err = 0U;
+	cast_dump("%d", cast_parse_column_i32(column, strlen(column), ',',
+					      i32_column, 4U, &column_count,
+					      &column_err));
+	cast_dump("%zu", column_count);
+	cast_dump("%d", i32_column[1]);
+	cast_dump("%d", i32_column[2]);
+	cast_dump("%d", cast_parse_column_i32(column, strlen(column), ',',
+					      i32_column, 3U, &column_count,
+					      &column_err));
+	cast_dump("%zu", column_count);
+	cast_dump("%zu", column_err);
+	uint8_t u8_column[4] = {0};
+	cast_dump("%d", cast_parse_column_u8("7;300;8", 7U, ';', u8_column, 4U,
+					     &column_count, &column_err));
+	cast_dump("%zu", column_count);
+	cast_dump("%zu", column_err);
+	cast_dump("%d", cast_parse_column_u8("7;;8", 4U, ';', u8_column, 4U,
+					     &column_count, &column_err));
+	cast_dump("%zu", column_err);
+	double double_column[2] = {0.0};
+	cast_dump("%d", cast_parse_column_double("0.5\t-1e3", 8U, '\t',
+						 double_column, 2U,
+						 &column_count, NULL));
+	cast_dump("%f", double_column[1]);
+
+	struct cast_u8_result u8_result = try_u8_from_i32_result(255);
+	cast_dump("%d", u8_result.ok);
+	cast_dump("%u", u8_result.value);
+	u8_result = try_u8_from_i32_result(256);
+	cast_dump("%d", u8_result.ok);
+	cast_dump("%u", u8_result.value);
+	struct cast_i64_result i64_result = try_i64_from_double_result(-2.0);
+	cast_dump("%d", i64_result.ok);
+	cast_dump("%" PRId64, i64_result.value);
+	cast_dump("%d", try_i64_from_double_result(0.5).ok);
+	cast_dump("%d", try_u16_from_strn_result("8080", 4U).value);
+	cast_dump("%d", try_u16_from_strn_result("80800", 5U).ok);
+	cast_dump("%d", try_bool_from_str_result("1").value);
+	cast_dump("%f", try_double_from_str_result("0.25").value);
+
+	struct cast_ctx ctx = CAST_CTX_INIT;
+	cast_dump("%d", u8_from_i32_ctx(&ctx, NULL, 0, 7));
+	cast_dump("%d", cast_ctx_check(&ctx));
+	cast_dump("%d", u8_from_i32_ctx(&ctx, NULL, 0, -1));
+	cast_dump("%d", i8_from_u64_ctx(&ctx, NULL, 0, 300U));
+	cast_dump("%d", i16_from_double_ctx(&ctx, NULL, 0, -3.0));
+	cast_dump("%u", u16_from_strn_ctx(&ctx, NULL, 0, "65536", 5U));
+	cast_dump("%d", cast_ctx_check(&ctx));
+	cast_dump("%zu", ctx.count);
+	cast_dump("%zu", ctx.first_index);
+	cast_dump("%s", ctx.first_name);
+	cast_dump("%d", ctx.first_file == NULL);
+
+	struct cast_ctx site_ctx = CAST_CTX_INIT;
+	cast_dump("%d", CAST_CTX(&site_ctx, i32_from_i64, INT64_MAX));
+	int site_line = __LINE__ - 1;
+	cast_dump("%d", CAST_CTX(&site_ctx, u8_from_strn, "-1", 2U));
+	cast_dump("%s", site_ctx.first_name);
+	cast_dump("%d", strcmp(site_ctx.first_file, __FILE__));
+	cast_dump("%d", site_ctx.first_line == site_line);
+
+	char fmt_buf[CAST_FMT_INT_SIZE + 1U];
+	cast_dump("%zu", cast_fmt_u64_str(fmt_buf, sizeof(fmt_buf), UINT64_MAX));
+	cast_dump("%s", fmt_buf);
+	cast_dump("%zu", cast_fmt_i64_str(fmt_buf, sizeof(fmt_buf), INT64_MIN));
+	cast_dump("%s", fmt_buf);
+	cast_dump("%zu", cast_fmt_i8_str(fmt_buf, sizeof(fmt_buf), -7));
+	cast_dump("%s", fmt_buf);
+	cast_dump("%zu", cast_fmt_u8_str(fmt_buf, sizeof(fmt_buf), 0U));
+	cast_dump("%s", fmt_buf);
+	cast_dump("%zu", cast_fmt_u32(fmt_buf, 4U, 1234U));
+	cast_dump("%zu", cast_fmt_u32(fmt_buf, 3U, 1234U));
+	cast_dump("%zu", cast_fmt_u32_str(fmt_buf, 4U, 1234U));
+	const int16_t fmt_src[] = {-1, 0, 300, INT16_MIN};
+	size_t fmt_count = 0U;
+	size_t fmt_len = cast_fmt_i16_array(fmt_buf, sizeof(fmt_buf), fmt_src,
+					    4U, ',', &fmt_count);
+	fmt_buf[fmt_len] = '\0';
+	cast_dump("%zu", fmt_count);
+	cast_dump("%s", fmt_buf);
+	fmt_len = cast_fmt_i16_array(fmt_buf, 8U, fmt_src, 4U, ',', &fmt_count);
+	fmt_buf[fmt_len] = '\0';
+	cast_dump("%zu", fmt_count);
+	cast_dump("%s", fmt_buf);
+	char float_buf[CAST_FMT_FLOAT_SIZE + 1U];
+	cast_dump("%zu", cast_fmt_double_str(float_buf, sizeof(float_buf), 0.1));
+	cast_dump("%s", float_buf);
+	cast_dump("%zu", cast_fmt_double_str(float_buf, sizeof(float_buf),
+					     -2.2250738585072014e-308));
+	cast_dump("%s", float_buf);
+	cast_dump("%zu", cast_fmt_double_str(float_buf, sizeof(float_buf), 1e16));
+	cast_dump("%s", float_buf);
+	cast_dump("%zu", cast_fmt_double_str(float_buf, sizeof(float_buf),
+					     123.456));
+	cast_dump("%s", float_buf);
+	cast_dump("%zu", cast_fmt_double_str(float_buf, sizeof(float_buf),
+					     0.00012));
+	cast_dump("%s", float_buf);
+	cast_dump("%zu", cast_fmt_double_str(float_buf, sizeof(float_buf),
+					     -0.0));
+	cast_dump("%s", float_buf);
+	cast_dump("%zu", cast_fmt_float_str(float_buf, sizeof(float_buf), 0.3f));
+	cast_dump("%s", float_buf);
+	cast_dump("%zu", cast_fmt_float_str(float_buf, sizeof(float_buf),
+					    16777216.0f));
+	cast_dump("%s", float_buf);
+	cast_dump("%zu", cast_fmt_float(float_buf, 2U, 0.5f));
+	const double double_src[] = {1.5, -1e-7, 1e300};
+	fmt_len = cast_fmt_double_array(float_buf, sizeof(float_buf),
+					double_src, 3U, ' ', &fmt_count);
+	float_buf[fmt_len] = '\0';
+	cast_dump("%zu", fmt_count);
+	cast_dump("%s", float_buf);
+
+	enum cast_type log_src = CAST_TYPE_u8, log_dst = CAST_TYPE_u8;
+	cast_panic_log(CAST_TYPE_PAIR(CAST_TYPE_i32, CAST_TYPE_u16), 70000U);
+	cast_dump("%zu", cast_panic_log_count());
+	cast_dump("%d", cast_panic_log_get(0U, &log_src, &log_dst));
+	cast_dump("%s", cast_type_name(log_src));
+	cast_dump("%s", cast_type_name(log_dst));
+	cast_dump("%d", cast_panic_log_get(1U, NULL, NULL));
+	cast_dump("%d", cast_panic_log_get(CAST_PANIC_LOG_SIZE, NULL, NULL));
+	struct cast_recovery scope;
+	volatile int recovered = 0;
+	cast_recovery_push(&scope);
+	if (setjmp(scope.env) == 0)
+		cast_panic_longjmp(
+		    CAST_TYPE_PAIR(CAST_TYPE_strn, CAST_TYPE_bool), 0U);
+	else
+		recovered = 1;
+	cast_recovery_pop(&scope);
+	cast_dump("%d", recovered);
+	cast_dump("%s", cast_type_name(scope.src));
+	cast_dump("%s", cast_type_name(scope.dst));
+
+	cast_dump("%d", cast_push_panic_handler(cast_test_panic_handler));
+	cast_dump("%d", i8_from_i32(1000));
+	cast_dump("%d", cast_pop_panic_handler());
+	cast_dump("%d", cast_pop_panic_handler());
+	cast_dump("%d", cast_set_panic_handler(cast_test_panic_handler) == NULL);
+	cast_dump("%u", u8_from_strn("-1", 2U));
+	cast_dump("%d", cast_push_panic_handler(NULL));
+	cast_dump("%u", u16_from_double(1e9));
+	cast_dump("%d", cast_pop_panic_handler());
+	cast_dump("%d", cast_set_panic_handler(NULL) == cast_test_panic_handler);
+	cast_dump("%u", cast_test_panics);
+
+	uint64_t stats_failures = 0U;
+	cast_stats_record(CAST_TYPE_i64, CAST_TYPE_u8, false);
+	cast_stats_record(CAST_TYPE_i64, CAST_TYPE_u8, true);
+	cast_stats_record(CAST_TYPE_strn, CAST_TYPE_bool, false);
+	cast_dump("%llu", (unsigned long long)cast_stats_get(
+			      CAST_TYPE_i64, CAST_TYPE_u8, &stats_failures));
+	cast_dump("%llu", (unsigned long long)stats_failures);
+	cast_dump("%d", cast_stats_dump(stdout));
+
+	cast_dump("%d", cast_hook_stats_on());
+	cast_dump("%d", cast_hook_enable(CAST_HOOK_STATS, true));
+	cast_dump("%d", cast_hook_stats_on());
+	cast_dump("%d", cast_hook_enabled(CAST_HOOK_STATS));
+	cast_dump("%d", cast_hook_enable(CAST_HOOK_STATS, false));
+	cast_dump("%d", cast_hook_stats_on());
+	cast_dump("%d", cast_hook_enable(CAST_HOOK_COUNT, true));
+	cast_trace_failure(CAST_TYPE_PAIR(CAST_TYPE_i64, CAST_TYPE_u8), 300U);
+	cast_dump("%d", cast_trace_dump(stdout));
+#if defined(CAST_PROFILE_SITES)
+	struct cast_profile_site *profile_sites[5];
+	CAST_PROFILE_SITE(profile_sites[0],
+			  CAST_TYPE_PAIR(CAST_TYPE_i64, CAST_TYPE_i32));
+	CAST_PROFILE_SITE(profile_sites[1],
+			  CAST_TYPE_PAIR(CAST_TYPE_double, CAST_TYPE_u64));
+	CAST_PROFILE_SITE(profile_sites[2],
+			  CAST_TYPE_PAIR(CAST_TYPE_strn, CAST_TYPE_u16));
+	CAST_PROFILE_SITE(profile_sites[3],
+			  CAST_TYPE_PAIR(CAST_TYPE_u64, CAST_TYPE_u64));
+	CAST_PROFILE_SITE(profile_sites[4],
+			  CAST_TYPE_PAIR(CAST_TYPE_i64, CAST_TYPE_i64));
+	cast_profile_record(profile_sites[0], CAST_PROFILE_KEY(CAST_TYPE_i32, -3));
+	cast_profile_record(profile_sites[0], CAST_PROFILE_KEY(CAST_TYPE_i32, 900));
+	cast_profile_record(profile_sites[1], CAST_PROFILE_KEY(CAST_TYPE_u64, 200));
+	cast_profile_record(profile_sites[2],
+			    CAST_PROFILE_KEY(CAST_TYPE_u16, 65535));
+	/* Neither fits a narrower type */
+	cast_profile_record(profile_sites[3],
+			    CAST_PROFILE_KEY(CAST_TYPE_u64, UINT64_C(1) << 63));
+	cast_profile_record(profile_sites[4],
+			    CAST_PROFILE_KEY(CAST_TYPE_i64, INT64_MIN));
+	cast_profile_record(profile_sites[4], CAST_PROFILE_KEY(CAST_TYPE_i64, 5));
+	cast_dump("%d", cast_profile_dump(stdout));
+#endif
+#if defined(CAST_HOOK_SIGNALS)
+	cast_dump("%d", cast_hook_toggle_on_signal(CAST_HOOK_STATS, SIGUSR1));
+	cast_dump("%d", raise(SIGUSR1));
+	cast_dump("%d", cast_test_wait_hook(CAST_HOOK_STATS, true));
+	cast_dump("%d", cast_hook_stats_on());
+	cast_dump("%d", raise(SIGUSR1));
+	cast_dump("%d", cast_test_wait_hook(CAST_HOOK_STATS, false));
+	cast_dump("%d", cast_hook_stats_on());
+#endif
+
 #define F(number) number,
 
 #define TEST(dst, src)                                                         \
@@ -0,0 +1,165 @@
+#!/usr/bin/env bash
+#
+# Report what including cast.h costs each translation unit: time to
+# preprocess and to compile a file, which only includes cast.h, size of its
+# preprocessed output and number of inline functions it defines, and bytes
+# of code emitted for each conversion used. Times are the best of several
+# runs and a file, which includes nothing, is measured for comparison.
+#
+# Usage: scripts/build-cost-report.sh [history file] [compiler flags]
+#
+# Flags default to -O2. Set CC to use a different compiler. When a history
+# file is given, results are appended to it as a CSV row together with date
+# and revision, and compared with the last row measured with the same
+# compiler and flags, so cost of changes to cast.h can be followed over time.
+
+set -e
+
+CC="${CC:-cc}"
+REPEATS=5
+
+# shellcheck source=scripts/conversions.sh
+source "$(dirname "$0")/conversions.sh"
+
+# Print best wall time of running command in microseconds
+best_time () {
+    local best=0 start end elapsed
+    for ((r = 0; r < REPEATS; ++r)); do
+        start=$(date +%s%N)
+        "$@" > /dev/null
+        end=$(date +%s%N)
+        elapsed=$(( (end - start) / 1000 ))
+        if [[ $r -eq 0 || $elapsed -lt $best ]]; then
+            best=$elapsed
+        fi
+    done
+    echo "$best"
+}
+
+# Print microseconds as milliseconds
+ms () {
+    printf "%d.%d" $(( $1 / 1000 )) $(( $1 % 1000 / 100 ))
+}
+
+# Print bytes of code of one function using a panicking conversion and of
+# one using try_ variant of it
+measure_conversion () {
+    local dir="$1"
+    local conversion="$2"
+    shift 2
+    local dst src type
+    read -r dst src type <<< "$conversion"
+
+    {
+        echo '#include "cast.h"'
+        echo "int use($type x) { return (int)${dst}_from_${src}(x); }"
+    } > "$dir/panic.c"
+    {
+        echo '#include "cast.h"'
+        echo "int use($type x)"
+        echo "{"
+        echo "    __typeof__(${dst}_from_${src}(x)) val = 0;"
+        echo "    return try_${dst}_from_${src}(&val, x) ? -1 : (int)val;"
+        echo "}"
+    } > "$dir/try.c"
+    "$CC" "$@" -c -I"$dir" "$dir/panic.c" -o "$dir/panic.o"
+    "$CC" "$@" -c -I"$dir" "$dir/try.c" -o "$dir/try.o"
+    local panic try
+    read -r _ _ panic <<< "$(code_size "$dir/panic.o" use)"
+    read -r _ _ try <<< "$(code_size "$dir/try.o" use)"
+    echo "$panic $try"
+}
+
+main () {
+    local history="$1"
+    shift || true
+    local flags=("$@")
+    if [[ ${#flags[@]} -eq 0 ]]; then
+        flags=(-O2)
+    fi
+
+    local root
+    root="$(cd "$(dirname "$0")/.." && pwd)"
+    local tmp
+    tmp="$(mktemp -d)"
+    trap 'rm -rf "$tmp"' EXIT
+    cp "$root/cast.h" "$tmp/cast.h"
+    echo 'int main(void) { return 0; }' > "$tmp/empty.c"
+    printf '#include "cast.h"\nint main(void) { return 0; }\n' \
+        > "$tmp/include.c"
+
+    local empty_pp empty_cc include_pp include_cc
+    empty_pp=$(best_time "$CC" "${flags[@]}" -E "$tmp/empty.c")
+    empty_cc=$(best_time "$CC" "${flags[@]}" -c "$tmp/empty.c" \
+        -o "$tmp/empty.o")
+    include_pp=$(best_time "$CC" "${flags[@]}" -E -I"$tmp" "$tmp/include.c")
+    include_cc=$(best_time "$CC" "${flags[@]}" -c -I"$tmp" "$tmp/include.c" \
+        -o "$tmp/include.o")
+
+    "$CC" "${flags[@]}" -E -P -I"$tmp" "$tmp/include.c" > "$tmp/include.i"
+    local lines functions
+    lines=$(wc -l < "$tmp/include.i")
+    functions=$(grep -o 'static inline' "$tmp/include.i" | wc -l)
+
+    echo "Cost of including cast.h, $CC ${flags[*]}"
+    printf "%-24s %10s %10s\n" "" "empty TU" "cast.h TU"
+    printf "%-24s %10s %10s\n" "preprocess ms" "$(ms "$empty_pp")" \
+        "$(ms "$include_pp")"
+    printf "%-24s %10s %10s\n" "compile ms" "$(ms "$empty_cc")" \
+        "$(ms "$include_cc")"
+    printf "%-24s %10s %10d\n" "preprocessed lines" "" "$lines"
+    printf "%-24s %10s %10d\n" "inline functions" "" "$functions"
+    echo
+    echo "Bytes of code of a function using one conversion"
+    printf "%-16s %8s %8s\n" "conversion" "panic" "try"
+
+    # Commas are dropped from text columns to keep CSV simple
+    local revision compiler flag_text
+    revision=$(git -C "$root" describe --always --dirty 2> /dev/null ||
+        echo unknown)
+    compiler=$("$CC" --version | head -n 1 | tr ',' ' ')
+    flag_text=$(echo "${flags[*]}" | tr ',' ' ')
+
+    local header="date,revision,compiler,flags,preprocess_us,compile_us"
+    header="$header,lines,functions"
+    local row conversion dst src panic try
+    row="$(date -u +%Y-%m-%dT%H:%M:%SZ),$revision,$compiler,$flag_text"
+    row="$row,$include_pp,$include_cc,$lines,$functions"
+    for conversion in "${CONVERSIONS[@]}"; do
+        read -r dst src _ <<< "$conversion"
+        read -r panic try \
+            <<< "$(measure_conversion "$tmp" "$conversion" "${flags[@]}")"
+        printf "%-16s %8d %8d\n" "${dst}_from_${src}" "$panic" "$try"
+        header="$header,${dst}_from_${src},try_${dst}_from_${src}"
+        row="$row,$panic,$try"
+    done
+
+    if [[ -z "$history" ]]; then
+        return
+    fi
+    if [[ ! -s "$history" ]]; then
+        echo "$header" > "$history"
+    elif [[ "$(head -n 1 "$history")" != "$header" ]]; then
+        echo "columns of $history differ, not appending" >&2
+        return 1
+    fi
+
+    # Compare with last row measured with the same compiler and flags
+    local previous
+    previous=$(awk -F, -v compiler="$compiler" -v flags="$flag_text" \
+        'NR > 1 && $3 == compiler && $4 == flags { last = $0 }
+         END { print last }' "$history")
+    echo "$row" >> "$history"
+    if [[ -z "$previous" ]]; then
+        return
+    fi
+    echo
+    echo "Change since $(echo "$previous" | cut -d, -f2) measured at" \
+        "$(echo "$previous" | cut -d, -f1)"
+    paste -d, <(echo "$header" | tr ',' '\n') \
+        <(echo "$previous" | tr ',' '\n') <(echo "$row" | tr ',' '\n') |
+        tail -n +5 |
+        awk -F, '{ printf "%-24s %10d %10d %+10d\n", $1, $2, $3, $3 - $2 }'
+}
+
+main "$@"
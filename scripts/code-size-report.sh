@@ -0,0 +1,80 @@
+#!/usr/bin/env bash
+#
+# Report how many bytes of code each call site of panicking conversions
+# takes with cast.h from the working tree and with cast.h from a revision.
+# "hot" is code of call sites, "cold" is code which compiler moved out of
+# them and "all" also includes conversions, which were not inlined.
+#
+# Usage: scripts/code-size-report.sh [revision] [compiler flags]
+#
+# The revision defaults to HEAD and flags default to -O2. Set CC to use
+# a different compiler.
+
+set -e
+
+CC="${CC:-cc}"
+SITES=64
+
+# shellcheck source=scripts/conversions.sh
+source "$(dirname "$0")/conversions.sh"
+
+generate_sites () {
+    local conversion="$1"
+    local dst src type
+    read -r dst src type <<< "$conversion"
+
+    echo '#include "cast.h"'
+    for ((i = 0; i < SITES; ++i)); do
+        echo "int site_${i}($type x) { return (int)${dst}_from_${src}(x) + $i; }"
+    done
+}
+
+# Print sizes of hot and cold parts of site functions and size of all code,
+# including conversions which were not inlined
+measure () {
+    local dir="$1"
+    local conversion="$2"
+    shift 2
+
+    generate_sites "$conversion" > "$dir/sites.c"
+    "$CC" "$@" -c -I"$dir" "$dir/sites.c" -o "$dir/sites.o"
+    code_size "$dir/sites.o" site_
+}
+
+main () {
+    local revision="${1:-HEAD}"
+    shift || true
+    local flags=("$@")
+    if [[ ${#flags[@]} -eq 0 ]]; then
+        flags=(-O2)
+    fi
+
+    local root
+    root="$(cd "$(dirname "$0")/.." && pwd)"
+    local tmp
+    tmp="$(mktemp -d)"
+    trap 'rm -rf "$tmp"' EXIT
+    mkdir -p "$tmp/old" "$tmp/new"
+    git -C "$root" show "$revision:cast.h" > "$tmp/old/cast.h"
+    cp "$root/cast.h" "$tmp/new/cast.h"
+
+    echo "Bytes of code per call site, $revision vs working tree, $CC ${flags[*]}"
+    printf "%-16s %8s %8s %8s %8s %8s %8s\n" "conversion" "old hot" \
+        "new hot" "new cold" "old all" "new all" "saved"
+
+    local conversion dst src
+    local old_hot old_cold old_total new_hot new_cold new_total
+    for conversion in "${CONVERSIONS[@]}"; do
+        read -r dst src _ <<< "$conversion"
+        read -r old_hot old_cold old_total \
+            <<< "$(measure "$tmp/old" "$conversion" "${flags[@]}")"
+        read -r new_hot new_cold new_total \
+            <<< "$(measure "$tmp/new" "$conversion" "${flags[@]}")"
+        printf "%-16s %8d %8d %8d %8d %8d %8d\n" "${dst}_from_${src}" \
+            $(( old_hot / SITES )) $(( new_hot / SITES )) \
+            $(( new_cold / SITES )) $(( old_total / SITES )) \
+            $(( new_total / SITES )) $(( (old_total - new_total) / SITES ))
+    done
+}
+
+main "$@"
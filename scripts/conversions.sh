@@ -0,0 +1,33 @@
+# Conversions and code size measurement shared by code-size-report.sh and
+# build-cost-report.sh, which source this file.
+
+# Conversions as destination name, source name and source type
+CONVERSIONS=(
+    "u8 i32 int32_t"
+    "i32 i64 int64_t"
+    "u16 u64 uint64_t"
+    "size int int"
+    "i16 double double"
+    "u32 float float"
+    "int str const char *"
+)
+
+# Print bytes of code in object file as hot, cold and total. Hot counts
+# functions, whose names start with prefix, cold counts parts, which compiler
+# moved out of them, and total counts all functions.
+code_size () {
+    local object="$1"
+    local prefix="$2"
+    local hot=0 cold=0 total=0 size kind name
+    while read -r _ size kind name; do
+        case "$kind" in
+            [Tt]) total=$(( total + 16#$size )) ;;
+            *) continue ;;
+        esac
+        case "$name" in
+            "$prefix"*.cold*) cold=$(( cold + 16#$size )) ;;
+            "$prefix"*) hot=$(( hot + 16#$size )) ;;
+        esac
+    done < <(nm -S --defined-only "$object")
+    echo "$hot $cold $total"
+}